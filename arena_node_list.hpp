@@ -0,0 +1,683 @@
+// MIT License
+
+// Copyright(c) 2021 Golden Rockefeller
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef GOLDENROCKEFELLER_ARENA_NODE_LIST_HPP
+#define GOLDENROCKEFELLER_ARENA_NODE_LIST_HPP
+
+#include <stdexcept>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <cstdint>
+
+namespace goldenrockefeller {
+
+// A variant of NodeList whose links are 32-bit indices into a node arena
+// instead of pointers. Because links are indices, the arena can grow and
+// relocate its storage without invalidating any list.
+//
+// Several lists can share one arena. Like StaticNodeList, the lists own their
+// values: emplace constructs a value in an arena slot and erase destroys it,
+// and iterators are indices, so a value needs no handle outside the arena.
+// splice moves a value between lists of the same arena in O(1). Lists must
+// not outlive their arena.
+//
+// Each element costs one arena slot: 8 bytes of links plus the payload,
+// rounded up to the payload's alignment, so 16 bytes for an 8-byte payload
+// against 24 bytes for a NodeList node. Each list also takes two slots for
+// its sentinels.
+//
+// Growing the arena relocates its slots, which invalidates references to the
+// payloads, such as those returned by dereferencing iterators, but not the
+// lists or iterators themselves. Like std::vector::emplace_back, emplacing
+// still accepts arguments that refer to values of the same arena, such as
+// list.emplace_back(list.front()).
+template <typename T>
+class ArenaNodeList {
+
+public:
+	using value_type = T;
+	using allocator_type = std::allocator<value_type>;
+	using reference = value_type&;
+	using const_reference = const value_type&;
+	using pointer = typename std::allocator_traits<allocator_type>::pointer;
+	using const_pointer = typename std::allocator_traits<allocator_type>::const_pointer;
+	using size_type = std::size_t;
+	using difference_type = std::ptrdiff_t;
+	using index_type = std::uint32_t;
+
+	// Index of a missing link, the equivalent of a null Node pointer.
+	static constexpr index_type npos = static_cast<index_type>(-1);
+
+	class Arena {
+		struct Node {
+			index_type next_node;
+			index_type prev_node;
+
+			// Only constructed in the slots of values, so that sentinels and
+			// free slots hold none.
+			union {
+				value_type data;
+			};
+
+			Node() noexcept : next_node{ npos }, prev_node{ npos } {};
+			~Node() {};
+
+			// Values are always linked into a list; a sentinel misses one
+			// link and a free slot its previous link.
+			bool has_data() const noexcept {
+				return this->next_node != npos && this->prev_node != npos;
+			}
+		};
+
+		// The slots. Growth moves the constructed payloads one by one.
+		class NodeStorage {
+			std::unique_ptr<Node[]> slots;
+			size_type slot_count;
+			size_type slot_capacity;
+
+		public:
+			NodeStorage() noexcept : slots{}, slot_count{ 0 }, slot_capacity{ 0 } {};
+
+			~NodeStorage() {
+				for (size_type node{ 0 }; node < this->slot_count; node++) {
+					if (this->slots[node].has_data()) {
+						this->slots[node].data.~value_type();
+					}
+				}
+			};
+
+			NodeStorage(const NodeStorage& obj) = delete;
+			NodeStorage& operator=(const NodeStorage& obj) = delete;
+
+			Node* data() noexcept {
+				return this->slots.get();
+			}
+
+			const Node* data() const noexcept {
+				return this->slots.get();
+			}
+
+			Node& operator[](size_type node) noexcept {
+				return this->slots[node];
+			}
+
+			const Node& operator[](size_type node) const noexcept {
+				return this->slots[node];
+			}
+
+			size_type size() const noexcept {
+				return this->slot_count;
+			}
+
+			size_type capacity() const noexcept {
+				return this->slot_capacity;
+			}
+
+			void reserve(size_type capacity) {
+				if (capacity <= this->slot_capacity) {
+					return;
+				}
+
+				std::unique_ptr<Node[]> new_slots(new Node[capacity]);
+				this->move_into(new_slots, capacity);
+			}
+
+			// Appends a slot, constructs a value in it and returns its index;
+			// the slot is left without links. When the storage grows, the value
+			// is constructed in the new slots before the old payloads are moved,
+			// so the arguments may refer to values of this arena.
+			template <typename... Args>
+			index_type emplace_slot(Args&&... args) {
+				if (this->slot_count >= static_cast<size_type>(npos)) {
+					throw std::length_error("The arena cannot index any more nodes.");
+				}
+
+				size_type node = this->slot_count;
+
+				if (this->slot_count < this->slot_capacity) {
+					::new (static_cast<void*>(&(this->slots[node].data))) value_type(std::forward<Args>(args)...);
+				}
+				else {
+					size_type capacity = this->slot_capacity ? 2 * this->slot_capacity : 16;
+					std::unique_ptr<Node[]> new_slots(new Node[capacity]);
+					::new (static_cast<void*>(&(new_slots[node].data))) value_type(std::forward<Args>(args)...);
+
+					try {
+						this->move_into(new_slots, capacity);
+					}
+					catch (...) {
+						new_slots[node].data.~value_type();
+						throw;
+					}
+				}
+
+				this->slot_count++;
+				return static_cast<index_type>(node);
+			}
+
+			// Appends a slot without a payload and returns its index.
+			index_type push_slot() {
+				if (this->slot_count >= static_cast<size_type>(npos)) {
+					throw std::length_error("The arena cannot index any more nodes.");
+				}
+				if (this->slot_count == this->slot_capacity) {
+					this->reserve(this->slot_capacity ? 2 * this->slot_capacity : 16);
+				}
+
+				return static_cast<index_type>(this->slot_count++);
+			}
+
+		private:
+			// Moves the payloads and links into the new slots, which then
+			// replace the old ones.
+			void move_into(std::unique_ptr<Node[]>& new_slots, size_type capacity) {
+				size_type moved{ 0 };
+
+				try {
+					for (; moved < this->slot_count; moved++) {
+						Node& slot = this->slots[moved];
+						if (slot.has_data()) {
+							::new (static_cast<void*>(&(new_slots[moved].data))) value_type(std::move_if_noexcept(slot.data));
+						}
+						new_slots[moved].next_node = slot.next_node;
+						new_slots[moved].prev_node = slot.prev_node;
+					}
+				}
+				catch (...) {
+					for (size_type node{ 0 }; node < moved; node++) {
+						if (new_slots[node].has_data()) {
+							new_slots[node].data.~value_type();
+						}
+					}
+					throw;
+				}
+
+				for (size_type node{ 0 }; node < this->slot_count; node++) {
+					if (this->slots[node].has_data()) {
+						this->slots[node].data.~value_type();
+					}
+				}
+
+				this->slots = std::move(new_slots);
+				this->slot_capacity = capacity;
+			}
+		};
+
+		NodeStorage nodes;
+		index_type free_node;
+
+		friend class ArenaNodeList;
+
+		void link_before(index_type node, index_type other_node) noexcept {
+			Node* nodes = this->nodes.data();
+			index_type prev_node = nodes[other_node].prev_node;
+
+			nodes[node].next_node = other_node;
+			nodes[node].prev_node = prev_node;
+			nodes[prev_node].next_node = node;
+			nodes[other_node].prev_node = node;
+		}
+
+		void unlink(index_type node) noexcept {
+			Node* nodes = this->nodes.data();
+			index_type next_node = nodes[node].next_node;
+			index_type prev_node = nodes[node].prev_node;
+
+			nodes[prev_node].next_node = next_node;
+			nodes[next_node].prev_node = prev_node;
+		}
+
+		// Returns a slot without a payload or links.
+		index_type acquire_slot() {
+			if (this->free_node != npos) {
+				index_type node = this->free_node;
+				this->free_node = this->nodes[node].next_node;
+				this->nodes[node].next_node = npos;
+				return node;
+			}
+
+			return this->nodes.push_slot();
+		}
+
+		// Puts a slot without a payload on the free list.
+		void release_slot(index_type node) noexcept {
+			this->nodes[node].next_node = this->free_node;
+			this->nodes[node].prev_node = npos;
+			this->free_node = node;
+		}
+
+		// Constructs a value in a free or new slot and links it before the
+		// other node. The arguments may refer to values of this arena.
+		template <typename... Args>
+		index_type emplace_before(index_type other_node, Args&&... args) {
+			index_type node = this->free_node;
+
+			if (node == npos) {
+				node = this->nodes.emplace_slot(std::forward<Args>(args)...);
+			}
+			else {
+				// A free slot is reused without growth, so nothing moves.
+				::new (static_cast<void*>(&(this->nodes[node].data))) value_type(std::forward<Args>(args)...);
+				this->free_node = this->nodes[node].next_node;
+			}
+
+			this->link_before(node, other_node);
+			return node;
+		}
+
+		// Unlinks the value's slot, destroys the value and frees the slot.
+		// Returns the node that followed it.
+		index_type erase_node(index_type node) noexcept {
+			index_type next_node = this->nodes[node].next_node;
+
+			this->unlink(node);
+			this->nodes[node].data.~value_type();
+			this->release_slot(node);
+
+			return next_node;
+		}
+
+	public:
+		Arena() noexcept : nodes{}, free_node{ npos } {};
+
+		Arena(const Arena& obj) = delete;
+		Arena(Arena&& obj) = delete;
+		Arena& operator=(const Arena& obj) = delete;
+		Arena& operator=(Arena&& obj) = delete;
+
+		// Reserves storage for the given number of slots, so that creating
+		// that many values does not relocate the payloads. Each list uses two
+		// slots for its sentinels.
+		void reserve(size_type capacity) {
+			this->nodes.reserve(capacity);
+		}
+
+		size_type capacity() const noexcept {
+			return this->nodes.capacity();
+		}
+
+		// The number of bytes each value occupies in the arena.
+		static constexpr size_type node_size() noexcept {
+			return sizeof(Node);
+		}
+	};
+
+	template <typename Type>
+	class base_iterator
+	{
+		template <typename OtherType>
+		friend class base_iterator;
+
+		friend class ArenaNodeList;
+
+	protected:
+		using arena_pointer = typename std::conditional<
+			std::is_const<Type>::value,
+			const Arena*,
+			Arena*
+		>::type;
+
+		arena_pointer arena;
+		index_type current_node;
+
+		const typename Arena::Node& node() const noexcept {
+			return this->arena->nodes[this->current_node];
+		}
+
+	public:
+		using iterator_category = std::bidirectional_iterator_tag;
+		using difference_type = std::ptrdiff_t;
+		using value_type = Type;
+		using pointer = Type*;
+		using reference = Type&;
+
+		base_iterator() noexcept : arena{ nullptr }, current_node{ npos } {};
+		base_iterator(arena_pointer arena, index_type starting_node) noexcept :
+			arena{ arena },
+			current_node{ starting_node }
+		{};
+
+		bool is_at_nullptr() const noexcept {
+			return !this->arena || this->current_node == npos;
+		}
+
+		bool is_at_datanode_no_null_check() const noexcept {
+			return this->node().has_data();
+		}
+
+		bool is_at_datanode() const {
+			if (this->is_at_nullptr()) {
+				throw std::runtime_error("The iterator's current node must not be null.");
+			}
+			return this->is_at_datanode_no_null_check();
+		}
+
+		bool is_past_the_end_no_null_check() const noexcept {
+			return this->node().next_node == npos && this->node().prev_node != npos;
+		}
+
+		bool is_past_the_end() const {
+			if (this->is_at_nullptr()) {
+				throw std::runtime_error("The iterator's current node must not be null.");
+			}
+			return this->is_past_the_end_no_null_check();
+		}
+
+		bool is_before_the_start_no_null_check() const noexcept {
+			return this->node().prev_node == npos && this->node().next_node != npos;
+		}
+
+		bool is_before_the_start() const {
+			if (this->is_at_nullptr()) {
+				throw std::runtime_error("The iterator's current node must not be null.");
+			}
+			return this->is_before_the_start_no_null_check();
+		}
+
+		base_iterator& operator++() {
+			if (this->is_at_nullptr()) {
+				throw std::runtime_error("The iterator's current node must not be null.");
+			}
+			if (this->is_past_the_end_no_null_check()) {
+				throw std::runtime_error("Cannot increment iterator that is past-the-end.");
+			}
+
+			this->current_node = this->node().next_node;
+
+			return *this;
+		}
+
+		base_iterator& operator--() {
+			if (this->is_at_nullptr()) {
+				throw std::runtime_error("The iterator's current node must not be null.");
+			}
+			if (this->is_before_the_start_no_null_check()) {
+				throw std::runtime_error("Cannot decrement iterator that is before-the-start.");
+			}
+
+			this->current_node = this->node().prev_node;
+
+			return *this;
+		}
+
+		base_iterator operator++(int) {
+			base_iterator it(*this);
+			++(*this);
+			return it;
+		}
+
+		base_iterator operator--(int) {
+			base_iterator it(*this);
+			--(*this);
+			return it;
+		}
+
+		reference operator*() const {
+			if (this->is_at_nullptr()) {
+				throw std::runtime_error("The iterator's current node must not be null.");
+			}
+			if (!this->is_at_datanode_no_null_check()) {
+				throw std::runtime_error("Cannot dereference iterator that is not at data node");
+			}
+
+			return this->arena->nodes[this->current_node].data;
+		};
+
+		pointer operator->() const {
+			return &(**this);
+		};
+
+		template<typename OtherType>
+		bool operator==(const base_iterator<OtherType>& it) const noexcept {
+			// Invalid iterators are never equal.
+			return (
+				this->arena == it.arena
+				&& this->current_node == it.current_node
+				&& !this->is_at_nullptr()
+			);
+		}
+
+		template<typename OtherType>
+		bool operator!=(const base_iterator<OtherType>& it) const noexcept {
+			return !(*this == it);
+		}
+
+		operator base_iterator<const value_type>() const noexcept
+		{
+			return base_iterator<const value_type>(this->arena, this->current_node);
+		}
+	};
+
+	using iterator = base_iterator<value_type>;
+	using const_iterator = base_iterator<const value_type>;
+	using reverse_iterator = std::reverse_iterator<iterator>;
+	using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+private:
+	Arena* arena;
+	index_type before_start_node;
+	index_type past_end_node;
+	size_type value_count;
+
+	void check_position(const const_iterator& pos) const {
+		if (pos.is_at_nullptr() || pos.arena != this->arena) {
+			throw std::runtime_error("The iterator must be a valid iterator of this list's arena.");
+		}
+	}
+
+public:
+	explicit ArenaNodeList(Arena& arena) :
+		arena{ &arena },
+		before_start_node{ arena.acquire_slot() },
+		past_end_node{ npos },
+		value_count{ 0 }
+	{
+		try {
+			this->past_end_node = arena.acquire_slot();
+		}
+		catch (...) {
+			arena.release_slot(this->before_start_node);
+			throw;
+		}
+
+		this->arena->nodes[this->before_start_node].next_node = this->past_end_node;
+		this->arena->nodes[this->past_end_node].prev_node = this->before_start_node;
+	};
+
+	~ArenaNodeList() noexcept {
+		this->clear();
+		this->arena->release_slot(this->before_start_node);
+		this->arena->release_slot(this->past_end_node);
+	};
+
+	ArenaNodeList(const ArenaNodeList& obj) = delete;
+	ArenaNodeList(ArenaNodeList&& obj) = delete;
+	ArenaNodeList& operator=(const ArenaNodeList& obj) = delete;
+	ArenaNodeList& operator=(ArenaNodeList&& obj) = delete;
+
+	Arena& get_arena() const noexcept {
+		return *(this->arena);
+	};
+
+	iterator begin() noexcept {
+		return iterator(this->arena, this->arena->nodes[this->before_start_node].next_node);
+	};
+	const_iterator begin() const noexcept {
+		return const_iterator(this->arena, this->arena->nodes[this->before_start_node].next_node);
+	};
+	const_iterator cbegin() const noexcept {
+		return this->begin();
+	};
+	iterator end() noexcept {
+		return iterator(this->arena, this->past_end_node);
+	};
+	const_iterator end() const noexcept {
+		return const_iterator(this->arena, this->past_end_node);
+	};
+	const_iterator cend() const noexcept {
+		return this->end();
+	};
+
+	reverse_iterator rbegin() noexcept {
+		return reverse_iterator(this->end());
+	};
+	const_reverse_iterator rbegin() const noexcept {
+		return const_reverse_iterator(this->end());
+	};
+	const_reverse_iterator crbegin() const noexcept {
+		return this->rbegin();
+	};
+	reverse_iterator rend() noexcept {
+		return reverse_iterator(this->begin());
+	};
+	const_reverse_iterator rend() const noexcept {
+		return const_reverse_iterator(this->begin());
+	};
+	const_reverse_iterator crend() const noexcept {
+		return this->rend();
+	};
+
+	bool is_empty() const noexcept {
+		return this->value_count == 0;
+	};
+
+	size_type size() const noexcept {
+		return this->value_count;
+	};
+
+	// The reference is invalidated when the arena grows.
+	reference front() {
+		if (this->is_empty()) {
+			throw std::runtime_error("The list must not be empty.");
+		}
+		return *(this->begin());
+	}
+
+	reference back() {
+		if (this->is_empty()) {
+			throw std::runtime_error("The list must not be empty.");
+		}
+		return *(--(this->end()));
+	}
+
+	template <typename... Args>
+	iterator emplace_back(Args&&... args) {
+		index_type node = this->arena->emplace_before(this->past_end_node, std::forward<Args>(args)...);
+		this->value_count++;
+		return iterator(this->arena, node);
+	}
+
+	template <typename... Args>
+	iterator emplace_front(Args&&... args) {
+		index_type next_node = this->arena->nodes[this->before_start_node].next_node;
+		index_type node = this->arena->emplace_before(next_node, std::forward<Args>(args)...);
+		this->value_count++;
+		return iterator(this->arena, node);
+	}
+
+	// Constructs a value before the iterator's position, which must be in
+	// this list, and returns an iterator to it.
+	template <typename... Args>
+	iterator emplace(const_iterator pos, Args&&... args) {
+		this->check_position(pos);
+		if (pos.is_before_the_start_no_null_check()) {
+			throw std::runtime_error("Cannot insert before this iterator if this iterator is before-the-start.");
+		}
+
+		index_type node = this->arena->emplace_before(pos.current_node, std::forward<Args>(args)...);
+		this->value_count++;
+		return iterator(this->arena, node);
+	}
+
+	// Erases the value at the iterator's position, which must be in this
+	// list, and returns an iterator to the value after it.
+	iterator erase(const_iterator pos) {
+		this->check_position(pos);
+		if (!pos.is_at_datanode_no_null_check()) {
+			throw std::runtime_error("Cannot erase at an iterator that is not at data node.");
+		}
+
+		index_type next_node = this->arena->erase_node(pos.current_node);
+		this->value_count--;
+		return iterator(this->arena, next_node);
+	}
+
+	void pop_front() {
+		if (this->is_empty()) {
+			throw std::runtime_error("The list must not be empty.");
+		}
+		this->arena->erase_node(this->arena->nodes[this->before_start_node].next_node);
+		this->value_count--;
+	}
+
+	void pop_back() {
+		if (this->is_empty()) {
+			throw std::runtime_error("The list must not be empty.");
+		}
+		this->arena->erase_node(this->arena->nodes[this->past_end_node].prev_node);
+		this->value_count--;
+	}
+
+	// Moves the value at it, which must be in the other list, before pos,
+	// which must be in this list, without copying or moving the value. Both
+	// lists must share an arena.
+	void splice(const_iterator pos, ArenaNodeList& other, const_iterator it) {
+		if (other.arena != this->arena) {
+			throw std::invalid_argument("The lists must share an arena.");
+		}
+		this->check_position(pos);
+		this->check_position(it);
+		if (pos.is_before_the_start_no_null_check()) {
+			throw std::runtime_error("Cannot insert before this iterator if this iterator is before-the-start.");
+		}
+		if (!it.is_at_datanode_no_null_check()) {
+			throw std::runtime_error("Cannot splice an iterator that is not at data node.");
+		}
+		if (it.current_node == pos.current_node) {
+			return;
+		}
+
+		this->arena->unlink(it.current_node);
+		this->arena->link_before(it.current_node, pos.current_node);
+		other.value_count--;
+		this->value_count++;
+	}
+
+	void clear() noexcept {
+		index_type node{ this->arena->nodes[this->before_start_node].next_node };
+
+		while (node != this->past_end_node) {
+			node = this->arena->erase_node(node);
+		}
+
+		this->value_count = 0;
+	};
+};
+
+template <typename T>
+constexpr typename ArenaNodeList<T>::index_type ArenaNodeList<T>::npos;
+
+} // namespace goldenrockefeller
+
+#endif
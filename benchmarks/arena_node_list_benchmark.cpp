@@ -0,0 +1,99 @@
+// MIT License
+
+// Copyright(c) 2021 Golden Rockefeller
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+// Memory per element and traversal of a 4M-element list linked in shuffled
+// order, with 32-bit index links (ArenaNodeList) and pointer links
+// (NodeList), for an 8-byte payload.
+//
+// Build and run:
+//   g++ -std=c++11 -O2 -DNDEBUG benchmarks/arena_node_list_benchmark.cpp -o arena_node_list_benchmark && ./arena_node_list_benchmark
+
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "../arena_node_list.hpp"
+#include "../node_list.hpp"
+#include "benchmark.hpp"
+
+using namespace goldenrockefeller;
+
+int main() {
+	const std::size_t count = std::size_t{ 1 } << 22;
+
+	std::vector<std::size_t> order(count);
+	for (std::size_t i{ 0 }; i < count; i++) {
+		order[i] = i;
+	}
+	std::mt19937 random(1);
+	std::shuffle(order.begin(), order.end(), random);
+
+	std::printf("NodeList<long>::DataNode: %zu B per element\n", sizeof(NodeList<long>::DataNode));
+	std::printf("ArenaNodeList<long>: %zu B arena slot per element\n", ArenaNodeList<long>::Arena::node_size());
+
+	{
+		NodeList<long> list;
+		std::vector<NodeList<long>::DataNode> nodes;
+		nodes.reserve(count);
+		for (std::size_t i{ 0 }; i < count; i++) {
+			nodes.emplace_back(long(i));
+		}
+		for (std::size_t i : order) {
+			nodes[i].attach_to(list);
+		}
+
+		benchmark::report_per_item("NodeList, range-for sum", benchmark::best_of(3, [&]() {
+			long sum{ 0 };
+			for (long value : list) {
+				sum += value;
+			}
+			benchmark::keep(sum);
+		}), double(count));
+	}
+
+	{
+		ArenaNodeList<long>::Arena arena;
+		arena.reserve(count + 2);
+		ArenaNodeList<long> staging(arena);
+		std::vector<ArenaNodeList<long>::iterator> nodes;
+		nodes.reserve(count);
+		for (std::size_t i{ 0 }; i < count; i++) {
+			nodes.push_back(staging.emplace_back(long(i)));
+		}
+
+		// Relinks the slots in shuffled order, as the NodeList nodes are.
+		ArenaNodeList<long> list(arena);
+		for (std::size_t i : order) {
+			list.splice(list.end(), staging, nodes[i]);
+		}
+
+		benchmark::report_per_item("ArenaNodeList, range-for sum", benchmark::best_of(3, [&]() {
+			long sum{ 0 };
+			for (long value : list) {
+				sum += value;
+			}
+			benchmark::keep(sum);
+		}), double(count));
+	}
+}
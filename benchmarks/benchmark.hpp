@@ -0,0 +1,76 @@
+// MIT License
+
+// Copyright(c) 2021 Golden Rockefeller
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef GOLDENROCKEFELLER_BENCHMARK_HPP
+#define GOLDENROCKEFELLER_BENCHMARK_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+
+namespace goldenrockefeller {
+namespace benchmark {
+
+// Keeps a value alive so that the computation behind it is not optimized
+// away.
+template <typename T>
+void keep(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+	asm volatile("" : : "r"(&value) : "memory");
+#else
+	static volatile const void* sink;
+	sink = static_cast<const void*>(&value);
+	static_cast<void>(sink);
+#endif
+}
+
+// Returns the best wall-clock time of the given number of runs, in
+// milliseconds.
+template <typename Func>
+double best_of(int runs, Func func) {
+	double best{ 0 };
+
+	for (int run{ 0 }; run < runs; run++) {
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		func();
+		std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+		if (run == 0 || elapsed.count() < best) {
+			best = elapsed.count();
+		}
+	}
+
+	return best;
+}
+
+inline void report(const char* name, double milliseconds) {
+	std::printf("%-56s %10.2f ms\n", name, milliseconds);
+}
+
+inline void report_per_item(const char* name, double milliseconds, double items) {
+	std::printf("%-56s %10.2f ns/item\n", name, milliseconds * 1e6 / items);
+}
+
+} // namespace benchmark
+} // namespace goldenrockefeller
+
+#endif
@@ -0,0 +1,100 @@
+// MIT License
+
+// Copyright(c) 2021 Golden Rockefeller
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+
+// Task switches on one thread: 100 tasks that yield 1M times in total, on a
+// SingleThreadExecutor and on a queue of std::function callbacks that each
+// re-post themselves, the usual allocation-per-hop executor.
+//
+// Build and run (C++20):
+//   g++ -std=c++20 -O2 -DNDEBUG -pthread benchmarks/coroutine_executor_benchmark.cpp -o coroutine_executor_benchmark && ./coroutine_executor_benchmark
+
+#include <cstdio>
+#include <deque>
+#include <functional>
+
+#include "../coroutine_executor.hpp"
+#include "benchmark.hpp"
+
+#if defined(GOLDENROCKEFELLER_HAS_COROUTINES)
+
+using namespace goldenrockefeller;
+
+static Task yield_repeatedly(SingleThreadExecutor& executor, long& counter, int yields) {
+	for (int i{ 0 }; i < yields; i++) {
+		counter++;
+		co_await executor.yield();
+	}
+}
+
+// A callback that re-posts a copy of itself until it has run its share.
+struct Step {
+	std::deque<std::function<void()>>* queue;
+	long* counter;
+	int remaining;
+
+	void operator()() const {
+		++*(this->counter);
+		if (this->remaining > 1) {
+			this->queue->push_back(Step{ this->queue, this->counter, this->remaining - 1 });
+		}
+	}
+};
+
+int main() {
+	const int task_count{ 100 };
+	const int yields_per_task{ 10000 };
+	const double switch_count{ double(task_count) * yields_per_task };
+
+	long counter{ 0 };
+
+	benchmark::report_per_item("SingleThreadExecutor, 100 tasks, 1M yields", benchmark::best_of(5, [&]() {
+		SingleThreadExecutor executor;
+		for (int i{ 0 }; i < task_count; i++) {
+			executor.spawn(yield_repeatedly(executor, counter, yields_per_task));
+		}
+		executor.run();
+	}), switch_count);
+
+	benchmark::report_per_item("std::function + std::deque, 100 tasks, 1M hops", benchmark::best_of(5, [&]() {
+		std::deque<std::function<void()>> queue;
+		for (int i{ 0 }; i < task_count; i++) {
+			queue.push_back(Step{ &queue, &counter, yields_per_task });
+		}
+		while (!queue.empty()) {
+			std::function<void()> step = std::move(queue.front());
+			queue.pop_front();
+			step();
+		}
+	}), switch_count);
+
+	benchmark::keep(counter);
+}
+
+#else
+
+int main() {
+	std::puts("coroutine_executor_benchmark needs C++20 coroutines");
+}
+
+#endif
@@ -0,0 +1,145 @@
+// MIT License
+
+// Copyright(c) 2021 Golden Rockefeller
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+// A 2:1 push/pop mix on one shared list, timed per operation, with a
+// FlatCombiningNodeList, a std::mutex-protected NodeList and a
+// SpinLock-protected NodeList, at 8, 16 and 64 threads. On one core this
+// shows the per-operation overhead only; the cache-line traffic that flat
+// combining saves needs a multi-core machine.
+//
+// Build and run:
+//   g++ -std=c++17 -O2 -DNDEBUG -pthread benchmarks/flat_combining_node_list_benchmark.cpp -o flat_combining_node_list_benchmark && ./flat_combining_node_list_benchmark
+
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "../flat_combining_node_list.hpp"
+#include "../sync_primitives.hpp"
+#include "benchmark.hpp"
+
+using namespace goldenrockefeller;
+
+using List = FlatCombiningNodeList<long>;
+
+static const int nodes_per_thread{ 16 };
+static const int operation_count{ 1 << 21 };
+
+// Each run starts from an empty list, so that every thread starts out
+// holding only its own nodes.
+template <typename Work>
+double run_threads(int thread_count, List::list_type& list, Work work) {
+	return benchmark::best_of(3, [&]() {
+		list.clear();
+		std::vector<std::thread> threads;
+		for (int thread{ 0 }; thread < thread_count; thread++) {
+			threads.emplace_back(work, thread);
+		}
+		for (std::thread& thread : threads) {
+			thread.join();
+		}
+	});
+}
+
+// Each thread pushes the nodes it holds at the back and pops from the front:
+// two pushes for every pop while it holds nodes, pops otherwise.
+template <typename Push, typename Pop>
+void mixed_workload(List::DataNode* nodes, int operations, Push push, Pop pop) {
+	List::DataNode* held[nodes_per_thread];
+	int held_count{ 0 };
+	for (int i{ 0 }; i < nodes_per_thread; i++) {
+		held[held_count++] = nodes + i;
+	}
+
+	for (int i{ 0 }; i < operations; i++) {
+		if (held_count > 0 && i % 3 != 2) {
+			push(*held[--held_count]);
+		}
+		else if (List::DataNode* node = pop()) {
+			node->data++;
+			held[held_count++] = node;
+		}
+	}
+}
+
+template <typename Lock>
+double run_locked(int thread_count, List::DataNode* nodes) {
+	Lock lock;
+	List::list_type list;
+	const int operations = operation_count / thread_count;
+
+	double milliseconds = run_threads(thread_count, list, [&](int thread) {
+		mixed_workload(nodes + thread * nodes_per_thread, operations,
+			[&](List::DataNode& node) {
+				std::lock_guard<Lock> guard(lock);
+				node.attach_to(list);
+			},
+			[&]() -> List::DataNode* {
+				std::lock_guard<Lock> guard(lock);
+				List::DataNode* node = list.front_node();
+				if (node) {
+					node->detach();
+				}
+				return node;
+			}
+		);
+	});
+
+	list.clear();
+	return milliseconds;
+}
+
+static double run_flat_combining(int thread_count, List::DataNode* nodes) {
+	List list(static_cast<List::size_type>(thread_count));
+	const int operations = operation_count / thread_count;
+
+	double milliseconds = run_threads(thread_count, list.unsynchronized_list(), [&](int thread) {
+		List::Handle handle(list);
+		mixed_workload(nodes + thread * nodes_per_thread, operations,
+			[&](List::DataNode& node) { handle.push_back(node); },
+			[&]() { return handle.pop_front(); }
+		);
+	});
+
+	list.unsynchronized_list().clear();
+	return milliseconds;
+}
+
+int main() {
+	char name[80];
+
+	for (int thread_count : { 8, 16, 64 }) {
+		std::unique_ptr<List::DataNode[]> nodes(new List::DataNode[thread_count * nodes_per_thread]);
+
+		std::snprintf(name, sizeof(name), "FlatCombiningNodeList, %d threads, per operation", thread_count);
+		benchmark::report_per_item(name, run_flat_combining(thread_count, nodes.get()), operation_count);
+
+		std::snprintf(name, sizeof(name), "std::mutex + NodeList, %d threads, per operation", thread_count);
+		benchmark::report_per_item(name, run_locked<std::mutex>(thread_count, nodes.get()), operation_count);
+
+		std::snprintf(name, sizeof(name), "SpinLock + NodeList, %d threads, per operation", thread_count);
+		benchmark::report_per_item(name, run_locked<SpinLock>(thread_count, nodes.get()), operation_count);
+	}
+}
@@ -0,0 +1,115 @@
+// MIT License
+
+// Copyright(c) 2021 Golden Rockefeller
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+
+// Pop+push pairs on a shared free list of 1024 nodes, timed per operation,
+// with a LockFreeNodeStack and with a std::mutex-protected NodeList, at 2, 8
+// and 64 threads. On one core this shows the per-operation overhead only;
+// scaling needs a multi-core machine.
+//
+// Build and run:
+//   g++ -std=c++17 -O2 -DNDEBUG -pthread benchmarks/lock_free_node_stack_benchmark.cpp -o lock_free_node_stack_benchmark && ./lock_free_node_stack_benchmark
+
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "../lock_free_node_stack.hpp"
+#include "benchmark.hpp"
+
+using namespace goldenrockefeller;
+
+using Stack = LockFreeNodeStack<long>;
+
+template <typename Work>
+double run_threads(int thread_count, Work work) {
+	return benchmark::best_of(3, [&]() {
+		std::vector<std::thread> threads;
+		for (int thread{ 0 }; thread < thread_count; thread++) {
+			threads.emplace_back(work);
+		}
+		for (std::thread& thread : threads) {
+			thread.join();
+		}
+	});
+}
+
+int main() {
+	const int node_count{ 1024 };
+	const int pair_count{ 1 << 21 };
+
+	std::unique_ptr<Stack::DataNode[]> nodes(new Stack::DataNode[node_count]);
+	char name[80];
+
+	for (int thread_count : { 2, 8, 64 }) {
+		const int pairs_per_thread = pair_count / thread_count;
+
+		{
+			Stack stack;
+			for (int i{ 0 }; i < node_count; i++) {
+				stack.push(nodes[i]);
+			}
+
+			std::snprintf(name, sizeof(name), "LockFreeNodeStack, %d threads, per pop or push", thread_count);
+			benchmark::report_per_item(name, run_threads(thread_count, [&]() {
+				for (int i{ 0 }; i < pairs_per_thread; i++) {
+					Stack::DataNode* node = stack.pop();
+					node->data++;
+					stack.push(*node);
+				}
+			}), 2.0 * pair_count);
+
+			Stack::list_type list = stack.pop_all();
+			list.clear();
+		}
+
+		{
+			std::mutex mutex;
+			Stack::list_type list;
+			for (int i{ 0 }; i < node_count; i++) {
+				nodes[i].attach_to(list);
+			}
+
+			std::snprintf(name, sizeof(name), "std::mutex + NodeList, %d threads, per pop or push", thread_count);
+			benchmark::report_per_item(name, run_threads(thread_count, [&]() {
+				for (int i{ 0 }; i < pairs_per_thread; i++) {
+					Stack::DataNode* node;
+					{
+						std::lock_guard<std::mutex> guard(mutex);
+						node = list.front_node();
+						node->detach();
+					}
+					node->data++;
+					{
+						std::lock_guard<std::mutex> guard(mutex);
+						node->attach_to(list);
+					}
+				}
+			}), 2.0 * pair_count);
+
+			list.clear();
+		}
+	}
+}
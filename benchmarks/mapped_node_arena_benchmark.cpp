@@ -0,0 +1,171 @@
+// MIT License
+
+// Copyright(c) 2021 Golden Rockefeller
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+// Traverses an 8M-node list linked in random order, timed per node, with
+// the nodes in a MappedNodeArena with normal pages, with transparent huge
+// pages (THP) and with THP prefaulted, and reports the time taken to map
+// and construct the nodes. On Linux it also counts data TLB load misses
+// during the traversal, where the kernel exposes the hardware counters to
+// the process; elsewhere it prints n/a.
+//
+// Build and run:
+//   g++ -std=c++11 -O2 -DNDEBUG benchmarks/mapped_node_arena_benchmark.cpp -o mapped_node_arena_benchmark && ./mapped_node_arena_benchmark
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "../mapped_node_arena.hpp"
+#include "benchmark.hpp"
+
+using namespace goldenrockefeller;
+
+using Arena = MappedNodeArena<long>;
+
+static const std::size_t node_count{ 8 << 20 };
+
+// Counts the calling thread's data TLB load misses in user space.
+class TlbMissCounter {
+	int descriptor;
+
+public:
+	TlbMissCounter() : descriptor{ -1 } {
+#if defined(__linux__)
+		perf_event_attr attributes;
+		std::memset(&attributes, 0, sizeof(attributes));
+		attributes.size = sizeof(attributes);
+		attributes.type = PERF_TYPE_HW_CACHE;
+		attributes.config = PERF_COUNT_HW_CACHE_DTLB
+			| (PERF_COUNT_HW_CACHE_OP_READ << 8)
+			| (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+		attributes.disabled = 1;
+		attributes.exclude_kernel = 1;
+		attributes.exclude_hv = 1;
+		this->descriptor = static_cast<int>(syscall(SYS_perf_event_open, &attributes, 0, -1, -1, 0));
+#endif
+	};
+
+	~TlbMissCounter() {
+#if defined(__linux__)
+		if (this->descriptor >= 0) {
+			close(this->descriptor);
+		}
+#endif
+	};
+
+	TlbMissCounter(const TlbMissCounter& obj) = delete;
+	TlbMissCounter& operator=(const TlbMissCounter& obj) = delete;
+
+	bool is_available() const noexcept {
+		return this->descriptor >= 0;
+	};
+
+	void start() {
+#if defined(__linux__)
+		if (this->descriptor >= 0) {
+			ioctl(this->descriptor, PERF_EVENT_IOC_RESET, 0);
+			ioctl(this->descriptor, PERF_EVENT_IOC_ENABLE, 0);
+		}
+#endif
+	};
+
+	// The misses since start, or zero if the counter is not available.
+	long long stop() {
+		long long count{ 0 };
+#if defined(__linux__)
+		if (this->descriptor >= 0) {
+			ioctl(this->descriptor, PERF_EVENT_IOC_DISABLE, 0);
+			if (read(this->descriptor, &count, sizeof(count)) != sizeof(count)) {
+				count = 0;
+			}
+		}
+#endif
+		return count;
+	};
+};
+
+static void run(const char* name, HugePages huge_pages, bool prefault, const std::vector<std::size_t>& order) {
+	char label[80];
+	std::unique_ptr<Arena> arena;
+	Arena::DataNode* first = nullptr;
+
+	std::snprintf(label, sizeof(label), "%s, map and construct", name);
+	benchmark::report(label, benchmark::best_of(1, [&]() {
+		arena.reset(new Arena(node_count, huge_pages, prefault));
+		first = &(arena->allocate(0L));
+		for (std::size_t i{ 1 }; i < node_count; i++) {
+			arena->allocate(static_cast<long>(i));
+		}
+	}));
+
+	// The nodes sit in address order; links them in the shuffled order.
+	Arena::list_type list;
+	for (std::size_t index : order) {
+		first[index].attach_to(list);
+	}
+
+	TlbMissCounter counter;
+	long long misses{ 0 };
+
+	std::snprintf(label, sizeof(label), "%s, traversal", name);
+	benchmark::report_per_item(label, benchmark::best_of(3, [&]() {
+		counter.start();
+		long sum{ 0 };
+		for (long value : list) {
+			sum += value;
+		}
+		misses = counter.stop();
+		benchmark::keep(sum);
+	}), static_cast<double>(node_count));
+
+	std::snprintf(label, sizeof(label), "%s, dTLB load misses per node", name);
+	if (counter.is_available()) {
+		std::printf("%-56s %10.3f\n", label, static_cast<double>(misses) / node_count);
+	}
+	else {
+		std::printf("%-56s %10s\n", label, "n/a");
+	}
+
+	list.clear();
+}
+
+int main() {
+	std::vector<std::size_t> order(node_count);
+	std::iota(order.begin(), order.end(), std::size_t{ 0 });
+	std::shuffle(order.begin(), order.end(), std::mt19937_64{ 42 });
+
+	run("4 KiB pages", HugePages::none, false, order);
+	run("THP", HugePages::transparent, false, order);
+	run("THP, prefaulted", HugePages::transparent, true, order);
+}
@@ -0,0 +1,321 @@
+// MIT License
+
+// Copyright(c) 2021 Golden Rockefeller
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+
+// Traversal of NodeList with and without tagged links, and the list
+// algorithms that walk or relink many nodes at once.
+//
+// Build and run:
+//   g++ -std=c++11 -O2 -DNDEBUG benchmarks/node_list_benchmark.cpp -o node_list_benchmark && ./node_list_benchmark
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <list>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "../node_list.hpp"
+#include "benchmark.hpp"
+
+using namespace goldenrockefeller;
+
+template <typename ListType>
+void run_traversal(const char* name, std::size_t count) {
+	ListType list;
+	std::unique_ptr<typename ListType::DataNode[]> nodes(new typename ListType::DataNode[count]);
+	for (std::size_t i{ 0 }; i < count; i++) {
+		nodes[i].data = long(i);
+		nodes[i].attach_to(list);
+	}
+
+	benchmark::report(name, benchmark::best_of(5, [&]() {
+		long sum{ 0 };
+		for (long value : list) {
+			sum += value;
+		}
+		benchmark::keep(sum);
+	}));
+
+	list.clear();
+}
+
+// Returns the best time of five runs of work, each after an untimed setup,
+// in milliseconds.
+template <typename Setup, typename Work>
+double best_time_after(Setup setup, Work work) {
+	double best{ 0 };
+
+	for (int run{ 0 }; run < 5; run++) {
+		setup();
+
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		work();
+		std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+		if (run == 0 || elapsed.count() < best) {
+			best = elapsed.count();
+		}
+	}
+
+	return best;
+}
+
+void run_attach(std::size_t count) {
+	NodeList<long> list;
+	std::unique_ptr<NodeList<long>::DataNode[]> nodes(new NodeList<long>::DataNode[count]);
+	std::vector<NodeList<long>::DataNode*> pointers(count);
+	for (std::size_t i{ 0 }; i < count; i++) {
+		pointers[i] = &nodes[i];
+	}
+	auto detach_all = [&]() { list.clear(); };
+
+	benchmark::report("Attach 10M preallocated nodes, attach_to loop", best_time_after(detach_all, [&]() {
+		for (std::size_t i{ 0 }; i < count; i++) {
+			nodes[i].attach_to(list);
+		}
+	}));
+
+	benchmark::report("Attach 10M preallocated nodes, attach_range of nodes", best_time_after(detach_all, [&]() {
+		list.attach_range(nodes.get(), nodes.get() + count);
+	}));
+
+	// The pointer array adds 80 MB of reads to the same pass.
+	benchmark::report("Attach 10M preallocated nodes, attach_range of pointers", best_time_after(detach_all, [&]() {
+		list.attach_range(pointers);
+	}));
+
+	list.clear();
+}
+
+void run_remove_if(std::size_t count) {
+	NodeList<long> list;
+	std::unique_ptr<NodeList<long>::DataNode[]> nodes(new NodeList<long>::DataNode[count]);
+	for (std::size_t i{ 0 }; i < count; i++) {
+		nodes[i].data = long(i);
+	}
+	auto attach_all = [&]() {
+		list.clear();
+		list.attach_range(nodes.get(), nodes.get() + count);
+	};
+
+	benchmark::report("Remove every third of 5M nodes, NodeList::remove_if", best_time_after(attach_all, [&]() {
+		benchmark::keep(list.remove_if([](long value) { return value % 3 == 0; }));
+	}));
+
+	benchmark::report("Keep unique runs of 5M nodes, NodeList::unique", best_time_after(attach_all, [&]() {
+		benchmark::keep(list.unique([](long a, long b) { return a / 2 == b / 2; }));
+	}));
+
+	benchmark::report("Partition 5M nodes, NodeList::partition", best_time_after(attach_all, [&]() {
+		NodeList<long> odd = list.partition([](long value) { return value % 2 == 1; });
+		benchmark::keep(odd.is_empty());
+		odd.clear();
+	}));
+
+	list.clear();
+
+	// Includes freeing the removed nodes, which NodeList leaves to the
+	// caller.
+	std::list<long> std_list;
+	auto fill = [&]() {
+		std_list.clear();
+		for (std::size_t i{ 0 }; i < count; i++) {
+			std_list.push_back(long(i));
+		}
+	};
+
+	benchmark::report("Remove every third of 5M nodes, std::list::remove_if", best_time_after(fill, [&]() {
+		std_list.remove_if([](long value) { return value % 3 == 0; });
+		benchmark::keep(std_list.size());
+	}));
+}
+
+// Nodes stored by value in a std::vector, which relocates them as it grows,
+// against nodes allocated one by one and attached in shuffled order.
+void run_relocation(std::size_t count) {
+	using Node = NodeList<long>::DataNode;
+
+	NodeList<long> vector_list;
+	std::vector<Node> vector_nodes;
+	benchmark::report("Grow a vector of 4M attached nodes from empty", benchmark::best_of(5, [&]() {
+		vector_list.clear();
+		std::vector<Node>().swap(vector_nodes);
+		for (std::size_t i{ 0 }; i < count; i++) {
+			vector_nodes.emplace_back(long(i));
+			vector_nodes.back().attach_to(vector_list);
+		}
+	}));
+
+	benchmark::report("Range-for over 4M nodes stored in a vector", benchmark::best_of(5, [&]() {
+		long sum{ 0 };
+		for (long value : vector_list) {
+			sum += value;
+		}
+		benchmark::keep(sum);
+	}));
+
+	vector_list.clear();
+	vector_nodes.clear();
+
+	std::vector<std::unique_ptr<Node>> heap_nodes(count);
+	for (std::size_t i{ 0 }; i < count; i++) {
+		heap_nodes[i].reset(new Node(long(i)));
+	}
+	std::shuffle(heap_nodes.begin(), heap_nodes.end(), std::mt19937_64(42));
+
+	NodeList<long> heap_list;
+	for (std::unique_ptr<Node>& node : heap_nodes) {
+		node->attach_to(heap_list);
+	}
+
+	benchmark::report("Range-for over 4M heap nodes in shuffled order", benchmark::best_of(5, [&]() {
+		long sum{ 0 };
+		for (long value : heap_list) {
+			sum += value;
+		}
+		benchmark::keep(sum);
+	}));
+
+	heap_list.clear();
+}
+
+// Teardown of a pool of nodes stored in a vector, including freeing the
+// vector, in each link mode.
+template <LinkMode Mode, typename Teardown>
+void run_teardown(const char* name, std::size_t count, Teardown teardown) {
+	using ListType = NodeList<long, false, Mode>;
+
+	std::unique_ptr<ListType> list;
+	std::unique_ptr<std::vector<typename ListType::DataNode>> nodes;
+	auto setup = [&]() {
+		list.reset(new ListType());
+		nodes.reset(new std::vector<typename ListType::DataNode>(count));
+		list->attach_range(nodes->data(), nodes->data() + count);
+	};
+
+	benchmark::report(name, best_time_after(setup, [&]() {
+		teardown(*list);
+		nodes.reset();
+	}));
+
+	list.reset();
+}
+
+// One pass over shuffled heap nodes through the links, against passes over
+// a snapshot of their data or of their addresses.
+void run_snapshots(std::size_t count) {
+	using Node = NodeList<double>::DataNode;
+
+	std::vector<std::unique_ptr<Node>> heap_nodes(count);
+	for (std::size_t i{ 0 }; i < count; i++) {
+		heap_nodes[i].reset(new Node(double(i)));
+	}
+	std::shuffle(heap_nodes.begin(), heap_nodes.end(), std::mt19937_64(42));
+
+	NodeList<double> list;
+	for (std::unique_ptr<Node>& node : heap_nodes) {
+		node->attach_to(list);
+	}
+
+	std::unique_ptr<double[]> values(new double[count]);
+	std::vector<Node*> node_snapshot;
+
+	benchmark::report("Range-for sum over 4M shuffled heap nodes", benchmark::best_of(3, [&]() {
+		double sum{ 0 };
+		for (double value : list) {
+			sum += value;
+		}
+		benchmark::keep(sum);
+	}));
+
+	benchmark::report("Snapshot 4M shuffled nodes into a buffer", benchmark::best_of(3, [&]() {
+		benchmark::keep(list.snapshot(values.get(), count));
+	}));
+
+	benchmark::report("Sum over the snapshot of 4M nodes", benchmark::best_of(3, [&]() {
+		double sum{ 0 };
+		for (std::size_t i{ 0 }; i < count; i++) {
+			sum += values[i];
+		}
+		benchmark::keep(sum);
+	}));
+
+	benchmark::report("Snapshot the addresses of 4M shuffled nodes", benchmark::best_of(3, [&]() {
+		node_snapshot = list.snapshot_nodes();
+	}));
+
+	benchmark::report("Snapshot the addresses of 4M shuffled nodes into a buffer", benchmark::best_of(3, [&]() {
+		benchmark::keep(list.snapshot_nodes(node_snapshot.data(), count));
+	}));
+
+	benchmark::report("Gather 4M shuffled nodes through their addresses", benchmark::best_of(3, [&]() {
+		NodeList<double>::gather(node_snapshot.data(), count, values.get());
+		benchmark::keep(values[count - 1]);
+	}));
+
+	benchmark::report("Scatter to 4M shuffled nodes through their addresses", benchmark::best_of(3, [&]() {
+		NodeList<double>::scatter(node_snapshot.data(), count, values.get());
+	}));
+
+	benchmark::report("Scatter to 4M shuffled nodes by list walk", benchmark::best_of(3, [&]() {
+		benchmark::keep(list.scatter(values.get(), count));
+	}));
+
+	list.clear();
+}
+
+int main() {
+	const std::size_t count{ std::size_t{ 1 } << 22 };
+
+	run_traversal<NodeList<long>>("Range-for over 4M nodes, untagged links", count);
+	run_traversal<NodeList<long, true>>("Range-for over 4M nodes, tagged links", count);
+
+	run_attach(10000000);
+	run_remove_if(5000000);
+	run_relocation(count);
+	run_snapshots(count);
+
+	const std::size_t pool_size{ 10000000 };
+	auto keep_attached = [](NodeList<long>&) {};
+	auto dispose = [](long& sum) {
+		return [&sum](NodeList<long>::DataNode& node) { sum += node.data; };
+	};
+	long sum{ 0 };
+
+	run_teardown<LinkMode::auto_unlink>("Tear down 10M nodes, auto_unlink, destruct attached", pool_size, keep_attached);
+	run_teardown<LinkMode::auto_unlink>("Tear down 10M nodes, auto_unlink, clear", pool_size, [](NodeList<long>& list) {
+		list.clear();
+	});
+	run_teardown<LinkMode::auto_unlink>("Tear down 10M nodes, auto_unlink, clear_and_dispose", pool_size, [&](NodeList<long>& list) {
+		list.clear_and_dispose(dispose(sum));
+	});
+	run_teardown<LinkMode::safe>("Tear down 10M nodes, safe, clear_and_dispose", pool_size, [&](NodeList<long, false, LinkMode::safe>& list) {
+		list.clear_and_dispose([&](NodeList<long, false, LinkMode::safe>::DataNode& node) { sum += node.data; });
+	});
+	run_teardown<LinkMode::normal>("Tear down 10M nodes, normal, clear_and_dispose", pool_size, [&](NodeList<long, false, LinkMode::normal>& list) {
+		list.clear_and_dispose([&](NodeList<long, false, LinkMode::normal>::DataNode& node) { sum += node.data; });
+	});
+	benchmark::keep(sum);
+}
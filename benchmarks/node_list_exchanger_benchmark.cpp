@@ -0,0 +1,169 @@
+// MIT License
+
+// Copyright(c) 2021 Golden Rockefeller
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+// Hands 3M items from one producer thread to one consumer thread, with a
+// NodeListExchanger in batches of at least 64 and with a std::mutex-protected
+// NodeList used as a per-item queue. The nodes circulate through a second
+// exchanger, or a second locked list, back to the producer. While the
+// consumer has not taken the last batch, the producer keeps adding to the
+// next one.
+//
+// Build and run:
+//   g++ -std=c++17 -O2 -DNDEBUG -pthread benchmarks/node_list_exchanger_benchmark.cpp -o node_list_exchanger_benchmark && ./node_list_exchanger_benchmark
+
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "../node_list_exchanger.hpp"
+#include "benchmark.hpp"
+
+using namespace goldenrockefeller;
+
+using Exchanger = NodeListExchanger<long>;
+using List = Exchanger::list_type;
+
+static const long item_count{ 3000000 };
+static const int node_count{ 1024 };
+static const int batch_size{ 64 };
+
+static double run_exchanger(List::DataNode* nodes) {
+	return benchmark::best_of(3, [&]() {
+		Exchanger forward;
+		Exchanger backward;
+		List pool;
+		for (int i{ 0 }; i < node_count; i++) {
+			nodes[i].attach_to(pool);
+		}
+
+		std::thread consumer([&]() {
+			List received;
+			List returned;
+			long count{ 0 };
+			long sum{ 0 };
+			while (count < item_count) {
+				if (!forward.take(received)) {
+					std::this_thread::yield();
+					continue;
+				}
+				while (List::DataNode* node = received.front_node()) {
+					sum += node->data;
+					count++;
+					node->attach_to(returned);
+				}
+				backward.publish(returned);
+			}
+			benchmark::keep(sum);
+		});
+
+		List batch;
+		int batched{ 0 };
+		for (long sent{ 0 }; sent < item_count; ) {
+			List::DataNode* node = pool.front_node();
+			if (!node) {
+				if (!backward.take(pool)) {
+					std::this_thread::yield();
+				}
+				continue;
+			}
+			node->data = sent;
+			node->attach_to(batch);
+			sent++;
+			batched++;
+			if (batched >= batch_size && forward.publish(batch)) {
+				batched = 0;
+			}
+		}
+		while (!forward.publish(batch)) {
+			std::this_thread::yield();
+		}
+
+		consumer.join();
+		pool.clear();
+	});
+}
+
+static double run_locked_queue(List::DataNode* nodes) {
+	return benchmark::best_of(3, [&]() {
+		std::mutex queue_mutex;
+		std::mutex pool_mutex;
+		List queue;
+		List pool;
+		for (int i{ 0 }; i < node_count; i++) {
+			nodes[i].attach_to(pool);
+		}
+
+		std::thread consumer([&]() {
+			long count{ 0 };
+			long sum{ 0 };
+			while (count < item_count) {
+				List::DataNode* node;
+				{
+					std::lock_guard<std::mutex> guard(queue_mutex);
+					node = queue.front_node();
+					if (node) {
+						node->detach();
+					}
+				}
+				if (!node) {
+					std::this_thread::yield();
+					continue;
+				}
+				sum += node->data;
+				count++;
+				std::lock_guard<std::mutex> guard(pool_mutex);
+				node->attach_to(pool);
+			}
+			benchmark::keep(sum);
+		});
+
+		for (long sent{ 0 }; sent < item_count; ) {
+			List::DataNode* node;
+			{
+				std::lock_guard<std::mutex> guard(pool_mutex);
+				node = pool.front_node();
+				if (node) {
+					node->detach();
+				}
+			}
+			if (!node) {
+				std::this_thread::yield();
+				continue;
+			}
+			node->data = sent;
+			sent++;
+			std::lock_guard<std::mutex> guard(queue_mutex);
+			node->attach_to(queue);
+		}
+
+		consumer.join();
+		pool.clear();
+	});
+}
+
+int main() {
+	std::unique_ptr<List::DataNode[]> nodes(new List::DataNode[node_count]);
+
+	benchmark::report_per_item("NodeListExchanger, batches of at least 64", run_exchanger(nodes.get()), item_count);
+	benchmark::report_per_item("std::mutex + NodeList, per item", run_locked_queue(nodes.get()), item_count);
+}
@@ -0,0 +1,98 @@
+// MIT License
+
+// Copyright(c) 2021 Golden Rockefeller
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+// Nodes allocated by a producer thread and freed by a consumer thread, which
+// receives them through an SpscNodeQueue, timed per node: from a NodePool,
+// with the consumer returning the nodes to the producer's cache in batches,
+// and with operator new and delete.
+//
+// Build and run:
+//   g++ -std=c++17 -O2 -DNDEBUG -pthread benchmarks/node_pool_benchmark.cpp -o node_pool_benchmark && ./node_pool_benchmark
+
+#include <thread>
+
+#include "../node_pool.hpp"
+#include "../spsc_node_queue.hpp"
+#include "benchmark.hpp"
+
+using namespace goldenrockefeller;
+
+using Pool = NodePool<long>;
+using Queue = SpscNodeQueue<long>;
+
+static const long node_count{ 5000000 };
+
+// Passes node_count nodes from allocate() on this thread to free() on a
+// consumer thread.
+template <typename Allocate, typename Free, typename Idle>
+void transfer(Queue& queue, Allocate allocate, Free free, Idle idle) {
+	std::thread consumer([&]() {
+		long sum{ 0 };
+		for (long received{ 0 }; received < node_count; ) {
+			Queue::DataNode* node = queue.dequeue();
+			if (!node) {
+				idle();
+				std::this_thread::yield();
+				continue;
+			}
+			sum += node->data;
+			free(*node);
+			received++;
+		}
+		benchmark::keep(sum);
+	});
+
+	for (long sent{ 0 }; sent < node_count; sent++) {
+		Queue::DataNode& node = allocate(sent);
+		while (!queue.enqueue(node)) {
+			std::this_thread::yield();
+		}
+	}
+
+	consumer.join();
+}
+
+int main() {
+	benchmark::report_per_item("NodePool, cross-thread acquire and release", benchmark::best_of(3, []() {
+		Pool pool(2);
+		Queue queue(1024);
+		Pool::Handle producer(pool);
+		Pool::Handle consumer(pool);
+
+		transfer(queue,
+			[&](long value) -> Queue::DataNode& { return producer.acquire(value); },
+			[&](Queue::DataNode& node) { consumer.release(node); },
+			[&]() { consumer.flush(); }
+		);
+	}), node_count);
+
+	benchmark::report_per_item("operator new and delete, cross-thread", benchmark::best_of(3, []() {
+		Queue queue(1024);
+
+		transfer(queue,
+			[](long value) -> Queue::DataNode& { return *(new Queue::DataNode(value)); },
+			[](Queue::DataNode& node) { delete &node; },
+			[]() {}
+		);
+	}), node_count);
+}
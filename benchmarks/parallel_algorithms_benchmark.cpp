@@ -0,0 +1,106 @@
+// MIT License
+
+// Copyright(c) 2021 Golden Rockefeller
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+// Parallel traversals of a NodeList against a serial loop, with light and
+// heavy work per node, on 1 to 32 threads, splitting the list on every call
+// or once up front. On one core this measures only the cost of the
+// splitting pass and the threads; the scaling with the core count needs a
+// multi-core machine.
+//
+// Build and run:
+//   g++ -std=c++11 -O2 -DNDEBUG -pthread benchmarks/parallel_algorithms_benchmark.cpp -o parallel_algorithms_benchmark && ./parallel_algorithms_benchmark
+
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "../parallel_algorithms.hpp"
+#include "benchmark.hpp"
+
+using namespace goldenrockefeller;
+
+static double heavy(double value) {
+	for (int i{ 0 }; i < 20; i++) {
+		value = std::sqrt(value + 1.0);
+	}
+	return value;
+}
+
+template <typename Transform>
+void run(const char* work_name, NodeList<double>& list, Transform transform) {
+	std::string name = std::string(work_name) + ", serial loop";
+	benchmark::report(name.c_str(), benchmark::best_of(3, [&]() {
+		double sum{ 0 };
+		for (double value : list) {
+			sum += transform(value);
+		}
+		benchmark::keep(sum);
+	}));
+
+	for (std::size_t thread_count{ 1 }; thread_count <= 32; thread_count *= 2) {
+		name = std::string(work_name) + ", " + std::to_string(thread_count) + " thread(s)";
+		benchmark::report(name.c_str(), benchmark::best_of(3, [&]() {
+			benchmark::keep(parallel_transform_reduce(
+				list,
+				0.0,
+				[](double a, double b) { return a + b; },
+				transform,
+				thread_count
+			));
+		}));
+
+		std::vector<NodeList<double>::iterator> chunk_starts = split_for_threads(list, thread_count);
+		name = std::string(work_name) + ", " + std::to_string(thread_count) + " thread(s), reused split";
+		benchmark::report(name.c_str(), benchmark::best_of(3, [&]() {
+			benchmark::keep(parallel_transform_reduce(
+				list,
+				chunk_starts,
+				0.0,
+				[](double a, double b) { return a + b; },
+				transform,
+				thread_count
+			));
+		}));
+	}
+}
+
+int main() {
+	const std::size_t count{ 10000000 };
+
+	std::vector<NodeList<double>::DataNode> nodes(count);
+	NodeList<double> list;
+	for (std::size_t i{ 0 }; i < count; i++) {
+		nodes[i].data = double(i);
+	}
+	list.attach_range(nodes.data(), nodes.data() + count);
+
+	benchmark::report("Split 10M nodes into 32 chunks", benchmark::best_of(3, [&]() {
+		benchmark::keep(split_into_chunks(list, 32).size());
+	}));
+
+	run("Sum of 10M nodes", list, [](double value) { return value; });
+	run("Sum of 20 sqrts per node, 10M nodes", list, heavy);
+
+	list.clear();
+}
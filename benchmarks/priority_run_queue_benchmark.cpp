@@ -0,0 +1,73 @@
+// MIT License
+
+// Copyright(c) 2021 Golden Rockefeller
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+
+// Steady-state enqueue plus dequeue on a 200-level PriorityRunQueue holding
+// 1024 tasks, with each dequeued task re-enqueued at a pseudo-random level.
+//
+// Build and run:
+//   g++ -std=c++11 -O2 -DNDEBUG benchmarks/priority_run_queue_benchmark.cpp -o priority_run_queue_benchmark && ./priority_run_queue_benchmark
+
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+#include "../priority_run_queue.hpp"
+#include "benchmark.hpp"
+
+using namespace goldenrockefeller;
+
+using Queue = PriorityRunQueue<int, 200>;
+
+int main() {
+	const std::size_t task_count{ 1024 };
+	const std::size_t operation_count{ 10000000 };
+
+	std::unique_ptr<Queue> queue(new Queue());
+	std::vector<Queue::DataNode> tasks(task_count);
+	std::uint32_t random{ 1 };
+
+	auto next_level = [&random]() {
+		random = random * 1664525u + 1013904223u;
+		return std::size_t(random >> 8) % Queue::level_count;
+	};
+
+	for (Queue::DataNode& task : tasks) {
+		queue->enqueue(task, next_level());
+	}
+
+	benchmark::report_per_item("Dequeue and re-enqueue, 200 levels", benchmark::best_of(3, [&]() {
+		for (std::size_t i{ 0 }; i < operation_count; i++) {
+			queue->enqueue(*queue->dequeue(), next_level());
+		}
+	}), double(operation_count));
+
+	benchmark::report_per_item("Dequeue_fair and re-enqueue, 200 levels", benchmark::best_of(3, [&]() {
+		for (std::size_t i{ 0 }; i < operation_count; i++) {
+			queue->enqueue(*queue->dequeue_fair(), next_level());
+		}
+	}), double(operation_count));
+
+	queue->clear();
+}
@@ -0,0 +1,150 @@
+// MIT License
+
+// Copyright(c) 2021 Golden Rockefeller
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+// Traversals of a 16-node list by 1 to 8 reader threads, timed per
+// traversal, while a writer replaces one node every 10 us: with an
+// RcuNodeList and with a NodeList under a std::mutex. On one core this shows
+// the per-traversal overhead only; read scaling needs a multi-core machine.
+//
+// Build and run:
+//   g++ -std=c++17 -O2 -DNDEBUG -pthread benchmarks/rcu_node_list_benchmark.cpp -o rcu_node_list_benchmark && ./rcu_node_list_benchmark
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "../node_list.hpp"
+#include "../rcu_node_list.hpp"
+#include "benchmark.hpp"
+
+using namespace goldenrockefeller;
+
+static const int node_count{ 16 };
+static const int traversal_count{ 1 << 20 };
+
+// Runs read(traversals) on every reader thread, with write() called in the
+// background every 10 us, and returns the best time the readers took.
+template <typename Read, typename Write>
+double run_readers(int reader_count, Read read, Write write) {
+	return benchmark::best_of(3, [&]() {
+		std::atomic<bool> done{ false };
+		std::thread writer([&]() {
+			while (!done.load(std::memory_order_relaxed)) {
+				write();
+				std::this_thread::sleep_for(std::chrono::microseconds(10));
+			}
+		});
+
+		std::vector<std::thread> readers;
+		for (int reader{ 0 }; reader < reader_count; reader++) {
+			readers.emplace_back(read, traversal_count / reader_count);
+		}
+		for (std::thread& reader : readers) {
+			reader.join();
+		}
+
+		done.store(true, std::memory_order_relaxed);
+		writer.join();
+	});
+}
+
+static double run_rcu(int reader_count) {
+	using List = RcuNodeList<long>;
+
+	List list(static_cast<List::size_type>(reader_count));
+	for (int i{ 0 }; i < node_count; i++) {
+		list.push_back(*(new List::DataNode(i)));
+	}
+	long next_value{ node_count };
+
+	return run_readers(reader_count,
+		[&](int traversals) {
+			List::Reader reader(list);
+			long sum{ 0 };
+			for (int i{ 0 }; i < traversals; i++) {
+				std::lock_guard<List::Reader> guard(reader);
+				for (long value : list) {
+					sum += value;
+				}
+			}
+			benchmark::keep(sum);
+		},
+		[&]() {
+			list.remove_if([&](long value) { return value == next_value - node_count; });
+			list.push_back(*(new List::DataNode(next_value)));
+			next_value++;
+		}
+	);
+}
+
+static double run_mutex(int reader_count) {
+	using List = NodeList<long>;
+
+	std::mutex mutex;
+	List list;
+	std::unique_ptr<List::DataNode[]> nodes(new List::DataNode[node_count]);
+	for (int i{ 0 }; i < node_count; i++) {
+		nodes[i].data = i;
+		nodes[i].attach_to(list);
+	}
+	long next_value{ node_count };
+
+	double milliseconds = run_readers(reader_count,
+		[&](int traversals) {
+			long sum{ 0 };
+			for (int i{ 0 }; i < traversals; i++) {
+				std::lock_guard<std::mutex> guard(mutex);
+				for (long value : list) {
+					sum += value;
+				}
+			}
+			benchmark::keep(sum);
+		},
+		[&]() {
+			std::lock_guard<std::mutex> guard(mutex);
+			List::DataNode* node = list.front_node();
+			node->data = next_value;
+			node->attach_to(list);
+			next_value++;
+		}
+	);
+
+	list.clear();
+	return milliseconds;
+}
+
+int main() {
+	char name[80];
+
+	for (int reader_count : { 1, 2, 4, 8 }) {
+		std::snprintf(name, sizeof(name), "RcuNodeList, %d readers, per traversal", reader_count);
+		benchmark::report_per_item(name, run_rcu(reader_count), traversal_count);
+
+		std::snprintf(name, sizeof(name), "std::mutex + NodeList, %d readers, per traversal", reader_count);
+		benchmark::report_per_item(name, run_mutex(reader_count), traversal_count);
+	}
+}
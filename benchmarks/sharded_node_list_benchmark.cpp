@@ -0,0 +1,112 @@
+// MIT License
+
+// Copyright(c) 2021 Golden Rockefeller
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+// Attach/detach pairs by 1 to 64 threads, timed per operation, with a
+// ShardedNodeList of one shard per thread and with one SpinLock-protected
+// NodeList. On one core there is no contention on the list's tail to
+// remove, so this shows the bookkeeping overhead only; scaling needs a
+// multi-core machine.
+//
+// Build and run:
+//   g++ -std=c++17 -O2 -DNDEBUG -pthread benchmarks/sharded_node_list_benchmark.cpp -o sharded_node_list_benchmark && ./sharded_node_list_benchmark
+
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "../sharded_node_list.hpp"
+#include "benchmark.hpp"
+
+using namespace goldenrockefeller;
+
+using List = ShardedNodeList<long>;
+
+static const int nodes_per_thread{ 64 };
+static const int pair_count{ 1 << 21 };
+
+template <typename Work>
+double run_threads(int thread_count, Work work) {
+	return benchmark::best_of(3, [&]() {
+		std::vector<std::thread> threads;
+		for (int thread{ 0 }; thread < thread_count; thread++) {
+			threads.emplace_back(work);
+		}
+		for (std::thread& thread : threads) {
+			thread.join();
+		}
+	});
+}
+
+int main() {
+	char name[80];
+
+	for (int thread_count : { 1, 2, 8, 64 }) {
+		const int pairs_per_thread = pair_count / thread_count;
+
+		{
+			List list(static_cast<List::size_type>(thread_count));
+
+			std::snprintf(name, sizeof(name), "ShardedNodeList, %d threads, per attach or detach", thread_count);
+			benchmark::report_per_item(name, run_threads(thread_count, [&]() {
+				std::unique_ptr<List::DataNode[]> nodes(new List::DataNode[nodes_per_thread]);
+				for (int i{ 0 }; i < pairs_per_thread; i++) {
+					List::DataNode& node = nodes[i % nodes_per_thread];
+					list.attach(node);
+					if (i >= nodes_per_thread / 2) {
+						list.detach(nodes[(i - nodes_per_thread / 2) % nodes_per_thread]);
+					}
+				}
+				for (int i{ 0 }; i < nodes_per_thread; i++) {
+					list.detach(nodes[i]);
+				}
+			}), 2.0 * pair_count);
+		}
+
+		{
+			SpinLock lock;
+			List::list_type list;
+
+			std::snprintf(name, sizeof(name), "SpinLock + NodeList, %d threads, per attach or detach", thread_count);
+			benchmark::report_per_item(name, run_threads(thread_count, [&]() {
+				std::unique_ptr<List::list_type::DataNode[]> nodes(new List::list_type::DataNode[nodes_per_thread]);
+				for (int i{ 0 }; i < pairs_per_thread; i++) {
+					List::list_type::DataNode& node = nodes[i % nodes_per_thread];
+					{
+						std::lock_guard<SpinLock> guard(lock);
+						node.attach_to(list);
+					}
+					if (i >= nodes_per_thread / 2) {
+						std::lock_guard<SpinLock> guard(lock);
+						nodes[(i - nodes_per_thread / 2) % nodes_per_thread].detach();
+					}
+				}
+				std::lock_guard<SpinLock> guard(lock);
+				for (int i{ 0 }; i < nodes_per_thread; i++) {
+					nodes[i].detach();
+				}
+			}), 2.0 * pair_count);
+		}
+	}
+}
@@ -0,0 +1,121 @@
+// MIT License
+
+// Copyright(c) 2021 Golden Rockefeller
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+// Traversal of lists with 256 B to 4 KB payloads, with the payloads next to
+// the links (NodeList) and apart from them (SoaNodeList). Each list holds
+// 128 MB of payloads, linked in a shuffled order.
+//
+// Build and run:
+//   g++ -std=c++11 -O2 -DNDEBUG benchmarks/soa_node_list_benchmark.cpp -o soa_node_list_benchmark && ./soa_node_list_benchmark
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "../node_list.hpp"
+#include "../soa_node_list.hpp"
+#include "benchmark.hpp"
+
+using namespace goldenrockefeller;
+
+template <std::size_t Size>
+struct Payload {
+	std::uint64_t key;
+	unsigned char bytes[Size - sizeof(std::uint64_t)];
+};
+
+template <std::size_t Size>
+void run() {
+	const std::size_t count = (std::size_t{ 128 } << 20) / Size;
+
+	std::vector<std::size_t> order(count);
+	for (std::size_t i{ 0 }; i < count; i++) {
+		order[i] = i;
+	}
+	std::mt19937 random(1);
+	std::shuffle(order.begin(), order.end(), random);
+
+	char name[80];
+
+	{
+		using list_type = NodeList<Payload<Size>>;
+		list_type list;
+		std::unique_ptr<typename list_type::DataNode[]> nodes(new typename list_type::DataNode[count]);
+		for (std::size_t i : order) {
+			nodes[i].data.key = i;
+			nodes[i].attach_to(list);
+		}
+
+		std::snprintf(name, sizeof(name), "NodeList, %zu B payloads, walk links", Size);
+		benchmark::report_per_item(name, benchmark::best_of(3, [&]() {
+			benchmark::keep(list.size());
+		}), double(count));
+
+		std::snprintf(name, sizeof(name), "NodeList, %zu B payloads, sum keys", Size);
+		benchmark::report_per_item(name, benchmark::best_of(3, [&]() {
+			std::uint64_t sum{ 0 };
+			for (const Payload<Size>& payload : list) {
+				sum += payload.key;
+			}
+			benchmark::keep(sum);
+		}), double(count));
+	}
+
+	{
+		using list_type = SoaNodeList<Payload<Size>>;
+		list_type list;
+		list.reserve(count);
+		std::vector<typename list_type::DataNode> nodes;
+		nodes.reserve(count);
+		for (std::size_t i{ 0 }; i < count; i++) {
+			nodes.emplace_back(list);
+			nodes.back().data().key = i;
+		}
+		for (std::size_t i : order) {
+			nodes[i].attach_to(list);
+		}
+
+		std::snprintf(name, sizeof(name), "SoaNodeList, %zu B payloads, walk links", Size);
+		benchmark::report_per_item(name, benchmark::best_of(3, [&]() {
+			benchmark::keep(list.size());
+		}), double(count));
+
+		std::snprintf(name, sizeof(name), "SoaNodeList, %zu B payloads, sum keys", Size);
+		benchmark::report_per_item(name, benchmark::best_of(3, [&]() {
+			std::uint64_t sum{ 0 };
+			for (const Payload<Size>& payload : list) {
+				sum += payload.key;
+			}
+			benchmark::keep(sum);
+		}), double(count));
+	}
+}
+
+int main() {
+	run<256>();
+	run<1024>();
+	run<4096>();
+}
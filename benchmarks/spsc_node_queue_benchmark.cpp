@@ -0,0 +1,140 @@
+// MIT License
+
+// Copyright(c) 2021 Golden Rockefeller
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+// Ping-pong round trips between two threads through a pair of
+// SpscNodeQueues, reported as latency percentiles and messages/s, and
+// streaming throughput with batched dequeue. The waiting side yields, so on
+// one core the round trips measure context switches rather than the queue.
+//
+// Build and run:
+//   g++ -std=c++17 -O2 -DNDEBUG -pthread benchmarks/spsc_node_queue_benchmark.cpp -o spsc_node_queue_benchmark && ./spsc_node_queue_benchmark
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "../spsc_node_queue.hpp"
+#include "benchmark.hpp"
+
+using namespace goldenrockefeller;
+
+using Queue = SpscNodeQueue<long>;
+
+static void ping_pong() {
+	const int round_trip_count{ 200000 };
+
+	Queue ping(64);
+	Queue pong(64);
+	Queue::DataNode node(0);
+	std::vector<double> latencies(round_trip_count);
+
+	std::thread echo([&]() {
+		for (int i{ 0 }; i < round_trip_count; i++) {
+			Queue::DataNode* message;
+			while (!(message = ping.dequeue())) {
+				std::this_thread::yield();
+			}
+			message->data++;
+			pong.enqueue(*message);
+		}
+	});
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	for (int i{ 0 }; i < round_trip_count; i++) {
+		std::chrono::steady_clock::time_point sent = std::chrono::steady_clock::now();
+		ping.enqueue(node);
+		while (!pong.dequeue()) {
+			std::this_thread::yield();
+		}
+		std::chrono::duration<double, std::micro> latency = std::chrono::steady_clock::now() - sent;
+		latencies[i] = latency.count();
+	}
+	std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+	echo.join();
+
+	std::sort(latencies.begin(), latencies.end());
+	const char* names[] = { "Ping-pong round trip, p50", "Ping-pong round trip, p99", "Ping-pong round trip, p99.9" };
+	const double percentiles[] = { 50.0, 99.0, 99.9 };
+	for (int i{ 0 }; i < 3; i++) {
+		std::printf("%-56s %10.2f us\n", names[i], latencies[static_cast<std::size_t>(percentiles[i] / 100.0 * (round_trip_count - 1))]);
+	}
+	std::printf("%-56s %10.2f M/s\n", "Ping-pong messages", 2.0 * round_trip_count / elapsed.count() / 1e6);
+	benchmark::keep(node.data);
+}
+
+static void streaming() {
+	const int node_count{ 1024 };
+	const long message_count{ 1L << 24 };
+
+	std::unique_ptr<Queue::DataNode[]> nodes(new Queue::DataNode[node_count]);
+
+	double milliseconds = benchmark::best_of(3, [&]() {
+		Queue forward(node_count);
+		Queue backward(node_count);
+		for (int i{ 0 }; i < node_count; i++) {
+			backward.enqueue(nodes[i]);
+		}
+
+		std::thread consumer([&]() {
+			Queue::list_type batch;
+			long received{ 0 };
+			long sum{ 0 };
+			while (received < message_count) {
+				if (forward.dequeue_list(batch) == 0) {
+					std::this_thread::yield();
+					continue;
+				}
+				while (Queue::DataNode* node = batch.front_node()) {
+					node->detach();
+					sum += node->data;
+					received++;
+					backward.enqueue(*node);
+				}
+			}
+			benchmark::keep(sum);
+		});
+
+		for (long sent{ 0 }; sent < message_count; ) {
+			Queue::DataNode* node = backward.dequeue();
+			if (!node) {
+				std::this_thread::yield();
+				continue;
+			}
+			node->data = sent;
+			forward.enqueue(*node);
+			sent++;
+		}
+
+		consumer.join();
+	});
+
+	std::printf("%-56s %10.2f M/s\n", "Streaming, batched dequeue", message_count / milliseconds / 1e3);
+}
+
+int main() {
+	ping_pong();
+	streaming();
+}
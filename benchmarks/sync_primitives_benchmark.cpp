@@ -0,0 +1,72 @@
+// MIT License
+
+// Copyright(c) 2021 Golden Rockefeller
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+
+// Contended lock/unlock of FairMutex and std::mutex: 8 threads, 100k
+// critical sections each. On one core this mostly measures the cost of the
+// handoffs; a handoff latency figure needs a multi-core machine.
+//
+// Build and run:
+//   g++ -std=c++11 -O2 -DNDEBUG -pthread benchmarks/sync_primitives_benchmark.cpp -o sync_primitives_benchmark && ./sync_primitives_benchmark
+
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "../sync_primitives.hpp"
+#include "benchmark.hpp"
+
+using namespace goldenrockefeller;
+
+template <typename Mutex>
+void run(const char* name) {
+	const int thread_count{ 8 };
+	const int iteration_count{ 100000 };
+
+	Mutex mutex;
+	long counter{ 0 };
+
+	benchmark::report_per_item(name, benchmark::best_of(3, [&]() {
+		std::vector<std::thread> threads;
+		for (int thread{ 0 }; thread < thread_count; thread++) {
+			threads.emplace_back([&]() {
+				for (int i{ 0 }; i < iteration_count; i++) {
+					std::lock_guard<Mutex> guard(mutex);
+					counter++;
+				}
+			});
+		}
+		for (std::thread& thread : threads) {
+			thread.join();
+		}
+	}), double(thread_count) * iteration_count);
+
+	benchmark::keep(counter);
+}
+
+int main() {
+	run<FairMutex>("FairMutex, 8 threads x 100k lock/unlock");
+	run<std::mutex>("std::mutex, 8 threads x 100k lock/unlock");
+	run<SpinLock>("SpinLock, 8 threads x 100k lock/unlock");
+}
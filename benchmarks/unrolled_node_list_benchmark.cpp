@@ -0,0 +1,130 @@
+// MIT License
+
+// Copyright(c) 2021 Golden Rockefeller
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+// Iteration and the vectorized kernels of UnrolledNodeList against NodeList
+// and std::vector, over 16M int32_t values.
+//
+// Build and run:
+//   g++ -std=c++11 -O2 -DNDEBUG -march=native benchmarks/unrolled_node_list_benchmark.cpp -o unrolled_node_list_benchmark && ./unrolled_node_list_benchmark
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "../node_list.hpp"
+#include "../unrolled_node_list.hpp"
+#include "benchmark.hpp"
+
+using namespace goldenrockefeller;
+
+int main() {
+	const std::size_t count = std::size_t{ 1 } << 24;
+
+	std::vector<std::int32_t> values(count);
+	std::mt19937 random(1);
+	for (std::int32_t& value : values) {
+		value = std::int32_t(random() % 1000);
+	}
+
+	{
+		benchmark::report_per_item("std::vector, range-for sum", benchmark::best_of(3, [&]() {
+			std::int32_t sum{ 0 };
+			for (std::int32_t value : values) {
+				sum += value;
+			}
+			benchmark::keep(sum);
+		}), double(count));
+
+		benchmark::report_per_item("std::vector, std::count", benchmark::best_of(3, [&]() {
+			benchmark::keep(std::count(values.begin(), values.end(), 500));
+		}), double(count));
+	}
+
+	{
+		// Nodes are allocated one by one, as a list that grows over time would be.
+		NodeList<std::int32_t> list;
+		std::vector<std::unique_ptr<NodeList<std::int32_t>::DataNode>> nodes;
+		nodes.reserve(count);
+		for (std::int32_t value : values) {
+			nodes.emplace_back(new NodeList<std::int32_t>::DataNode(value));
+			nodes.back()->attach_to(list);
+		}
+
+		benchmark::report_per_item("NodeList, range-for sum", benchmark::best_of(3, [&]() {
+			std::int32_t sum{ 0 };
+			for (std::int32_t value : list) {
+				sum += value;
+			}
+			benchmark::keep(sum);
+		}), double(count));
+
+		benchmark::report_per_item("NodeList, std::count", benchmark::best_of(3, [&]() {
+			benchmark::keep(std::count(list.begin(), list.end(), 500));
+		}), double(count));
+	}
+
+	{
+		UnrolledNodeList<std::int32_t> list;
+		for (std::int32_t value : values) {
+			list.push_back(value);
+		}
+
+		benchmark::report_per_item("UnrolledNodeList, range-for sum", benchmark::best_of(3, [&]() {
+			std::int32_t sum{ 0 };
+			for (std::int32_t value : list) {
+				sum += value;
+			}
+			benchmark::keep(sum);
+		}), double(count));
+
+		benchmark::report_per_item("UnrolledNodeList, sum()", benchmark::best_of(3, [&]() {
+			benchmark::keep(list.sum());
+		}), double(count));
+
+		benchmark::report_per_item("UnrolledNodeList, count()", benchmark::best_of(3, [&]() {
+			benchmark::keep(list.count(500));
+		}), double(count));
+
+		benchmark::report_per_item("UnrolledNodeList, min()", benchmark::best_of(3, [&]() {
+			benchmark::keep(list.min());
+		}), double(count));
+
+		// Erases every other value, then refills, through iterators.
+		benchmark::report_per_item("UnrolledNodeList, erase and insert per value", benchmark::best_of(1, [&]() {
+			UnrolledNodeList<std::int32_t>::iterator it = list.begin();
+			while (it != list.end()) {
+				it = list.erase(it);
+				if (it != list.end()) {
+					++it;
+				}
+			}
+			for (it = list.begin(); it != list.end(); ++it) {
+				it = list.insert(it, 1);
+				++it;
+			}
+		}), double(count));
+	}
+}
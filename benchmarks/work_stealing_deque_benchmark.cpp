@@ -0,0 +1,223 @@
+// MIT License
+
+// Copyright(c) 2021 Golden Rockefeller
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+// Task throughput of a fork/join pool built on WorkStealingDeque: one deque
+// per worker, and a balanced binary tree of tasks in which every inner task
+// forks its right child onto the worker's deque and runs its left child
+// itself. Idle workers steal one task at a time, or half of a victim's
+// tasks with steal_half, which they run from a local NodeList. The tasks
+// are preallocated DataNodes, so forking never allocates.
+//
+// The workers run from 1 to the given count, by default the number of
+// hardware threads, doubling each time. On a single core extra workers only
+// add the cost of their failed steals.
+//
+// Build and run:
+//   g++ -std=c++17 -O2 -DNDEBUG -pthread benchmarks/work_stealing_deque_benchmark.cpp -o work_stealing_deque_benchmark && ./work_stealing_deque_benchmark [max_workers]
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "../work_stealing_deque.hpp"
+#include "benchmark.hpp"
+
+using namespace goldenrockefeller;
+
+using Deque = WorkStealingDeque<std::uint32_t>;
+using Task = Deque::DataNode;
+
+class TreeSum {
+	const std::uint32_t depth;
+	const std::uint32_t task_count;
+	const std::uint32_t first_leaf;
+	std::unique_ptr<Task[]> tasks;
+	std::unique_ptr<Deque[]> deques;
+	std::size_t worker_count;
+	bool steals_half;
+
+	std::atomic<std::uint32_t> run_count;
+	std::atomic<std::uint64_t> sum;
+
+	// A few dependent multiplications stand in for the work of a leaf.
+	static std::uint64_t leaf_work(std::uint32_t leaf) noexcept {
+		std::uint64_t value{ leaf };
+		for (int i{ 0 }; i < 16; i++) {
+			value = value * 6364136223846793005u + 1442695040888963407u;
+		}
+		return value >> 32;
+	}
+
+	// Runs the task and the left spine below it, forking the right children.
+	void run(Deque& deque, std::uint32_t task, std::uint32_t& runs, std::uint64_t& local_sum) {
+		while (task < this->first_leaf) {
+			std::uint32_t right = 2 * task + 2;
+			if (!deque.push(this->tasks[right])) {
+				this->run(deque, right, runs, local_sum);
+			}
+			runs++;
+			task = 2 * task + 1;
+		}
+
+		runs++;
+		local_sum += leaf_work(task - this->first_leaf);
+	}
+
+	void work(std::size_t worker) {
+		Deque& deque = this->deques[worker];
+		Deque::list_type stolen;
+		std::uint32_t runs{ 0 };
+		std::uint64_t local_sum{ 0 };
+		std::size_t victim{ worker };
+
+		if (worker == 0) {
+			this->run(deque, 0, runs, local_sum);
+		}
+
+		for (;;) {
+			Task* task = deque.pop();
+			if (!task && (task = stolen.front_node())) {
+				task->detach();
+			}
+
+			if (task) {
+				this->run(deque, task->data, runs, local_sum);
+				continue;
+			}
+
+			// Out of work: publish the count before looking for more, so
+			// that the pool is done exactly when every worker is idle.
+			if (runs) {
+				this->run_count.fetch_add(runs, std::memory_order_relaxed);
+				runs = 0;
+			}
+			if (this->run_count.load(std::memory_order_relaxed) == this->task_count) {
+				break;
+			}
+
+			bool has_stolen = false;
+			for (std::size_t attempt{ 1 }; attempt < this->worker_count && !has_stolen; attempt++) {
+				victim = (victim + 1) % this->worker_count;
+				if (victim == worker) {
+					continue;
+				}
+
+				if (this->steals_half) {
+					has_stolen = this->deques[victim].steal_half(stolen) > 0;
+				}
+				else if (Task* stolen_task = this->deques[victim].steal()) {
+					stolen_task->attach_to(stolen);
+					has_stolen = true;
+				}
+			}
+
+			if (!has_stolen) {
+				std::this_thread::yield();
+			}
+		}
+
+		this->sum.fetch_add(local_sum, std::memory_order_relaxed);
+	}
+
+public:
+	TreeSum(std::uint32_t depth, std::size_t max_worker_count) :
+		depth{ depth },
+		task_count{ (std::uint32_t{ 2 } << depth) - 1 },
+		first_leaf{ (std::uint32_t{ 1 } << depth) - 1 },
+		tasks{ new Task[(std::uint32_t{ 2 } << depth) - 1] },
+		deques{ new Deque[max_worker_count] },
+		worker_count{ 1 },
+		steals_half{ false },
+		run_count{ 0 },
+		sum{ 0 }
+	{
+		for (std::uint32_t i{ 0 }; i < this->task_count; i++) {
+			this->tasks[i].data = i;
+		}
+	};
+
+	std::uint32_t get_task_count() const noexcept {
+		return this->task_count;
+	}
+
+	std::uint64_t operator()(std::size_t worker_count, bool steals_half) {
+		this->worker_count = worker_count;
+		this->steals_half = steals_half;
+		this->run_count.store(0, std::memory_order_relaxed);
+		this->sum.store(0, std::memory_order_relaxed);
+
+		std::vector<std::thread> workers;
+		for (std::size_t worker{ 1 }; worker < worker_count; worker++) {
+			workers.emplace_back([this, worker]() { this->work(worker); });
+		}
+		this->work(0);
+		for (std::thread& worker : workers) {
+			worker.join();
+		}
+
+		return this->sum.load(std::memory_order_relaxed);
+	}
+};
+
+int main(int argc, char** argv) {
+	std::size_t max_worker_count = std::thread::hardware_concurrency();
+	if (argc > 1) {
+		max_worker_count = std::strtoul(argv[1], nullptr, 10);
+	}
+	if (max_worker_count == 0) {
+		max_worker_count = 1;
+	}
+
+	TreeSum tree_sum(20, max_worker_count);
+	const double task_count = tree_sum.get_task_count();
+	const std::uint64_t expected_sum = tree_sum(1, false);
+
+	for (std::size_t worker_count{ 1 }; worker_count <= max_worker_count; worker_count *= 2) {
+		for (int steals_half{ 0 }; steals_half < 2; steals_half++) {
+			std::uint64_t sum{ 0 };
+			double milliseconds = benchmark::best_of(3, [&]() {
+				sum = tree_sum(worker_count, steals_half != 0);
+			});
+			if (sum != expected_sum) {
+				std::fprintf(stderr, "Wrong sum with %zu workers.\n", worker_count);
+				return 1;
+			}
+
+			std::printf(
+				"Tree of %.0fM tasks, %2zu worker(s), %-10s %10.2f M tasks/s\n",
+				task_count / 1e6,
+				worker_count,
+				steals_half ? "steal_half" : "steal",
+				task_count / milliseconds / 1e3
+			);
+		}
+
+		if (worker_count < max_worker_count && 2 * worker_count > max_worker_count) {
+			worker_count = max_worker_count / 2;
+		}
+	}
+}
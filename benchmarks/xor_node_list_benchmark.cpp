@@ -0,0 +1,81 @@
+// MIT License
+
+// Copyright(c) 2021 Golden Rockefeller
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+
+// Traversal of 4M sequentially allocated nodes with a long payload, in an
+// XorNodeList (16 B nodes) and a NodeList (24 B nodes).
+//
+// Build and run:
+//   g++ -std=c++11 -O2 -DNDEBUG benchmarks/xor_node_list_benchmark.cpp -o xor_node_list_benchmark && ./xor_node_list_benchmark
+
+#include <cstdio>
+#include <memory>
+
+#include "../node_list.hpp"
+#include "../xor_node_list.hpp"
+#include "benchmark.hpp"
+
+using namespace goldenrockefeller;
+
+template <typename ListType>
+long sum_of(const ListType& list) {
+	long sum{ 0 };
+	for (long value : list) {
+		sum += value;
+	}
+	return sum;
+}
+
+int main() {
+	const std::size_t count{ std::size_t{ 1 } << 22 };
+
+	{
+		XorNodeList<long> list;
+		std::unique_ptr<XorNodeList<long>::DataNode[]> nodes(new XorNodeList<long>::DataNode[count]);
+		for (std::size_t i{ 0 }; i < count; i++) {
+			nodes[i].data = long(i);
+			list.push_back(nodes[i]);
+		}
+
+		benchmark::report("XorNodeList<long>, range-for over 4M nodes", benchmark::best_of(5, [&]() {
+			benchmark::keep(sum_of(list));
+		}));
+
+		list.clear();
+	}
+
+	{
+		NodeList<long> list;
+		std::unique_ptr<NodeList<long>::DataNode[]> nodes(new NodeList<long>::DataNode[count]);
+		for (std::size_t i{ 0 }; i < count; i++) {
+			nodes[i].data = long(i);
+			nodes[i].attach_to(list);
+		}
+
+		benchmark::report("NodeList<long>, range-for over 4M nodes", benchmark::best_of(5, [&]() {
+			benchmark::keep(sum_of(list));
+		}));
+
+		list.clear();
+	}
+}
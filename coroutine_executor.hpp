@@ -0,0 +1,456 @@
+// MIT License
+
+// Copyright(c) 2021 Golden Rockefeller
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef GOLDENROCKEFELLER_COROUTINE_EXECUTOR_HPP
+#define GOLDENROCKEFELLER_COROUTINE_EXECUTOR_HPP
+
+#include "sync_primitives.hpp"
+
+// The executors need C++20 coroutines; without them this header is empty.
+#if defined(GOLDENROCKEFELLER_HAS_COROUTINES)
+
+#include <stdexcept>
+#include <chrono>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "node_list.hpp"
+
+namespace goldenrockefeller {
+
+// The scheduling state of a task: the coroutine to resume and, while the
+// task sleeps, when to resume it.
+struct ScheduledTask {
+	std::coroutine_handle<> coroutine;
+	std::chrono::steady_clock::time_point deadline;
+};
+
+using ScheduledTaskList = NodeList<ScheduledTask>;
+
+// A fire-and-forget coroutine for the executors. Its promise embeds the
+// DataNode that links the task into an executor's ready or sleeping list, so
+// scheduling a task is one attach and never allocates. The task starts
+// suspended and runs once spawned; its frame is destroyed when it finishes.
+// An exception escaping a task terminates the program, as it would for a
+// std::thread.
+class Task {
+public:
+	class promise_type {
+	public:
+		ScheduledTaskList::DataNode hook;
+
+		Task get_return_object() noexcept {
+			auto coroutine = std::coroutine_handle<promise_type>::from_promise(*this);
+			this->hook.data.coroutine = coroutine;
+			return Task(coroutine);
+		};
+
+		std::suspend_always initial_suspend() noexcept {
+			return {};
+		};
+
+		std::suspend_never final_suspend() noexcept {
+			return {};
+		};
+
+		void return_void() noexcept {};
+
+		void unhandled_exception() noexcept {
+			std::terminate();
+		};
+	};
+
+private:
+	std::coroutine_handle<promise_type> coroutine;
+
+	explicit Task(std::coroutine_handle<promise_type> coroutine) noexcept : coroutine(coroutine) {};
+
+public:
+	Task(const Task& obj) = delete;
+	Task& operator=(const Task& obj) = delete;
+
+	Task(Task&& obj) noexcept : coroutine{ std::exchange(obj.coroutine, nullptr) } {};
+
+	Task& operator=(Task&& obj) noexcept {
+		if (this != &obj) {
+			if (this->coroutine) {
+				this->coroutine.destroy();
+			}
+			this->coroutine = std::exchange(obj.coroutine, nullptr);
+		}
+		return *this;
+	};
+
+	// A task that was never spawned is destroyed with its handle.
+	~Task() {
+		if (this->coroutine) {
+			this->coroutine.destroy();
+		}
+	};
+
+	// Gives up ownership of the frame, which then destroys itself when the
+	// coroutine finishes.
+	ScheduledTaskList::DataNode& release() {
+		if (!this->coroutine) {
+			throw std::runtime_error("The task has already been spawned.");
+		}
+		return std::exchange(this->coroutine, nullptr).promise().hook;
+	};
+};
+
+// co_await executor.yield() reschedules the task at the back of the ready
+// list.
+template <typename Executor>
+class YieldAwaiter {
+	Executor& executor;
+
+public:
+	explicit YieldAwaiter(Executor& executor) noexcept : executor(executor) {};
+
+	bool await_ready() const noexcept {
+		return false;
+	};
+
+	void await_suspend(std::coroutine_handle<Task::promise_type> coroutine) {
+		this->executor.schedule(coroutine.promise().hook);
+	};
+
+	void await_resume() const noexcept {};
+};
+
+// co_await executor.sleep_for(duration) parks the task in the executor's
+// sleeping list until the deadline passes.
+template <typename Executor>
+class SleepAwaiter {
+	Executor& executor;
+	std::chrono::steady_clock::time_point deadline;
+
+public:
+	SleepAwaiter(Executor& executor, std::chrono::steady_clock::time_point deadline) noexcept :
+		executor(executor), deadline(deadline) {};
+
+	bool await_ready() const noexcept {
+		return false;
+	};
+
+	void await_suspend(std::coroutine_handle<Task::promise_type> coroutine) {
+		this->executor.schedule_at(coroutine.promise().hook, this->deadline);
+	};
+
+	void await_resume() const noexcept {};
+};
+
+// Attaches the hook to a list kept sorted by deadline. Most sleeps are of
+// similar lengths, so the search starts from the back.
+inline void attach_by_deadline(ScheduledTaskList& list, ScheduledTaskList::DataNode& hook) {
+	ScheduledTaskList::iterator position = list.end();
+	ScheduledTaskList::iterator begin = list.begin();
+
+	while (position != begin) {
+		ScheduledTaskList::iterator prev_position = position;
+		--prev_position;
+		if (prev_position->deadline <= hook.data.deadline) {
+			break;
+		}
+		position = prev_position;
+	}
+
+	position.attach_node_before(hook);
+}
+
+// Moves the sleeping tasks whose deadline has passed to the back of the
+// ready list, in deadline order.
+inline void wake_expired(ScheduledTaskList& sleeping, ScheduledTaskList& ready, std::chrono::steady_clock::time_point now) {
+	while (ScheduledTaskList::DataNode* hook = sleeping.front_node()) {
+		if (hook->data.deadline > now) {
+			break;
+		}
+		hook->attach_to(ready);
+	}
+}
+
+// Resumes every task of the batch in order. Tasks that yield while the
+// batch runs go to the executor's ready list and wait for the next batch.
+inline void resume_batch(ScheduledTaskList& batch) {
+	while (ScheduledTaskList::DataNode* hook = batch.front_node()) {
+		hook->detach();
+		hook->data.coroutine.resume();
+	}
+}
+
+// Destroys the frames of the tasks that are still scheduled.
+inline void destroy_tasks(ScheduledTaskList& list) noexcept {
+	while (ScheduledTaskList::DataNode* hook = list.front_node()) {
+		hook->detach();
+		hook->data.coroutine.destroy();
+	}
+}
+
+// An executor that runs tasks on the thread that calls run(). Each round
+// splices the whole ready list into a batch in O(1) and then resumes the
+// batch, so tasks scheduled during a round run in the next one.
+class SingleThreadExecutor {
+	ScheduledTaskList ready;
+	ScheduledTaskList sleeping;
+
+public:
+	SingleThreadExecutor() noexcept : ready{}, sleeping{} {};
+
+	SingleThreadExecutor(const SingleThreadExecutor& obj) = delete;
+	SingleThreadExecutor& operator=(const SingleThreadExecutor& obj) = delete;
+
+	// Tasks that never got to finish are destroyed with the executor.
+	~SingleThreadExecutor() {
+		destroy_tasks(this->ready);
+		destroy_tasks(this->sleeping);
+	};
+
+	void schedule(ScheduledTaskList::DataNode& hook) {
+		hook.attach_to(this->ready);
+	};
+
+	void schedule_at(ScheduledTaskList::DataNode& hook, std::chrono::steady_clock::time_point deadline) {
+		hook.data.deadline = deadline;
+		attach_by_deadline(this->sleeping, hook);
+	};
+
+	void spawn(Task task) {
+		this->schedule(task.release());
+	};
+
+	YieldAwaiter<SingleThreadExecutor> yield() noexcept {
+		return YieldAwaiter<SingleThreadExecutor>(*this);
+	};
+
+	template <typename Rep, typename Period>
+	SleepAwaiter<SingleThreadExecutor> sleep_for(const std::chrono::duration<Rep, Period>& duration) noexcept {
+		return SleepAwaiter<SingleThreadExecutor>(
+			*this,
+			std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(duration)
+		);
+	};
+
+	// Runs one round: wakes the expired sleepers and resumes every task that
+	// was ready. Returns false if there was nothing to resume.
+	bool run_once() {
+		if (!this->sleeping.is_empty()) {
+			wake_expired(this->sleeping, this->ready, std::chrono::steady_clock::now());
+		}
+		if (this->ready.is_empty()) {
+			return false;
+		}
+
+		ScheduledTaskList batch;
+		batch = std::move(this->ready);
+		resume_batch(batch);
+		return true;
+	};
+
+	// Runs until no task is ready or sleeping, blocking the thread while
+	// only sleeping tasks remain. Tasks suspended on other awaitables do not
+	// keep run() going.
+	void run() {
+		for (;;) {
+			if (this->run_once()) {
+				continue;
+			}
+			ScheduledTaskList::DataNode* next_sleeper = this->sleeping.front_node();
+			if (!next_sleeper) {
+				return;
+			}
+			std::this_thread::sleep_until(next_sleeper->data.deadline);
+		}
+	};
+};
+
+// An executor whose worker threads share one ready list. A worker takes up
+// to batch_size tasks at a time under the lock, then resumes them without
+// it, so the lock is taken once per batch rather than once per task.
+class ThreadPoolExecutor {
+public:
+	using size_type = std::size_t;
+
+private:
+	std::mutex mutex;
+	ConditionVariable work_available;
+	ConditionVariable drained;
+	ScheduledTaskList ready;
+	ScheduledTaskList sleeping;
+	size_type batch_size;
+	size_type busy_workers;
+	bool stopping;
+	std::vector<std::thread> workers;
+
+	bool is_idle() const noexcept {
+		return this->ready.is_empty() && this->sleeping.is_empty() && this->busy_workers == 0;
+	}
+
+	void work() {
+		ScheduledTaskList batch;
+		std::unique_lock<std::mutex> lock(this->mutex);
+
+		for (;;) {
+			if (!this->sleeping.is_empty()) {
+				wake_expired(this->sleeping, this->ready, std::chrono::steady_clock::now());
+			}
+
+			if (!this->ready.is_empty()) {
+				for (size_type i{ 0 }; i < this->batch_size; i++) {
+					ScheduledTaskList::DataNode* hook = this->ready.front_node();
+					if (!hook) {
+						break;
+					}
+					hook->attach_to(batch);
+				}
+				bool more_work = !this->ready.is_empty();
+				this->busy_workers++;
+				lock.unlock();
+
+				if (more_work) {
+					this->work_available.notify_one();
+				}
+				resume_batch(batch);
+
+				lock.lock();
+				this->busy_workers--;
+				if (this->is_idle()) {
+					this->drained.notify_all();
+				}
+				continue;
+			}
+
+			if (this->stopping) {
+				return;
+			}
+
+			ScheduledTaskList::DataNode* next_sleeper = this->sleeping.front_node();
+			if (next_sleeper) {
+				// Copy the deadline: another worker may run and finish the
+				// sleeper while this one waits.
+				std::chrono::steady_clock::time_point deadline = next_sleeper->data.deadline;
+				this->work_available.wait_until(lock, deadline);
+			}
+			else {
+				this->work_available.wait(lock);
+			}
+		}
+	}
+
+public:
+	explicit ThreadPoolExecutor(size_type thread_count = std::thread::hardware_concurrency(), size_type batch_size = 64) :
+		mutex{},
+		work_available{},
+		drained{},
+		ready{},
+		sleeping{},
+		batch_size{ batch_size },
+		busy_workers{ 0 },
+		stopping{ false },
+		workers{}
+	{
+		if (batch_size == 0) {
+			throw std::invalid_argument("The batch size must not be zero.");
+		}
+		if (thread_count == 0) {
+			thread_count = 1;
+		}
+
+		this->workers.reserve(thread_count);
+		for (size_type i{ 0 }; i < thread_count; i++) {
+			this->workers.emplace_back([this] { this->work(); });
+		}
+	};
+
+	ThreadPoolExecutor(const ThreadPoolExecutor& obj) = delete;
+	ThreadPoolExecutor& operator=(const ThreadPoolExecutor& obj) = delete;
+
+	// The workers finish the ready tasks and stop; sleeping tasks are
+	// destroyed without being resumed.
+	~ThreadPoolExecutor() {
+		{
+			std::lock_guard<std::mutex> lock(this->mutex);
+			this->stopping = true;
+		}
+		this->work_available.notify_all();
+
+		for (std::thread& worker : this->workers) {
+			worker.join();
+		}
+
+		destroy_tasks(this->ready);
+		destroy_tasks(this->sleeping);
+	};
+
+	size_type thread_count() const noexcept {
+		return this->workers.size();
+	};
+
+	void schedule(ScheduledTaskList::DataNode& hook) {
+		{
+			std::lock_guard<std::mutex> lock(this->mutex);
+			hook.attach_to(this->ready);
+		}
+		this->work_available.notify_one();
+	};
+
+	void schedule_at(ScheduledTaskList::DataNode& hook, std::chrono::steady_clock::time_point deadline) {
+		hook.data.deadline = deadline;
+		{
+			std::lock_guard<std::mutex> lock(this->mutex);
+			attach_by_deadline(this->sleeping, hook);
+		}
+		// A waiting worker may need to wake up earlier for this deadline.
+		this->work_available.notify_one();
+	};
+
+	void spawn(Task task) {
+		this->schedule(task.release());
+	};
+
+	YieldAwaiter<ThreadPoolExecutor> yield() noexcept {
+		return YieldAwaiter<ThreadPoolExecutor>(*this);
+	};
+
+	template <typename Rep, typename Period>
+	SleepAwaiter<ThreadPoolExecutor> sleep_for(const std::chrono::duration<Rep, Period>& duration) noexcept {
+		return SleepAwaiter<ThreadPoolExecutor>(
+			*this,
+			std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(duration)
+		);
+	};
+
+	// Blocks until no task is ready, sleeping or running. Tasks suspended on
+	// other awaitables are not waited for.
+	void wait_idle() {
+		std::unique_lock<std::mutex> lock(this->mutex);
+		this->drained.wait(lock, [this] { return this->is_idle(); });
+	};
+};
+
+} // namespace goldenrockefeller
+
+#endif
+
+#endif
@@ -0,0 +1,278 @@
+// MIT License
+
+// Copyright(c) 2021 Golden Rockefeller
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef GOLDENROCKEFELLER_FLAT_COMBINING_NODE_LIST_HPP
+#define GOLDENROCKEFELLER_FLAT_COMBINING_NODE_LIST_HPP
+
+#include <stdexcept>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <cstdint>
+
+#include "node_list.hpp"
+#include "sync_primitives.hpp"
+
+#if !defined(__cpp_aligned_new)
+#error "FlatCombiningNodeList needs C++17 aligned new for its cache-line-aligned slots."
+#endif
+
+namespace goldenrockefeller {
+
+// A NodeList shared between threads through flat combining (Hendler, Incze,
+// Shavit and Tzafrir, SPAA 2010). Each thread publishes its operation in its
+// own slot; whichever thread wins the combiner lock applies every pending
+// operation in one pass over the slots, while the others wait on their own
+// slot. The list's sentinels and links then stay in the combiner's cache
+// instead of bouncing between cores with a mutex.
+//
+// Threads reach the list through a Handle, which claims one of the slots
+// allocated at construction. Every operation is O(1).
+template <typename T>
+class FlatCombiningNodeList {
+
+public:
+	using list_type = NodeList<T>;
+	using DataNode = typename list_type::DataNode;
+	using size_type = std::size_t;
+
+	static constexpr size_type cache_line_size = 64;
+
+private:
+	using operation_type = std::uint32_t;
+
+	static constexpr operation_type no_operation = 0;
+	static constexpr operation_type push_back_operation = 1;
+	static constexpr operation_type push_front_operation = 2;
+	static constexpr operation_type detach_operation = 3;
+	static constexpr operation_type pop_front_operation = 4;
+	static constexpr operation_type pop_back_operation = 5;
+
+	// A combiner keeps scanning while it finds work, up to this many passes,
+	// so that requests published during a pass are picked up cheaply.
+	static constexpr unsigned max_combining_passes = 4;
+
+	struct alignas(cache_line_size) Slot {
+		std::atomic<operation_type> operation;
+		ClaimFlag is_claimed;
+		DataNode* node;
+
+		Slot() noexcept : operation{ no_operation }, is_claimed{}, node{ nullptr } {};
+	};
+
+	list_type list;
+
+	std::unique_ptr<Slot[]> slots;
+	size_type slot_count;
+
+	alignas(cache_line_size) std::atomic<bool> is_combining;
+
+	// Applies the slot's operation. Every operation is noexcept on a valid
+	// request: pushed nodes are detached from any other list first.
+	void apply(Slot& slot, operation_type operation) noexcept {
+		switch (operation) {
+		case push_back_operation:
+			slot.node->attach_to(this->list);
+			break;
+		case push_front_operation:
+			if (DataNode* front_node = this->list.front_node()) {
+				// Attaching a node before itself would leave it detached.
+				if (front_node != slot.node) {
+					slot.node->attach_before(front_node);
+				}
+			}
+			else {
+				slot.node->attach_to(this->list);
+			}
+			break;
+		case detach_operation:
+			slot.node->detach();
+			break;
+		case pop_front_operation:
+			slot.node = this->list.front_node();
+			if (slot.node) {
+				slot.node->detach();
+			}
+			break;
+		case pop_back_operation:
+			slot.node = this->list.back_node();
+			if (slot.node) {
+				slot.node->detach();
+			}
+			break;
+		default:
+			break;
+		}
+	}
+
+	void combine() noexcept {
+		for (unsigned pass{ 0 }; pass < max_combining_passes; pass++) {
+			bool found_work = false;
+
+			for (size_type i{ 0 }; i < this->slot_count; i++) {
+				Slot& slot = this->slots[i];
+				operation_type operation = slot.operation.load(std::memory_order_acquire);
+
+				if (operation != no_operation) {
+					this->apply(slot, operation);
+					slot.operation.store(no_operation, std::memory_order_release);
+					found_work = true;
+				}
+			}
+
+			if (!found_work) {
+				break;
+			}
+		}
+	}
+
+	// Publishes the operation and waits until some combiner, possibly this
+	// thread, has applied it. Returns the slot's node.
+	DataNode* execute(Slot& slot, operation_type operation, DataNode* node) noexcept {
+		slot.node = node;
+		slot.operation.store(operation, std::memory_order_release);
+
+		unsigned spins{ 0 };
+
+		for (;;) {
+			if (
+				!this->is_combining.load(std::memory_order_relaxed)
+				&& !this->is_combining.exchange(true, std::memory_order_acquire)
+			) {
+				this->combine();
+				this->is_combining.store(false, std::memory_order_release);
+			}
+
+			if (slot.operation.load(std::memory_order_acquire) == no_operation) {
+				return slot.node;
+			}
+
+			if (++spins > 64) {
+				std::this_thread::yield();
+			}
+		}
+	}
+
+public:
+	// A thread's access to the list. A handle claims one slot for its
+	// lifetime and must only be used by one thread at a time.
+	class Handle {
+		FlatCombiningNodeList& owner;
+		Slot* slot;
+
+	public:
+		// Throws std::length_error if every slot is claimed.
+		explicit Handle(FlatCombiningNodeList& owner) :
+			owner(owner),
+			slot{ &claim_first_slot(owner.slots.get(), owner.slot_count, "Every slot of the flat-combining list is claimed.") }
+		{};
+
+		~Handle() {
+			this->slot->is_claimed.release();
+		};
+
+		Handle(const Handle& obj) = delete;
+		Handle(Handle&& obj) = delete;
+		Handle& operator=(const Handle& obj) = delete;
+		Handle& operator=(Handle&& obj) = delete;
+
+		// Attaches the node to the back of the list, detaching it from any
+		// list it is attached to.
+		void push_back(DataNode& node) noexcept {
+			this->owner.execute(*(this->slot), push_back_operation, &node);
+		};
+
+		void push_front(DataNode& node) noexcept {
+			this->owner.execute(*(this->slot), push_front_operation, &node);
+		};
+
+		// Detaches a node of this list.
+		void detach(DataNode& node) noexcept {
+			this->owner.execute(*(this->slot), detach_operation, &node);
+		};
+
+		// Detaches and returns the front node, or returns null if the list
+		// is empty.
+		DataNode* pop_front() noexcept {
+			return this->owner.execute(*(this->slot), pop_front_operation, nullptr);
+		};
+
+		DataNode* pop_back() noexcept {
+			return this->owner.execute(*(this->slot), pop_back_operation, nullptr);
+		};
+	};
+
+	explicit FlatCombiningNodeList(size_type slot_count = 64) :
+		list{},
+		slots{},
+		slot_count{ slot_count },
+		is_combining{ false }
+	{
+		if (slot_count == 0) {
+			throw std::invalid_argument("The slot count must not be zero.");
+		}
+
+		this->slots.reset(new Slot[slot_count]);
+	};
+
+	FlatCombiningNodeList(const FlatCombiningNodeList& obj) = delete;
+	FlatCombiningNodeList(FlatCombiningNodeList&& obj) = delete;
+	FlatCombiningNodeList& operator=(const FlatCombiningNodeList& obj) = delete;
+	FlatCombiningNodeList& operator=(FlatCombiningNodeList&& obj) = delete;
+
+	size_type max_handle_count() const noexcept {
+		return this->slot_count;
+	};
+
+	// The underlying list, for use only while no handle is operating on it.
+	list_type& unsynchronized_list() noexcept {
+		return this->list;
+	};
+};
+
+template <typename T>
+constexpr typename FlatCombiningNodeList<T>::size_type FlatCombiningNodeList<T>::cache_line_size;
+
+template <typename T>
+constexpr typename FlatCombiningNodeList<T>::operation_type FlatCombiningNodeList<T>::no_operation;
+
+template <typename T>
+constexpr typename FlatCombiningNodeList<T>::operation_type FlatCombiningNodeList<T>::push_back_operation;
+
+template <typename T>
+constexpr typename FlatCombiningNodeList<T>::operation_type FlatCombiningNodeList<T>::push_front_operation;
+
+template <typename T>
+constexpr typename FlatCombiningNodeList<T>::operation_type FlatCombiningNodeList<T>::detach_operation;
+
+template <typename T>
+constexpr typename FlatCombiningNodeList<T>::operation_type FlatCombiningNodeList<T>::pop_front_operation;
+
+template <typename T>
+constexpr typename FlatCombiningNodeList<T>::operation_type FlatCombiningNodeList<T>::pop_back_operation;
+
+template <typename T>
+constexpr unsigned FlatCombiningNodeList<T>::max_combining_passes;
+
+} // namespace goldenrockefeller
+
+#endif
@@ -0,0 +1,250 @@
+// MIT License
+
+// Copyright(c) 2021 Golden Rockefeller
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef GOLDENROCKEFELLER_LOCK_FREE_NODE_STACK_HPP
+#define GOLDENROCKEFELLER_LOCK_FREE_NODE_STACK_HPP
+
+#include <stdexcept>
+#include <atomic>
+#include <cstdint>
+
+#include "node_list.hpp"
+
+#if defined(__SANITIZE_THREAD__)
+#define GOLDENROCKEFELLER_NO_SANITIZE_THREAD __attribute__((no_sanitize_thread))
+#elif defined(__has_feature)
+#if __has_feature(thread_sanitizer)
+#define GOLDENROCKEFELLER_NO_SANITIZE_THREAD __attribute__((no_sanitize("thread")))
+#endif
+#endif
+#if !defined(GOLDENROCKEFELLER_NO_SANITIZE_THREAD)
+#define GOLDENROCKEFELLER_NO_SANITIZE_THREAD
+#endif
+
+#if !defined(__cpp_aligned_new)
+#error "LockFreeNodeStack needs C++17 aligned new for its cache-line-aligned head."
+#endif
+
+namespace goldenrockefeller {
+
+// A lock-free Treiber stack of detached DataNodes, for free lists shared
+// between threads. The stack threads its nodes through their own next_node
+// links, so pushing and popping never allocate and cost one CAS each.
+//
+// The head is one 64-bit word holding the top node's address and a counter
+// that every successful CAS increments, which protects pop against ABA
+// without a double-width CAS. On 64-bit targets the address takes the low 48
+// bits and the counter the high 16; on 32-bit targets each takes 32 bits.
+//
+// A popping thread may read the next link of a node that another thread has
+// just popped, so the memory of popped nodes must stay valid while other
+// threads can still be popping, as it does in a free list. A node must not
+// be attached to a list, or destructed, while it is on the stack.
+template <typename T>
+class LockFreeNodeStack {
+
+public:
+	using list_type = NodeList<T>;
+	using DataNode = typename list_type::DataNode;
+	using size_type = std::size_t;
+
+	static constexpr size_type cache_line_size = 64;
+
+private:
+	using Node = typename list_type::Node;
+	using word_type = std::uint64_t;
+
+	static constexpr unsigned address_bits = sizeof(void*) >= 8 ? 48 : 32;
+	static constexpr word_type address_mask = (word_type{ 1 } << address_bits) - 1;
+
+	alignas(cache_line_size) std::atomic<word_type> head;
+
+	static DataNode* top_of(word_type head) noexcept {
+		return reinterpret_cast<DataNode*>(static_cast<std::uintptr_t>(head & address_mask));
+	}
+
+	// The head that replaces the given one, with its counter incremented.
+	static word_type successor_of(word_type head, DataNode* top) noexcept {
+		return (((head >> address_bits) + 1) << address_bits) | static_cast<word_type>(reinterpret_cast<std::uintptr_t>(top));
+	}
+
+	// The links of stacked nodes can be read by one thread while another
+	// writes them, so they are accessed atomically where the compiler allows.
+	//
+	// A pop that loses its CAS may have read the link of a node that the
+	// winner already relinked through NodeList, which writes the link
+	// non-atomically. The CAS then discards the value it read, so the race is
+	// deliberate and this read is left out of ThreadSanitizer's checks.
+	GOLDENROCKEFELLER_NO_SANITIZE_THREAD
+	static DataNode* load_next(DataNode* node) noexcept {
+		Node* base = static_cast<Node*>(node);
+#if defined(__GNUC__) || defined(__clang__)
+		return reinterpret_cast<DataNode*>(__atomic_load_n(&(base->next_node), __ATOMIC_RELAXED));
+#else
+		return reinterpret_cast<DataNode*>(base->next_node);
+#endif
+	}
+
+	static void store_next(DataNode* node, DataNode* next) noexcept {
+		Node* base = static_cast<Node*>(node);
+		Node* next_base = next ? static_cast<Node*>(next) : nullptr;
+#if defined(__GNUC__) || defined(__clang__)
+		__atomic_store_n(&(base->next_node), next_base, __ATOMIC_RELAXED);
+#else
+		base->next_node = next_base;
+#endif
+	}
+
+	static void check_pushable(DataNode& node) {
+		Node& base = static_cast<Node&>(node);
+
+		if (base.next_node || base.prev_node) {
+			throw std::invalid_argument("The node must be detached.");
+		}
+		if (static_cast<word_type>(reinterpret_cast<std::uintptr_t>(&node)) & ~address_mask) {
+			throw std::invalid_argument("The node's address does not fit in the stack's head.");
+		}
+	}
+
+	// Links the chain from first to last on top of the stack with one CAS.
+	void push_chain(DataNode* first, DataNode* last) noexcept {
+		word_type old_head = this->head.load(std::memory_order_relaxed);
+
+		do {
+			store_next(last, top_of(old_head));
+		} while (!this->head.compare_exchange_weak(
+			old_head,
+			successor_of(old_head, first),
+			std::memory_order_release,
+			std::memory_order_relaxed
+		));
+	}
+
+public:
+	LockFreeNodeStack() noexcept : head{ 0 } {};
+
+	LockFreeNodeStack(const LockFreeNodeStack& obj) = delete;
+	LockFreeNodeStack(LockFreeNodeStack&& obj) = delete;
+	LockFreeNodeStack& operator=(const LockFreeNodeStack& obj) = delete;
+	LockFreeNodeStack& operator=(LockFreeNodeStack&& obj) = delete;
+
+	// A snapshot; exact only when no other thread is using the stack.
+	bool is_empty_estimate() const noexcept {
+		return !top_of(this->head.load(std::memory_order_relaxed));
+	};
+
+	// Pushes a detached node.
+	void push(DataNode& node) {
+		check_pushable(node);
+		this->push_chain(&node, &node);
+	};
+
+	// Moves every node of the list onto the stack with one CAS. The front of
+	// the list becomes the top of the stack.
+	void push_list(list_type& list) {
+		for (Node* node = list.before_start_node.next(); node != &(list.past_end_node); node = node->next()) {
+			if (static_cast<word_type>(reinterpret_cast<std::uintptr_t>(node)) & ~address_mask) {
+				throw std::invalid_argument("The node's address does not fit in the stack's head.");
+			}
+		}
+
+		DataNode* first = nullptr;
+		DataNode* last = nullptr;
+
+		while (DataNode* node = list.back_node()) {
+			node->detach();
+			store_next(node, first);
+			first = node;
+			if (!last) {
+				last = node;
+			}
+		}
+
+		if (first) {
+			this->push_chain(first, last);
+		}
+	};
+
+	// Pops the most recently pushed node, or returns null if the stack is
+	// empty. The returned node is detached.
+	DataNode* pop() noexcept {
+		word_type old_head = this->head.load(std::memory_order_acquire);
+
+		for (;;) {
+			DataNode* top = top_of(old_head);
+			if (!top) {
+				return nullptr;
+			}
+
+			DataNode* next = load_next(top);
+
+			if (this->head.compare_exchange_weak(
+				old_head,
+				successor_of(old_head, next),
+				std::memory_order_acquire,
+				std::memory_order_acquire
+			)) {
+				store_next(top, nullptr);
+				return top;
+			}
+		}
+	};
+
+	// Takes every node off the stack with one successful CAS and returns
+	// them as a list, top first.
+	list_type pop_all() {
+		word_type old_head = this->head.load(std::memory_order_acquire);
+
+		while (top_of(old_head) && !this->head.compare_exchange_weak(
+			old_head,
+			successor_of(old_head, nullptr),
+			std::memory_order_acquire,
+			std::memory_order_acquire
+		)) {
+		}
+
+		list_type list;
+		DataNode* node = top_of(old_head);
+
+		while (node) {
+			DataNode* next = load_next(node);
+			store_next(node, nullptr);
+			node->attach_to(list);
+			node = next;
+		}
+
+		return list;
+	};
+};
+
+template <typename T>
+constexpr typename LockFreeNodeStack<T>::size_type LockFreeNodeStack<T>::cache_line_size;
+
+template <typename T>
+constexpr unsigned LockFreeNodeStack<T>::address_bits;
+
+template <typename T>
+constexpr typename LockFreeNodeStack<T>::word_type LockFreeNodeStack<T>::address_mask;
+
+} // namespace goldenrockefeller
+
+#endif
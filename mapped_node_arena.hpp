@@ -0,0 +1,258 @@
+// MIT License
+
+// Copyright(c) 2021 Golden Rockefeller
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef GOLDENROCKEFELLER_MAPPED_NODE_ARENA_HPP
+#define GOLDENROCKEFELLER_MAPPED_NODE_ARENA_HPP
+
+#include <stdexcept>
+#include <new>
+#include <utility>
+#include <cstdint>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#include <unistd.h>
+#define GOLDENROCKEFELLER_HAS_MMAP
+#endif
+
+#include "node_list.hpp"
+
+namespace goldenrockefeller {
+
+// How a MappedNodeArena asks for huge pages.
+enum class HugePages {
+	// Normal pages only.
+	none,
+	// Transparent huge pages, through madvise(MADV_HUGEPAGE) on a range
+	// aligned to the huge page size.
+	transparent,
+	// Pages from the hugetlbfs pool, through MAP_HUGETLB, falling back to
+	// transparent huge pages if the pool cannot cover the arena.
+	explicit_pool
+};
+
+// A bump allocator of DataNodes over one large anonymous mapping, for lists
+// big enough that TLB misses matter. Nodes are handed out in address order,
+// so a list built in allocation order is traversed sequentially, and with
+// huge pages each TLB entry covers thousands of nodes.
+//
+// The whole range is reserved at construction and can optionally be
+// prefaulted, so that allocation never page-faults later. Nodes are never
+// freed one at a time; the arena destructs every node it handed out when it
+// is destructed itself. Without mmap, the arena falls back to operator new.
+template <typename T>
+class MappedNodeArena {
+
+public:
+	using list_type = NodeList<T>;
+	using DataNode = typename list_type::DataNode;
+	using value_type = T;
+	using size_type = std::size_t;
+
+	static constexpr size_type huge_page_size = size_type{ 2 } << 20;
+
+private:
+	unsigned char* mapping;
+	size_type mapping_size;
+	DataNode* nodes;
+	size_type node_capacity;
+	size_type node_count;
+	HugePages obtained_huge_pages;
+	bool is_mapped;
+
+	static size_type round_up(size_type size, size_type alignment) noexcept {
+		return (size + alignment - 1) / alignment * alignment;
+	}
+
+#if defined(GOLDENROCKEFELLER_HAS_MMAP)
+	bool map_hugetlb(size_type size, bool prefault) noexcept {
+#if defined(MAP_HUGETLB)
+		int flags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB;
+#if defined(MAP_POPULATE)
+		if (prefault) {
+			flags |= MAP_POPULATE;
+		}
+#endif
+		void* address = mmap(nullptr, size, PROT_READ | PROT_WRITE, flags, -1, 0);
+		if (address == MAP_FAILED) {
+			return false;
+		}
+
+		this->mapping = static_cast<unsigned char*>(address);
+		this->mapping_size = size;
+		this->nodes = reinterpret_cast<DataNode*>(address);
+		this->obtained_huge_pages = HugePages::explicit_pool;
+		return true;
+#else
+		(void)size;
+		(void)prefault;
+		return false;
+#endif
+	}
+
+	// Maps the range with normal pages, aligned to the huge page size so
+	// that transparent huge pages can back all of it.
+	void map_pages(size_type size, bool use_transparent_huge_pages, bool prefault) {
+		size_type alignment = use_transparent_huge_pages ? huge_page_size : size_type(sysconf(_SC_PAGESIZE));
+		size_type reserved_size = size + alignment;
+
+		void* address = mmap(nullptr, reserved_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		if (address == MAP_FAILED) {
+			throw std::bad_alloc();
+		}
+
+		// Trims the unaligned head and the spare tail.
+		std::uintptr_t start = reinterpret_cast<std::uintptr_t>(address);
+		std::uintptr_t aligned_start = (start + alignment - 1) / alignment * alignment;
+		if (aligned_start > start) {
+			munmap(address, aligned_start - start);
+		}
+		size_type tail_size = (start + reserved_size) - (aligned_start + size);
+		if (tail_size > 0) {
+			munmap(reinterpret_cast<void*>(aligned_start + size), tail_size);
+		}
+
+		this->mapping = reinterpret_cast<unsigned char*>(aligned_start);
+		this->mapping_size = size;
+		this->nodes = reinterpret_cast<DataNode*>(this->mapping);
+		this->obtained_huge_pages = HugePages::none;
+
+#if defined(MADV_HUGEPAGE)
+		if (use_transparent_huge_pages && madvise(this->mapping, size, MADV_HUGEPAGE) == 0) {
+			this->obtained_huge_pages = HugePages::transparent;
+		}
+#endif
+
+		if (prefault) {
+#if defined(MADV_POPULATE_WRITE)
+			if (madvise(this->mapping, size, MADV_POPULATE_WRITE) == 0) {
+				return;
+			}
+#endif
+			// Touches one byte per page; the kernel backs each touched
+			// huge-page-aligned range with a huge page when it can.
+			size_type page_size = size_type(sysconf(_SC_PAGESIZE));
+			for (size_type offset{ 0 }; offset < size; offset += page_size) {
+				reinterpret_cast<volatile unsigned char*>(this->mapping)[offset] = 0;
+			}
+		}
+	}
+#endif
+
+public:
+	// Reserves room for capacity nodes. Throws std::bad_alloc if the range
+	// cannot be mapped.
+	explicit MappedNodeArena(size_type capacity, HugePages huge_pages = HugePages::transparent, bool prefault = false) :
+		mapping{ nullptr },
+		mapping_size{ 0 },
+		nodes{ nullptr },
+		node_capacity{ capacity },
+		node_count{ 0 },
+		obtained_huge_pages{ HugePages::none },
+		is_mapped{ false }
+	{
+		if (capacity == 0) {
+			throw std::invalid_argument("The capacity must not be zero.");
+		}
+		if (capacity > size_type(-1) / sizeof(DataNode) - huge_page_size) {
+			throw std::length_error("The capacity is too large.");
+		}
+
+		size_type size = capacity * sizeof(DataNode);
+
+#if defined(GOLDENROCKEFELLER_HAS_MMAP)
+		if (huge_pages == HugePages::explicit_pool && this->map_hugetlb(round_up(size, huge_page_size), prefault)) {
+			this->is_mapped = true;
+			return;
+		}
+
+		size_type page_size = size_type(sysconf(_SC_PAGESIZE));
+		bool use_transparent_huge_pages = huge_pages != HugePages::none;
+		this->map_pages(round_up(size, use_transparent_huge_pages ? huge_page_size : page_size), use_transparent_huge_pages, prefault);
+		this->is_mapped = true;
+#else
+		(void)huge_pages;
+		(void)prefault;
+		this->mapping = static_cast<unsigned char*>(::operator new(size));
+		this->mapping_size = size;
+		this->nodes = reinterpret_cast<DataNode*>(this->mapping);
+#endif
+	};
+
+	MappedNodeArena(const MappedNodeArena& obj) = delete;
+	MappedNodeArena(MappedNodeArena&& obj) = delete;
+	MappedNodeArena& operator=(const MappedNodeArena& obj) = delete;
+	MappedNodeArena& operator=(MappedNodeArena&& obj) = delete;
+
+	// Destructs every node, which detaches any that are still attached, and
+	// releases the range.
+	~MappedNodeArena() {
+		for (size_type i{ 0 }; i < this->node_count; i++) {
+			this->nodes[i].~DataNode();
+		}
+
+#if defined(GOLDENROCKEFELLER_HAS_MMAP)
+		if (this->is_mapped) {
+			munmap(this->mapping, this->mapping_size);
+		}
+#else
+		::operator delete(this->mapping);
+#endif
+	};
+
+	// The kind of huge pages the arena actually got.
+	HugePages huge_pages() const noexcept {
+		return this->obtained_huge_pages;
+	};
+
+	size_type capacity() const noexcept {
+		return this->node_capacity;
+	};
+
+	size_type size() const noexcept {
+		return this->node_count;
+	};
+
+	bool is_full() const noexcept {
+		return this->node_count == this->node_capacity;
+	};
+
+	// Constructs the next node, in address order. Throws std::bad_alloc if
+	// the arena is full.
+	template <typename... Args>
+	DataNode& allocate(Args&&... args) {
+		if (this->is_full()) {
+			throw std::bad_alloc();
+		}
+
+		DataNode* node = new (this->nodes + this->node_count) DataNode(std::forward<Args>(args)...);
+		this->node_count++;
+		return *node;
+	};
+};
+
+template <typename T>
+constexpr typename MappedNodeArena<T>::size_type MappedNodeArena<T>::huge_page_size;
+
+} // namespace goldenrockefeller
+
+#endif
@@ -24,20 +24,59 @@
 #define GOLDENROCKEFELLER_NODE_LIST_HPP
 
 #include <stdexcept>
+#include <cassert>
 #include <iterator>
+#include <type_traits>
 #include <memory>
 #include <utility>
 #include <iostream>
 #include <sstream>
+#include <cstdint>
+#include <cstring>
+#include <vector>
 
 namespace goldenrockefeller {
 
 template <typename T>
+class LockFreeNodeStack;
+
+// What a data node does when it is destructed.
+enum class LinkMode {
+	// The node detaches itself from its list.
+	auto_unlink,
+	// The node does no work; it must already be detached, which debug builds
+	// assert. Attaching does not detach the node first either: it must be
+	// detached, or have been handed out by clear_and_dispose. Lists that are
+	// torn down with clear_and_dispose never rewrite the links of nodes that
+	// are about to be freed.
+	normal,
+	// The node detaches itself, then overwrites its links with a poison
+	// address, so that a dangling pointer or iterator to the destroyed node
+	// faults on its first use instead of reading a plausible list.
+	safe
+};
+
+// When TaggedLinks is true, the low bits of each data node's links, which are
+// always zero because nodes are pointer-aligned, hold a small set of per-node
+// flags. Every link read masks the flags out and every link write keeps them.
+template <typename T, bool TaggedLinks = false, LinkMode Mode = LinkMode::auto_unlink>
 class NodeList {
 
+	template <typename>
+	friend class LockFreeNodeStack;
+
 private:
 	class Node {
 	public:
+		// Pointer alignment leaves the low bits of every link free.
+		static constexpr unsigned tag_bits = (
+			!TaggedLinks ? 0
+			: alignof(Node*) >= 8 ? 3
+			: alignof(Node*) >= 4 ? 2
+			: 1
+		);
+		static constexpr std::uintptr_t tag_mask = (std::uintptr_t{ 1 } << tag_bits) - 1;
+
 		Node* next_node;
 		Node* prev_node;
 
@@ -48,6 +87,34 @@ private:
 
 		Node& operator=(const Node& node) = delete;
 		Node& operator=(const Node&& node) = delete;
+
+		static Node* untag(Node* link) noexcept {
+			return reinterpret_cast<Node*>(reinterpret_cast<std::uintptr_t>(link) & ~tag_mask);
+		}
+
+		static std::uintptr_t tag_of(Node* link) noexcept {
+			return reinterpret_cast<std::uintptr_t>(link) & tag_mask;
+		}
+
+		static Node* with_tag(Node* node, std::uintptr_t tag) noexcept {
+			return reinterpret_cast<Node*>(reinterpret_cast<std::uintptr_t>(node) | tag);
+		}
+
+		Node* next() const noexcept {
+			return untag(this->next_node);
+		}
+
+		Node* prev() const noexcept {
+			return untag(this->prev_node);
+		}
+
+		void set_next(Node* node) noexcept {
+			this->next_node = with_tag(node, tag_of(this->next_node));
+		}
+
+		void set_prev(Node* node) noexcept {
+			this->prev_node = with_tag(node, tag_of(this->prev_node));
+		}
 	};
 
 	Node before_start_node;
@@ -64,25 +131,143 @@ public:
 	using difference_type = std::ptrdiff_t;
 
 	class DataNode : private Node {
+		friend class NodeList;
+
+		template <typename>
+		friend class LockFreeNodeStack;
+
+		// Takes the other node's links, flags included, repoints its
+		// neighbours at this node and leaves the other node detached. This
+		// node must be detached.
+		void take_place_of(DataNode& node) noexcept {
+			Node* next_node = node.next();
+			Node* prev_node = node.prev();
+
+			this->next_node = node.next_node;
+			this->prev_node = node.prev_node;
+
+			if (prev_node) {
+				prev_node->set_next(this);
+			}
+			if (next_node) {
+				next_node->set_prev(this);
+			}
+
+			node.next_node = nullptr;
+			node.prev_node = nullptr;
+		}
+
+		// Attaching first detaches the node, except in normal mode, where
+		// the node must already be detached, which debug builds assert. Its
+		// links may then be stale, as clear_and_dispose leaves them, and are
+		// only overwritten.
+		void detach_to_attach() noexcept {
+			if (Mode == LinkMode::normal) {
+				assert(!this->is_attached() && "A node must be detached before it is attached.");
+				return;
+			}
+
+			this->detach();
+		}
+
 	public:
+		// The number of flags each node can hold; zero unless TaggedLinks.
+		static constexpr size_type flag_count = 2 * Node::tag_bits;
+
+		// The link value of a destroyed node in safe mode: non-null, so it is
+		// not mistaken for a detached node, and at the top of the address
+		// space, which user code cannot map on common platforms.
+		static constexpr std::uintptr_t poison_address = ~std::uintptr_t{ 0xFF };
+
 		value_type data;
 
 		DataNode() noexcept : Node() {};
 
-		explicit DataNode(T data) noexcept : Node(), data{ data } {};
+		explicit DataNode(T data) noexcept : Node(), data{ std::move(data) } {};
 
 		~DataNode() {
+			if (Mode == LinkMode::normal) {
+				assert(!this->is_attached() && "A node must be detached before it is destructed.");
+				return;
+			}
+
 			this->detach();
+
+			if (Mode == LinkMode::safe) {
+				// Volatile, so that the stores into a dying object are kept.
+				Node* poison = reinterpret_cast<Node*>(poison_address);
+				*static_cast<Node* volatile*>(&(this->next_node)) = poison;
+				*static_cast<Node* volatile*>(&(this->prev_node)) = poison;
+			}
 		};
 
 		DataNode(const DataNode& node) = delete;
-		DataNode(DataNode&& node) = delete;
+
+		// Relocates the node: moves its value and takes its place in its list,
+		// leaving it detached. Nodes can then be stored in containers that
+		// move their elements, such as std::vector, and compacted.
+		DataNode(DataNode&& node) noexcept(std::is_nothrow_move_constructible<T>::value) :
+			Node(),
+			data(std::move(node.data))
+		{
+			this->take_place_of(node);
+		};
 
 		DataNode& operator=(const DataNode& node) = delete;
-		DataNode& operator=(DataNode&& node) = delete;
+
+		// Detaches this node, then relocates the other node into it.
+		DataNode& operator=(DataNode&& node) noexcept(std::is_nothrow_move_assignable<T>::value) {
+			if (this != &node) {
+				this->detach();
+				this->data = std::move(node.data);
+				this->take_place_of(node);
+			}
+			return *this;
+		};
 
 		bool is_attached() const noexcept {
-			return bool(this->next_node) && bool(this->prev_node);
+			return bool(this->next()) && bool(this->prev());
+		}
+
+		// The flags are stored in the low bits of the links: the lower half
+		// in next_node and the upper half in prev_node.
+		unsigned flags() const noexcept {
+			static_assert(TaggedLinks, "Node flags require a NodeList with tagged links.");
+
+			return static_cast<unsigned>(
+				Node::tag_of(this->next_node)
+				| (Node::tag_of(this->prev_node) << (flag_count / 2))
+			);
+		}
+
+		void set_flags(unsigned flags) noexcept {
+			static_assert(TaggedLinks, "Node flags require a NodeList with tagged links.");
+
+			this->next_node = Node::with_tag(this->next(), flags & Node::tag_mask);
+			this->prev_node = Node::with_tag(this->prev(), (flags >> (flag_count / 2)) & Node::tag_mask);
+		}
+
+		bool test_flag(size_type flag) const {
+			if (flag >= flag_count) {
+				throw std::out_of_range("The flag must be less than the flag count.");
+			}
+			return bool(this->flags() & (1u << flag));
+		}
+
+		void set_flag(size_type flag, bool value = true) {
+			if (flag >= flag_count) {
+				throw std::out_of_range("The flag must be less than the flag count.");
+			}
+			if (value) {
+				this->set_flags(this->flags() | (1u << flag));
+			}
+			else {
+				this->set_flags(this->flags() & ~(1u << flag));
+			}
+		}
+
+		void reset_flag(size_type flag) {
+			this->set_flag(flag, false);
 		}
 
 		void attach_to(NodeList& list) {
@@ -94,22 +279,22 @@ public:
 				throw std::invalid_argument("The other node must not be null.");
 			}
 			
-			if (!node->prev_node) {
+			if (!node->prev()) {
 				throw std::invalid_argument("The other node must be attached (previous node is null).");
 			}
 
-			this->detach();
+			this->detach_to_attach();
 
-			if (node->prev_node) {
-				this->next_node = node;
-				this->prev_node = node->prev_node;
-				node->prev_node->next_node = this;
-				node->prev_node = this;
+			if (node->prev()) {
+				this->set_next(node);
+				this->set_prev(node->prev());
+				node->prev()->set_next(this);
+				node->set_prev(this);
 			}
 		};
 
 		void attach_before(DataNode* node) {
-			this->attach_before(node);
+			this->attach_before(static_cast<Node*>(node));
 		};
 
 		void attach_after(Node* node) {
@@ -117,35 +302,38 @@ public:
 				throw std::invalid_argument("The other node must not be null.");
 			}
 
-			if (!node->next_node) {
+			if (!node->next()) {
 				throw std::invalid_argument("The other node must be attached (next node is null).");
 			}
 
-			this->detach();
+			this->detach_to_attach();
 
-			if (node->next_node) {
-				this->next_node = node->next_node;
-				this->prev_node = node;
-				node->next_node->prev_node = this;
-				node->next_node = this;
+			if (node->next()) {
+				this->set_next(node->next());
+				this->set_prev(node);
+				node->next()->set_prev(this);
+				node->set_next(this);
 			}
 		};
 
 		void attach_after(DataNode* node) {
-			this->attach_after(node);
+			this->attach_after(static_cast<Node*>(node));
 		};
 
 
 		void detach() noexcept {
-			if (this->prev_node) {
-				this->prev_node->next_node = this->next_node;
+			Node* next_node = this->next();
+			Node* prev_node = this->prev();
+
+			if (prev_node) {
+				prev_node->set_next(next_node);
 			}
-			if (this->next_node) {
-				this->next_node->prev_node = this->prev_node;
+			if (next_node) {
+				next_node->set_prev(prev_node);
 			}
 
-			this->next_node = nullptr;
-			this->prev_node = nullptr;
+			this->set_next(nullptr);
+			this->set_prev(nullptr);
 		};
 
 		operator T() const noexcept {
@@ -153,12 +341,111 @@ public:
 		}
 	};
 
+private:
+	// How many nodes ahead a pass over a node-pointer snapshot prefetches.
+	static constexpr size_type prefetch_distance = 8;
+
+	static void prefetch(const void* address) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+		__builtin_prefetch(address);
+#else
+		(void)address;
+#endif
+	}
+
+	// Trivially copyable values are copied bytewise, so their buffers may be
+	// uninitialized storage; other values are copy-assigned.
+	static void copy_value(T* target, const T& value, std::true_type) noexcept {
+		std::memcpy(static_cast<void*>(target), static_cast<const void*>(&value), sizeof(T));
+	}
+
+	static void copy_value(T* target, const T& value, std::false_type) {
+		*target = value;
+	}
+
+	static void copy_value(T* target, const T& value) {
+		copy_value(target, value, std::integral_constant<bool, std::is_trivially_copyable<T>::value>());
+	}
+
+	// Moves all nodes of the other list to this empty list, repointing the
+	// first and last nodes at this list's sentinels.
+	void take_nodes(NodeList& obj) noexcept {
+		if (obj.is_empty()) {
+			return;
+		}
+
+		Node* first_node = obj.before_start_node.next();
+		Node* last_node = obj.past_end_node.prev();
+
+		this->before_start_node.set_next(first_node);
+		first_node->set_prev(&(this->before_start_node));
+		this->past_end_node.set_prev(last_node);
+		last_node->set_next(&(this->past_end_node));
+
+		obj.before_start_node.next_node = &(obj.past_end_node);
+		obj.past_end_node.prev_node = &(obj.before_start_node);
+	}
+
+	// Unlinks, in one pass, every data node for which select(prev_node, node)
+	// returns true, where prev_node is the last node that was kept. Each
+	// unlinked node has its links nulled and is then handed to on_unlinked.
+	// The list stays consistent if either callback throws.
+	template <typename Selector, typename Handler>
+	size_type unlink_if(Selector select, Handler on_unlinked) {
+		size_type unlinked{ 0 };
+		Node* prev_node{ &(this->before_start_node) };
+		Node* node{ this->before_start_node.next() };
+
+		try {
+			while (node != &(this->past_end_node)) {
+				Node* next_node = node->next();
+				DataNode* data_node = reinterpret_cast<DataNode*>(node);
+
+				if (select(prev_node, *data_node)) {
+					node->set_next(nullptr);
+					node->set_prev(nullptr);
+					node = next_node;
+					unlinked++;
+					on_unlinked(*data_node);
+					continue;
+				}
+
+				if (node->prev() != prev_node) {
+					prev_node->set_next(node);
+					node->set_prev(prev_node);
+				}
+				prev_node = node;
+				node = next_node;
+			}
+		}
+		catch (...) {
+			prev_node->set_next(node);
+			node->set_prev(prev_node);
+			throw;
+		}
+
+		prev_node->set_next(&(this->past_end_node));
+		this->past_end_node.set_prev(prev_node);
+
+		return unlinked;
+	}
+
+	static DataNode* data_node_pointer(DataNode* node) noexcept {
+		return node;
+	}
+
+	static DataNode* data_node_pointer(DataNode& node) noexcept {
+		return &node;
+	}
+
+public:
 
 
 
 	template <typename Type>
 	class base_iterator
 	{
+		friend class NodeList;
 
 	protected:
 		Node* current_node;
@@ -194,7 +481,7 @@ public:
 		}
 
 		bool is_at_detached_datanode_no_null_check() const {
-			return !bool(this->current_node->next_node) && !bool(this->current_node->prev_node);
+			return !bool(this->current_node->next()) && !bool(this->current_node->prev());
 		}
 
 		bool is_at_detached_datanode() const {
@@ -205,7 +492,7 @@ public:
 		}
 
 		bool is_at_attached_datanode_no_null_check() const {
-			return bool(this->current_node->next_node) && bool(this->current_node->prev_node);
+			return bool(this->current_node->next()) && bool(this->current_node->prev());
 		}
 
 		bool is_at_attached_datanode() const {
@@ -230,7 +517,7 @@ public:
 		}
 
 		bool is_past_the_end_no_null_check() const {
-			return !this->current_node->next_node && bool(this->current_node->prev_node);
+			return !this->current_node->next() && bool(this->current_node->prev());
 			
 		}
 
@@ -242,7 +529,7 @@ public:
 		}
 
 		bool is_before_the_start_no_null_check() const {
-			return !this->current_node->prev_node && bool(this->current_node->next_node);
+			return !this->current_node->prev() && bool(this->current_node->next());
 		}
 
 		bool is_before_the_start() const {
@@ -260,7 +547,7 @@ public:
 				throw std::runtime_error("Cannot increment iterator that is past-the-end.");
 			}
 
-			this->current_node = this->current_node->next_node;
+			this->current_node = this->current_node->next();
 
 			return *this;
 		}
@@ -273,7 +560,7 @@ public:
 				throw std::runtime_error("Cannot decrement iterator that is before-the-start.");
 			}
 
-			this->current_node = this->current_node->prev_node;
+			this->current_node = this->current_node->prev();
 
 			return *this;
 		}
@@ -288,7 +575,7 @@ public:
 
 			base_iterator it(*this);
 
-			this->current_node = this->current_node->next_node;
+			this->current_node = this->current_node->next();
 
 			return it;
 		}
@@ -303,7 +590,7 @@ public:
 
 			base_iterator it(*this);
 
-			this->current_node = this->current_node->prev_node;
+			this->current_node = this->current_node->prev();
 
 			return it;
 		};
@@ -390,8 +677,8 @@ public:
 				throw std::runtime_error("To detach the iterator's current node, the node must be an attached data node.");
 			}
 
-			Node* next_node = this->current_node->next_node;
-			this->current_node.detach();
+			Node* next_node = this->current_node->next();
+			reinterpret_cast<DataNode*>(this->current_node)->detach();
 			this->current_node = next_node;
 		}
 
@@ -403,8 +690,8 @@ public:
 				throw std::runtime_error("To detach the iterator's current node, the node must be an attached data node.");
 			}
 
-			Node* prev_node = this->current_node->prev_node;
-			this->current_node.detach();
+			Node* prev_node = this->current_node->prev();
+			reinterpret_cast<DataNode*>(this->current_node)->detach();
 			this->current_node = prev_node;
 		}
 	};
@@ -427,47 +714,15 @@ public:
 	};
 
 	NodeList(const NodeList& obj) = delete;
-	NodeList(NodeList&& obj) noexcept {
-		if (!obj.is_empty()) {
-			this->before_start_node.prev_node = obj.before_start_node.prev_node;
-			this->before_start_node.next_node = obj.before_start_node.next_node;
-			this->past_end_node.prev_node = obj.past_end_node.prev_node;
-			this->past_end_node.next_node = obj.past_end_node.next_node;
-
-			obj.before_start_node.prev_node = nullptr;
-			obj.before_start_node.next_node = &(obj.past_end_node);
-			obj.past_end_node.prev_node = &(obj.before_start_node);
-			obj.past_end_node.next_node = nullptr;
-		}
-
-		else {
-			this->before_start_node.prev_node = nullptr;
-			this->before_start_node.next_node = &(this->past_end_node);
-			this->past_end_node.prev_node = &(this->before_start_node);
-			this->past_end_node.next_node = nullptr;
-		}
-
-
+	NodeList(NodeList&& obj) noexcept : NodeList() {
+		this->take_nodes(obj);
 	};
 
 	NodeList& operator=(NodeList const& obj) = delete;
 	NodeList& operator=(NodeList&& obj) noexcept {
-		if (!obj.is_empty()) {
-			this->before_start_node.prev_node = obj.before_start_node.prev_node;
-			this->before_start_node.next_node = obj.before_start_node.next_node;
-			this->past_end_node.prev_node = obj.past_end_node.prev_node;
-			this->past_end_node.next_node = obj.past_end_node.next_node;
-
-			obj.before_start_node.prev_node = nullptr;
-			obj.before_start_node.next_node = &(obj.past_end_node);
-			obj.past_end_node.prev_node = &(obj.before_start_node);
-			obj.past_end_node.next_node = nullptr;
-		}
-		else {
-			this->before_start_node.prev_node = nullptr;
-			this->before_start_node.next_node = &(this->past_end_node);
-			this->past_end_node.prev_node = &(this->before_start_node);
-			this->past_end_node.next_node = nullptr;
+		if (this != &obj) {
+			this->clear();
+			this->take_nodes(obj);
 		}
 
 		return *this;
@@ -486,26 +741,26 @@ public:
 		return iterator(&(this->past_end_node));
 	};
 	const_iterator end() const noexcept {
-		return const_iterator(&(this->past_end_node));
+		return const_iterator(const_cast<Node*>(&(this->past_end_node)));
 	};
 	const_iterator cend() const noexcept {
 		return this->end();
 	};
 
 	reverse_iterator rbegin() noexcept {
-		return reverse_iterator(iterator(this->past_end_node.prev_node));
+		return reverse_iterator(this->end());
 	};
 	const_reverse_iterator rbegin() const noexcept {
-		return reverse_iterator(const_iterator(this->past_end_node.prev_node));
+		return const_reverse_iterator(this->end());
 	};
 	const_reverse_iterator crbegin() const noexcept {
 		return this->rbegin();
 	};
 	reverse_iterator rend() noexcept {
-		return reverse_iterator(iterator(&(this->before_start_node)));
+		return reverse_iterator(this->begin());
 	};
 	const_reverse_iterator rend() const noexcept {
-		return reverse_iterator(const_iterator(&(this->before_start_node)));
+		return const_reverse_iterator(this->begin());
 	};
 	const_reverse_iterator crend() const noexcept {
 		return this->rend();
@@ -519,28 +774,390 @@ public:
 		);
 	};
 
+	// Returns the first data node of the list, or null if the list is empty.
+	DataNode* front_node() noexcept {
+		if (this->is_empty()) {
+			return nullptr;
+		}
+		return reinterpret_cast<DataNode*>(this->before_start_node.next());
+	};
+
+	// Returns the last data node of the list, or null if the list is empty.
+	DataNode* back_node() noexcept {
+		if (this->is_empty()) {
+			return nullptr;
+		}
+		return reinterpret_cast<DataNode*>(this->past_end_node.prev());
+	};
+
+	// Returns an iterator at the node, which must be attached to this list.
+	iterator iterator_to(DataNode& node) noexcept {
+		return iterator(static_cast<Node*>(&node));
+	};
+
+	// Returns the data node at the iterator's position.
+	static DataNode& node_at(const_iterator pos) {
+		if (pos.is_at_nullptr()) {
+			throw std::runtime_error("The iterator's current node must not be null.");
+		}
+		if (!pos.is_at_datanode_no_null_check()) {
+			throw std::runtime_error("The iterator must be at a data node.");
+		}
+		return *reinterpret_cast<DataNode*>(pos.current_node);
+	};
+
 	size_type size() const noexcept {
 
 		size_type size{ 0 };
 		Node* node{ this->before_start_node.next_node };
 
 		while (node != &(this->past_end_node)) {
-			node = node->next_node;
+			node = node->next();
 			size++;
 		}
 
 		return size;
 	};
 
+	// Snapshots: the list stays the source of truth, and a snapshot gives
+	// random access to its nodes or a contiguous copy of its data, e.g. for
+	// vectorized passes. Each snapshot is taken in one pass over the links
+	// without the iterators' checks. A walk of the links cannot prefetch
+	// ahead of the next node, so only gather and scatter over a node snapshot
+	// prefetch. A snapshot is invalidated by attaching or detaching nodes of
+	// the list.
+
+	// Writes pointers to up to capacity nodes, in order, into buffer and
+	// returns how many were written.
+	size_type snapshot_nodes(DataNode** buffer, size_type capacity) noexcept {
+		size_type count{ 0 };
+		Node* node{ this->before_start_node.next() };
+
+		while (node != &(this->past_end_node) && count < capacity) {
+			buffer[count] = reinterpret_cast<DataNode*>(node);
+			node = node->next();
+			count++;
+		}
+
+		return count;
+	};
+
+	// Grows the vector as it walks, since counting the nodes first would cost
+	// a second walk; the buffer overload is the fast path when the caller
+	// already knows the size.
+	std::vector<DataNode*> snapshot_nodes() {
+		std::vector<DataNode*> nodes;
+		Node* node{ this->before_start_node.next() };
+
+		while (node != &(this->past_end_node)) {
+			nodes.push_back(reinterpret_cast<DataNode*>(node));
+			node = node->next();
+		}
+
+		return nodes;
+	};
+
+	// Copies the data of up to capacity nodes, in order, into buffer and
+	// returns how many were copied. If T is trivially copyable, buffer may be
+	// uninitialized storage, such as memory from an arena.
+	size_type snapshot(T* buffer, size_type capacity) const {
+		size_type count{ 0 };
+		Node* node{ this->before_start_node.next() };
+
+		while (node != &(this->past_end_node) && count < capacity) {
+			copy_value(buffer + count, reinterpret_cast<const DataNode*>(node)->data);
+			node = node->next();
+			count++;
+		}
+
+		return count;
+	};
+
+	// Like snapshot_nodes(), grows the vector as it walks; the buffer
+	// overload is the fast path.
+	std::vector<T> snapshot() const {
+		std::vector<T> values;
+		Node* node{ this->before_start_node.next() };
+
+		while (node != &(this->past_end_node)) {
+			values.push_back(reinterpret_cast<const DataNode*>(node)->data);
+			node = node->next();
+		}
+
+		return values;
+	};
+
+	// Copies the data of the snapshotted nodes into buffer, prefetching the
+	// nodes ahead, for repeated passes over the same nodes.
+	static void gather(DataNode* const* nodes, size_type count, T* buffer) {
+		for (size_type i{ 0 }; i < count; i++) {
+			if (i + prefetch_distance < count) {
+				prefetch(nodes[i + prefetch_distance]);
+			}
+			copy_value(buffer + i, nodes[i]->data);
+		}
+	};
+
+	// Writes values back into the data of the snapshotted nodes, prefetching
+	// the nodes ahead.
+	static void scatter(DataNode* const* nodes, size_type count, const T* values) {
+		for (size_type i{ 0 }; i < count; i++) {
+			if (i + prefetch_distance < count) {
+				prefetch(nodes[i + prefetch_distance]);
+			}
+			copy_value(&(nodes[i]->data), values[i]);
+		}
+	};
+
+	// Writes up to count values back into the data of the list's nodes, in
+	// order, and returns how many were written.
+	size_type scatter(const T* values, size_type count) {
+		size_type written{ 0 };
+		Node* node{ this->before_start_node.next() };
+
+		while (node != &(this->past_end_node) && written < count) {
+			copy_value(&(reinterpret_cast<DataNode*>(node)->data), values[written]);
+			node = node->next();
+			written++;
+		}
+
+		return written;
+	};
+
+
+	// Attaches the nodes in [first, last) before the iterator's position, in
+	// order. The elements of the range may be DataNode pointers or references.
+	// The nodes are linked to each other in one pass and the list is only
+	// written at the boundary of the range. A node must not appear twice in
+	// the range, and the node at the iterator's position must not appear.
+	template <typename ForwardIt>
+	void attach_range_before(const_iterator pos, ForwardIt first, ForwardIt last) {
+		if (pos.is_at_nullptr()) {
+			throw std::runtime_error("The iterator's current node must not be null.");
+		}
+		if (pos.is_before_the_start_no_null_check()) {
+			throw std::runtime_error("Cannot attach nodes before this iterator if this iterator is before-the-start.");
+		}
+		if (!pos.is_past_the_end_no_null_check() && !pos.is_at_attached_datanode_no_null_check()) {
+			throw std::invalid_argument("The iterator must be at an attached node.");
+		}
+
+		Node* next_node = pos.current_node;
+
+		for (ForwardIt it = first; it != last; ++it) {
+			DataNode* node = data_node_pointer(*it);
+			if (!node) {
+				throw std::invalid_argument("The nodes must not be null.");
+			}
+			if (static_cast<Node*>(node) == next_node) {
+				throw std::invalid_argument("The nodes must not include the node at the iterator's position.");
+			}
+		}
+
+		if (first == last) {
+			return;
+		}
+
+		Node* first_node = data_node_pointer(*first);
+		Node* last_node = nullptr;
+
+		for (ForwardIt it = first; it != last; ++it) {
+			DataNode* node = data_node_pointer(*it);
+			node->detach_to_attach();
+			node->set_prev(last_node);
+			if (last_node) {
+				last_node->set_next(node);
+			}
+			last_node = node;
+		}
+
+		// Read the boundary only now, as detaching the range may have moved it.
+		Node* prev_node = next_node->prev();
+		first_node->set_prev(prev_node);
+		prev_node->set_next(first_node);
+		last_node->set_next(next_node);
+		next_node->set_prev(last_node);
+	};
+
+	template <typename ForwardRange>
+	void attach_range_before(const_iterator pos, ForwardRange&& nodes) {
+		using std::begin;
+		using std::end;
+		this->attach_range_before(pos, begin(nodes), end(nodes));
+	};
+
+	// Attaches the nodes in [first, last) to the end of the list, in order.
+	template <typename ForwardIt>
+	void attach_range(ForwardIt first, ForwardIt last) {
+		this->attach_range_before(this->end(), first, last);
+	};
+
+	template <typename ForwardRange>
+	void attach_range(ForwardRange&& nodes) {
+		this->attach_range_before(this->end(), std::forward<ForwardRange>(nodes));
+	};
+
+	// Detaches every node whose data satisfies the predicate, in one pass,
+	// and hands each detached node to the disposer, e.g. to return it to a
+	// pool. The disposer may destruct the node. Returns the number of
+	// detached nodes.
+	template <typename Predicate, typename Disposer>
+	size_type remove_if(Predicate pred, Disposer disposer) {
+		return this->unlink_if(
+			[&pred](const Node*, DataNode& node) { return bool(pred(node.data)); },
+			disposer
+		);
+	};
+
+	template <typename Predicate>
+	size_type remove_if(Predicate pred) {
+		return this->remove_if(pred, [](DataNode&) {});
+	};
+
+	// Detaches every node whose data is equal to the data of the last kept
+	// node before it, so that only the first node of each run of equal
+	// elements remains, and hands each detached node to the disposer.
+	// Returns the number of detached nodes.
+	template <typename BinaryPredicate, typename Disposer>
+	size_type unique(BinaryPredicate eq, Disposer disposer) {
+		const Node* before_start_node = &(this->before_start_node);
+		return this->unlink_if(
+			[&eq, before_start_node](const Node* prev_node, DataNode& node) {
+				return (
+					prev_node != before_start_node
+					&& bool(eq(reinterpret_cast<const DataNode*>(prev_node)->data, node.data))
+				);
+			},
+			disposer
+		);
+	};
+
+	template <typename BinaryPredicate>
+	size_type unique(BinaryPredicate eq) {
+		return this->unique(eq, [](DataNode&) {});
+	};
+
+	size_type unique() {
+		return this->unique([](const value_type& a, const value_type& b) { return a == b; });
+	};
+
+	// Moves every node whose data satisfies the predicate to a new list, in
+	// one pass. Both lists keep the relative order of their nodes. If the
+	// predicate throws, the nodes selected so far are moved to the back of
+	// this list, so no node is lost.
+	template <typename Predicate>
+	NodeList partition(Predicate pred) {
+		NodeList selected;
+		Node* past_end_node = &(selected.past_end_node);
+
+		try {
+			this->unlink_if(
+				[&pred](const Node*, DataNode& node) { return bool(pred(node.data)); },
+				[past_end_node](DataNode& node) {
+					Node* last_node = past_end_node->prev();
+					node.set_prev(last_node);
+					node.set_next(past_end_node);
+					last_node->set_next(&node);
+					past_end_node->set_prev(&node);
+				}
+			);
+		}
+		catch (...) {
+			this->splice_back(selected);
+			throw;
+		}
+
+		return selected;
+	};
+
+	// Moves every node of the other list to the back of this list in O(1).
+	void splice_back(NodeList& other) noexcept {
+		if (this == &other || other.is_empty()) {
+			return;
+		}
+
+		Node* first_node = other.before_start_node.next();
+		Node* last_node = other.past_end_node.prev();
+		Node* back_node = this->past_end_node.prev();
+
+		back_node->set_next(first_node);
+		first_node->set_prev(back_node);
+		this->past_end_node.set_prev(last_node);
+		last_node->set_next(&(this->past_end_node));
+
+		other.before_start_node.next_node = &(other.past_end_node);
+		other.past_end_node.prev_node = &(other.before_start_node);
+	};
+
+	// Exchanges the nodes of the two lists in O(1).
+	void swap(NodeList& other) noexcept {
+		if (this == &other) {
+			return;
+		}
+
+		NodeList nodes;
+		nodes.take_nodes(other);
+		other.take_nodes(*this);
+		this->take_nodes(nodes);
+	};
+
+	// Empties the list and hands every data node to the disposer, in order,
+	// e.g. to destruct and free it. The disposer may destruct the node.
+	// Unless the list is in normal mode, the node's links are nulled first;
+	// in normal mode they are left as they are in release builds, so that a
+	// list of nodes that are about to be freed is torn down without writing
+	// to them. The disposer may then still attach the node elsewhere, e.g.
+	// to return it to a pool, as attaching a normal-mode node ignores its
+	// links, but must not detach it, move it or ask whether it is attached.
+	// If the disposer throws, the nodes after the one it was given stay in
+	// the list.
+	template <typename Disposer>
+	void clear_and_dispose(Disposer disposer) {
+		Node* node{ this->before_start_node.next() };
+		Node* last_node{ this->past_end_node.prev() };
+
+		this->before_start_node.next_node = &(this->past_end_node);
+		this->past_end_node.prev_node = &(this->before_start_node);
+
+#if defined(NDEBUG)
+		const bool null_links = Mode != LinkMode::normal;
+#else
+		const bool null_links = true;
+#endif
+
+		try {
+			while (node != &(this->past_end_node)) {
+				Node* next_node = node->next();
+
+				if (null_links) {
+					node->set_next(nullptr);
+					node->set_prev(nullptr);
+				}
+
+				Node* disposed_node = node;
+				node = next_node;
+				disposer(*reinterpret_cast<DataNode*>(disposed_node));
+			}
+		}
+		catch (...) {
+			// The nodes that were not yet disposed go back to the list.
+			if (node != &(this->past_end_node)) {
+				this->before_start_node.set_next(node);
+				node->set_prev(&(this->before_start_node));
+				this->past_end_node.set_prev(last_node);
+			}
+			throw;
+		}
+	};
 
 	void clear() noexcept {
 		Node* node{ &(this->before_start_node) };
 
 		// Manually detach all nodes in the list.
 		while (node) {
-			Node* next_node = node->next_node;
-			node->next_node = nullptr;
-			node->prev_node = nullptr;
+			Node* next_node = node->next();
+			node->set_next(nullptr);
+			node->set_prev(nullptr);
 			node = next_node;
 		}
 
@@ -552,6 +1169,21 @@ public:
 	};
 };
 
+template <typename T, bool TaggedLinks, LinkMode Mode>
+constexpr unsigned NodeList<T, TaggedLinks, Mode>::Node::tag_bits;
+
+template <typename T, bool TaggedLinks, LinkMode Mode>
+constexpr std::uintptr_t NodeList<T, TaggedLinks, Mode>::Node::tag_mask;
+
+template <typename T, bool TaggedLinks, LinkMode Mode>
+constexpr typename NodeList<T, TaggedLinks, Mode>::size_type NodeList<T, TaggedLinks, Mode>::DataNode::flag_count;
+
+template <typename T, bool TaggedLinks, LinkMode Mode>
+constexpr std::uintptr_t NodeList<T, TaggedLinks, Mode>::DataNode::poison_address;
+
+template <typename T, bool TaggedLinks, LinkMode Mode>
+constexpr typename NodeList<T, TaggedLinks, Mode>::size_type NodeList<T, TaggedLinks, Mode>::prefetch_distance;
+
 } // namespace goldenrockefeller
 
 #endif
\ No newline at end of file
@@ -0,0 +1,134 @@
+// MIT License
+
+// Copyright(c) 2021 Golden Rockefeller
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef GOLDENROCKEFELLER_NODE_LIST_EXCHANGER_HPP
+#define GOLDENROCKEFELLER_NODE_LIST_EXCHANGER_HPP
+
+#include <stdexcept>
+#include <atomic>
+#include <cstdint>
+
+#include "node_list.hpp"
+
+#if !defined(__cpp_aligned_new)
+#error "NodeListExchanger needs C++17 aligned new for its cache-line-aligned state."
+#endif
+
+namespace goldenrockefeller {
+
+// Hands whole batches of nodes from one producer thread to one consumer
+// thread. A NodeList cannot be swapped atomically, because its sentinels
+// live inside it, so the exchanger owns three lists and swaps their indices
+// instead, as in a triple buffer: the producer and the consumer each own a
+// spare list, and the third is the shared mailbox.
+//
+// The producer splices its batch into its spare list in O(1) and swaps that
+// list with the mailbox in one atomic exchange, which also sets the fresh
+// bit. The consumer swaps its empty spare list with a fresh mailbox in one
+// exchange and splices the batch out. Only the producer sets the fresh bit
+// and only the consumer clears it, so a mailbox without the fresh bit is
+// always empty and publishing never hands a non-empty list back.
+template <typename T>
+class NodeListExchanger {
+
+public:
+	using list_type = NodeList<T>;
+	using DataNode = typename list_type::DataNode;
+	using size_type = std::size_t;
+
+	static constexpr size_type cache_line_size = 64;
+
+private:
+	using state_type = std::uint32_t;
+
+	static constexpr state_type index_mask = 3;
+	static constexpr state_type fresh_bit = 4;
+
+	list_type lists[3];
+
+	// The index of the mailbox list and the fresh bit.
+	alignas(cache_line_size) std::atomic<state_type> state;
+
+	alignas(cache_line_size) state_type producer_index;
+	alignas(cache_line_size) state_type consumer_index;
+
+public:
+	NodeListExchanger() noexcept : lists{}, state{ 0 }, producer_index{ 1 }, consumer_index{ 2 } {};
+
+	NodeListExchanger(const NodeListExchanger& obj) = delete;
+	NodeListExchanger(NodeListExchanger&& obj) = delete;
+	NodeListExchanger& operator=(const NodeListExchanger& obj) = delete;
+	NodeListExchanger& operator=(NodeListExchanger&& obj) = delete;
+
+	// Producer only. Moves every node of the batch to the mailbox, leaving
+	// the batch empty, and returns true. Returns false, and leaves the batch
+	// alone, if the consumer has not taken the previous batch yet; the
+	// producer can keep adding to its batch and publish it later.
+	bool publish(list_type& batch) noexcept {
+		if (batch.is_empty()) {
+			return true;
+		}
+		if (this->state.load(std::memory_order_acquire) & fresh_bit) {
+			return false;
+		}
+
+		this->lists[this->producer_index].splice_back(batch);
+
+		state_type old_state = this->state.exchange(this->producer_index | fresh_bit, std::memory_order_acq_rel);
+		this->producer_index = old_state & index_mask;
+
+		return true;
+	};
+
+	// Consumer only. Moves the published batch, if any, to the back of the
+	// list. Returns false if no batch was waiting.
+	bool take(list_type& list) noexcept {
+		if (!(this->state.load(std::memory_order_acquire) & fresh_bit)) {
+			return false;
+		}
+
+		state_type old_state = this->state.exchange(this->consumer_index, std::memory_order_acq_rel);
+		this->consumer_index = old_state & index_mask;
+
+		list.splice_back(this->lists[this->consumer_index]);
+
+		return true;
+	};
+
+	// A snapshot; true if a published batch is waiting for the consumer.
+	bool has_batch() const noexcept {
+		return bool(this->state.load(std::memory_order_acquire) & fresh_bit);
+	};
+};
+
+template <typename T>
+constexpr typename NodeListExchanger<T>::size_type NodeListExchanger<T>::cache_line_size;
+
+template <typename T>
+constexpr typename NodeListExchanger<T>::state_type NodeListExchanger<T>::index_mask;
+
+template <typename T>
+constexpr typename NodeListExchanger<T>::state_type NodeListExchanger<T>::fresh_bit;
+
+} // namespace goldenrockefeller
+
+#endif
@@ -0,0 +1,251 @@
+// MIT License
+
+// Copyright(c) 2021 Golden Rockefeller
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef GOLDENROCKEFELLER_NODE_POOL_HPP
+#define GOLDENROCKEFELLER_NODE_POOL_HPP
+
+#include <stdexcept>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "node_list.hpp"
+#include "sync_primitives.hpp"
+#include "lock_free_node_stack.hpp"
+
+#if !defined(__cpp_aligned_new)
+#error "NodePool needs C++17 aligned new for its cache-line-aligned caches."
+#endif
+
+namespace goldenrockefeller {
+
+// A pool of NodeList DataNodes with one cache per thread. Threads reach the
+// pool through a Handle, which claims one of the caches allocated at
+// construction; the cache outlives the handle and is reused by the next
+// handle that claims it.
+//
+// Each cache keeps its free nodes in a local NodeList, its magazine, so
+// acquiring and releasing a node of its own is a pointer swap. Each node
+// remembers its home cache. A node released by another thread is batched in
+// that thread's outbox and handed back to its home in one CAS through the
+// home's lock-free inbox, which the home drains in one exchange when its
+// magazine runs dry.
+//
+// When the magazine and the inbox are both empty, the cache allocates a slab
+// of nodes and initializes it from the calling thread, so under the default
+// first-touch policy the slab lands on that thread's NUMA node. Slabs are
+// only freed with the pool, which must outlive every node it handed out.
+template <typename T>
+class NodePool {
+
+public:
+	using list_type = NodeList<T>;
+	using DataNode = typename list_type::DataNode;
+	using value_type = T;
+	using size_type = std::size_t;
+
+	static constexpr size_type cache_line_size = 64;
+
+private:
+	struct Cache;
+
+	class PooledNode : public DataNode {
+	public:
+		Cache* home;
+
+		PooledNode() : DataNode(), home{ nullptr } {};
+	};
+
+	struct alignas(cache_line_size) Cache {
+		// Written by other threads.
+		LockFreeNodeStack<T> inbox;
+
+		// Owned by the thread that holds the cache.
+		alignas(cache_line_size) list_type magazine;
+		list_type outbox;
+		Cache* outbox_home;
+		size_type outbox_count;
+		ClaimFlag is_claimed;
+
+		Cache() noexcept : inbox{}, magazine{}, outbox{}, outbox_home{ nullptr }, outbox_count{ 0 }, is_claimed{} {};
+	};
+
+	size_type slab_size;
+	size_type batch_size;
+
+	std::unique_ptr<Cache[]> caches;
+	size_type cache_count;
+
+	std::mutex slab_mutex;
+	std::vector<std::unique_ptr<PooledNode[]>> slabs;
+
+	void add_slab(Cache& cache) {
+		std::unique_ptr<PooledNode[]> slab(new PooledNode[this->slab_size]);
+
+		for (size_type i{ 0 }; i < this->slab_size; i++) {
+			slab[i].home = &cache;
+			slab[i].attach_to(cache.magazine);
+		}
+
+		std::lock_guard<std::mutex> guard(this->slab_mutex);
+		this->slabs.push_back(std::move(slab));
+	}
+
+	static void flush_outbox(Cache& cache) {
+		if (cache.outbox_home) {
+			cache.outbox_home->inbox.push_list(cache.outbox);
+			cache.outbox_home = nullptr;
+			cache.outbox_count = 0;
+		}
+	}
+
+public:
+	class Handle {
+		NodePool& owner;
+		Cache* cache;
+
+	public:
+		// Throws std::length_error if every cache is claimed.
+		explicit Handle(NodePool& owner) :
+			owner(owner),
+			cache{ &claim_first_slot(owner.caches.get(), owner.cache_count, "Every cache of the node pool is claimed.") }
+		{};
+
+		// Returns the batched remote frees to their homes.
+		~Handle() {
+			flush_outbox(*(this->cache));
+			this->cache->is_claimed.release();
+		};
+
+		Handle(const Handle& obj) = delete;
+		Handle(Handle&& obj) = delete;
+		Handle& operator=(const Handle& obj) = delete;
+		Handle& operator=(Handle&& obj) = delete;
+
+		// Returns a detached node. Its data keeps whatever value it had when
+		// it was last released.
+		DataNode& acquire() {
+			Cache& cache = *(this->cache);
+
+			if (cache.magazine.is_empty()) {
+				list_type returned = cache.inbox.pop_all();
+				cache.magazine.splice_back(returned);
+			}
+			if (cache.magazine.is_empty()) {
+				this->owner.add_slab(cache);
+			}
+
+			DataNode* node = cache.magazine.front_node();
+			node->detach();
+			return *node;
+		};
+
+		DataNode& acquire(const T& data) {
+			DataNode& node = this->acquire();
+			node.data = data;
+			return node;
+		};
+
+		// Detaches the node and returns it to the pool. The node must have
+		// been acquired from this pool, by any thread.
+		void release(DataNode& node) {
+			Cache& cache = *(this->cache);
+			Cache* home = static_cast<PooledNode&>(node).home;
+
+			node.detach();
+
+			if (home == &cache) {
+				node.attach_to(cache.magazine);
+				return;
+			}
+
+			if (cache.outbox_home != home) {
+				flush_outbox(cache);
+				cache.outbox_home = home;
+			}
+
+			node.attach_to(cache.outbox);
+
+			if (++(cache.outbox_count) >= this->owner.batch_size) {
+				flush_outbox(cache);
+			}
+		};
+
+		// Returns the batched remote frees to their homes now.
+		void flush() {
+			flush_outbox(*(this->cache));
+		};
+	};
+
+	explicit NodePool(size_type max_thread_count = 64, size_type slab_size = 256, size_type batch_size = 32) :
+		slab_size{ slab_size },
+		batch_size{ batch_size },
+		caches{},
+		cache_count{ max_thread_count },
+		slab_mutex{},
+		slabs{}
+	{
+		if (max_thread_count == 0) {
+			throw std::invalid_argument("The maximum thread count must not be zero.");
+		}
+		if (slab_size == 0) {
+			throw std::invalid_argument("The slab size must not be zero.");
+		}
+		if (batch_size == 0) {
+			throw std::invalid_argument("The batch size must not be zero.");
+		}
+
+		this->caches.reset(new Cache[max_thread_count]);
+	};
+
+	NodePool(const NodePool& obj) = delete;
+	NodePool(NodePool&& obj) = delete;
+	NodePool& operator=(const NodePool& obj) = delete;
+	NodePool& operator=(NodePool&& obj) = delete;
+
+	// Every Handle must be gone, and every node must be detached.
+	~NodePool() {
+		for (size_type i{ 0 }; i < this->cache_count; i++) {
+			Cache& cache = this->caches[i];
+			list_type returned = cache.inbox.pop_all();
+			returned.clear();
+		}
+
+		// The caches go before the slabs, so that their lists are cleared
+		// at once instead of node by node.
+		this->caches.reset();
+	};
+
+	// The number of nodes allocated in slabs so far.
+	size_type capacity() {
+		std::lock_guard<std::mutex> guard(this->slab_mutex);
+		return this->slabs.size() * this->slab_size;
+	};
+};
+
+template <typename T>
+constexpr typename NodePool<T>::size_type NodePool<T>::cache_line_size;
+
+} // namespace goldenrockefeller
+
+#endif
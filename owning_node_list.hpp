@@ -0,0 +1,236 @@
+// MIT License
+
+// Copyright(c) 2021 Golden Rockefeller
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#ifndef GOLDENROCKEFELLER_OWNING_NODE_LIST_HPP
+#define GOLDENROCKEFELLER_OWNING_NODE_LIST_HPP
+
+#include <stdexcept>
+#include <memory>
+#include <utility>
+
+#if defined(__has_include) && __cplusplus >= 201703L
+#if __has_include(<memory_resource>)
+#include <memory_resource>
+#define GOLDENROCKEFELLER_HAS_MEMORY_RESOURCE
+#endif
+#endif
+
+#include "node_list.hpp"
+
+namespace goldenrockefeller {
+
+// A NodeList that owns its nodes. Nodes are allocated through the allocator,
+// rebound to DataNode, when values are emplaced, and are destructed and
+// deallocated when they are erased, popped or cleared, or when the list is
+// destructed.
+//
+// The nodes stay ordinary DataNodes, so they can be detached, attached to
+// plain NodeLists and attached back through get_list(). A node that is moved
+// out is no longer freed by this list; it must be attached back or returned
+// through dispose. Every node attached to the list when it frees its nodes
+// must have been allocated by it, or by a list with an equal allocator.
+template <typename T, typename Allocator = std::allocator<T>>
+class OwningNodeList {
+
+public:
+	using list_type = NodeList<T>;
+	using DataNode = typename list_type::DataNode;
+	using value_type = T;
+	using allocator_type = Allocator;
+	using reference = value_type&;
+	using const_reference = const value_type&;
+	using size_type = std::size_t;
+	using difference_type = std::ptrdiff_t;
+	using iterator = typename list_type::iterator;
+	using const_iterator = typename list_type::const_iterator;
+
+private:
+	using node_allocator_type = typename std::allocator_traits<Allocator>::template rebind_alloc<DataNode>;
+	using node_traits = std::allocator_traits<node_allocator_type>;
+
+	node_allocator_type node_allocator;
+	list_type list;
+
+	template <typename... Args>
+	DataNode& allocate_node(Args&&... args) {
+		DataNode* node = node_traits::allocate(this->node_allocator, 1);
+
+		try {
+			node_traits::construct(this->node_allocator, node, T(std::forward<Args>(args)...));
+		}
+		catch (...) {
+			node_traits::deallocate(this->node_allocator, node, 1);
+			throw;
+		}
+
+		return *node;
+	}
+
+	// Destructing the node detaches it.
+	void free_node(DataNode& node) noexcept {
+		node_traits::destroy(this->node_allocator, &node);
+		node_traits::deallocate(this->node_allocator, &node, 1);
+	}
+
+public:
+	OwningNodeList() : node_allocator{}, list{} {};
+
+	explicit OwningNodeList(const Allocator& allocator) : node_allocator(allocator), list{} {};
+
+	OwningNodeList(const OwningNodeList& obj) = delete;
+
+	// Takes the nodes and a copy of the allocator in O(1).
+	OwningNodeList(OwningNodeList&& obj) noexcept :
+		node_allocator(obj.node_allocator),
+		list(std::move(obj.list))
+	{};
+
+	OwningNodeList& operator=(const OwningNodeList& obj) = delete;
+	OwningNodeList& operator=(OwningNodeList&& obj) = delete;
+
+	~OwningNodeList() {
+		this->clear();
+	};
+
+	allocator_type get_allocator() const noexcept {
+		return allocator_type(this->node_allocator);
+	};
+
+	// The underlying intrusive list, for attaching and detaching the owned
+	// nodes directly.
+	list_type& get_list() noexcept {
+		return this->list;
+	};
+
+	iterator begin() noexcept {
+		return this->list.begin();
+	};
+	iterator end() noexcept {
+		return this->list.end();
+	};
+
+	bool is_empty() const noexcept {
+		return this->list.is_empty();
+	};
+
+	size_type size() const noexcept {
+		return this->list.size();
+	};
+
+	reference front() {
+		if (this->is_empty()) {
+			throw std::runtime_error("The list must not be empty.");
+		}
+		return this->list.front_node()->data;
+	};
+
+	reference back() {
+		if (this->is_empty()) {
+			throw std::runtime_error("The list must not be empty.");
+		}
+		return this->list.back_node()->data;
+	};
+
+	template <typename... Args>
+	DataNode& emplace_back(Args&&... args) {
+		DataNode& node = this->allocate_node(std::forward<Args>(args)...);
+		node.attach_to(this->list);
+		return node;
+	};
+
+	template <typename... Args>
+	DataNode& emplace_front(Args&&... args) {
+		DataNode& node = this->allocate_node(std::forward<Args>(args)...);
+		this->list.begin().attach_node_before(node);
+		return node;
+	};
+
+	// Constructs a value before the iterator's position and returns an
+	// iterator to it.
+	template <typename... Args>
+	iterator emplace(iterator pos, Args&&... args) {
+		if (pos.is_at_nullptr()) {
+			throw std::runtime_error("The iterator's current node must not be null.");
+		}
+		if (pos.is_before_the_start_no_null_check()) {
+			throw std::runtime_error("Cannot insert before this iterator if this iterator is before-the-start.");
+		}
+
+		DataNode& node = this->allocate_node(std::forward<Args>(args)...);
+		pos.attach_node_before(node);
+		return this->list.iterator_to(node);
+	};
+
+	// Frees the node at the iterator's position and returns an iterator to
+	// the node after it.
+	iterator erase(iterator pos) {
+		DataNode& node = list_type::node_at(pos);
+		if (!node.is_attached()) {
+			throw std::runtime_error("Cannot erase at an iterator that is not at an attached data node.");
+		}
+
+		++pos;
+		this->free_node(node);
+		return pos;
+	};
+
+	void pop_front() {
+		if (this->is_empty()) {
+			throw std::runtime_error("The list must not be empty.");
+		}
+		this->free_node(*(this->list.front_node()));
+	};
+
+	void pop_back() {
+		if (this->is_empty()) {
+			throw std::runtime_error("The list must not be empty.");
+		}
+		this->free_node(*(this->list.back_node()));
+	};
+
+	// Frees a node allocated by this list, wherever it is attached.
+	void dispose(DataNode& node) noexcept {
+		this->free_node(node);
+	};
+
+	void clear() noexcept {
+		while (DataNode* node = this->list.front_node()) {
+			this->free_node(*node);
+		}
+	};
+};
+
+#if defined(GOLDENROCKEFELLER_HAS_MEMORY_RESOURCE)
+namespace pmr {
+
+// An OwningNodeList that allocates from a std::pmr::memory_resource, such as
+// a std::pmr::monotonic_buffer_resource.
+template <typename T>
+using OwningNodeList = goldenrockefeller::OwningNodeList<T, std::pmr::polymorphic_allocator<T>>;
+
+} // namespace pmr
+#endif
+
+} // namespace goldenrockefeller
+
+#endif
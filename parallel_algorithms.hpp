@@ -0,0 +1,293 @@
+// MIT License
+
+// Copyright(c) 2021 Golden Rockefeller
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#ifndef GOLDENROCKEFELLER_PARALLEL_ALGORITHMS_HPP
+#define GOLDENROCKEFELLER_PARALLEL_ALGORITHMS_HPP
+
+#include <stdexcept>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <cstddef>
+
+#include "node_list.hpp"
+
+namespace goldenrockefeller {
+
+// Parallel algorithms over a NodeList. The list's iterators are only
+// bidirectional, so the list is first split into chunks of nearly equal
+// length in one sequential pass over the whole list, and the chunks are then
+// handed out to a local pool of threads, the calling thread included, which
+// is joined before the algorithm returns. Each algorithm also takes the chunk
+// starts of an earlier split, so that the pass is paid once for several
+// calls. The list must not be modified while an algorithm runs. If an
+// element function throws, the remaining chunks are skipped and the first
+// exception is rethrown in the calling thread.
+
+// The number of threads the algorithms use by default.
+inline std::size_t default_thread_count() noexcept {
+	std::size_t thread_count = std::thread::hardware_concurrency();
+	return thread_count ? thread_count : 1;
+}
+
+// Returns the first iterator of each chunk of the list, in order; a chunk
+// ends where the next one starts, and the last one at the end of the list.
+// The list is walked once: a boundary is kept every stride nodes, and when
+// twice the requested number of boundaries has been kept, every other one
+// is dropped and the stride doubles. An empty list has no chunks; a list of
+// n nodes has min(n, chunk_count) to 2 * chunk_count of them.
+template <typename List>
+std::vector<typename List::iterator> split_into_chunks(List& list, std::size_t chunk_count) {
+	if (chunk_count == 0) {
+		throw std::invalid_argument("The chunk count must not be zero.");
+	}
+
+	std::vector<typename List::iterator> chunk_starts;
+	chunk_starts.reserve(2 * chunk_count);
+
+	// The stride is a power of two, so a mask stands in for the division.
+	std::size_t stride{ 1 };
+	std::size_t position{ 0 };
+	typename List::iterator end = list.end();
+
+	for (typename List::iterator it = list.begin(); it != end; ++it, position++) {
+		if ((position & (stride - 1)) != 0) {
+			continue;
+		}
+
+		if (chunk_starts.size() == 2 * chunk_count) {
+			for (std::size_t i{ 0 }; i < chunk_count; i++) {
+				chunk_starts[i] = chunk_starts[2 * i];
+			}
+			chunk_starts.resize(chunk_count);
+			stride *= 2;
+
+			if ((position & (stride - 1)) != 0) {
+				continue;
+			}
+		}
+
+		chunk_starts.push_back(it);
+	}
+
+	return chunk_starts;
+}
+
+// Calls work(first, last, chunk_index) for every chunk given by the chunk
+// starts from split_into_chunks, on up to thread_count threads.
+template <typename Iterator, typename Work>
+void for_each_chunk(const std::vector<Iterator>& chunk_starts, Iterator end, Work work, std::size_t thread_count) {
+	if (thread_count == 0) {
+		throw std::invalid_argument("The thread count must not be zero.");
+	}
+
+	std::size_t chunk_count = chunk_starts.size();
+
+	std::atomic<std::size_t> next_chunk{ 0 };
+	std::atomic<bool> has_failed{ false };
+	std::exception_ptr failure;
+	std::mutex failure_mutex;
+
+	auto run = [&]() {
+		for (;;) {
+			std::size_t chunk = next_chunk.fetch_add(1, std::memory_order_relaxed);
+			if (chunk >= chunk_count || has_failed.load(std::memory_order_relaxed)) {
+				return;
+			}
+
+			try {
+				work(chunk_starts[chunk], chunk + 1 < chunk_count ? chunk_starts[chunk + 1] : end, chunk);
+			}
+			catch (...) {
+				std::lock_guard<std::mutex> guard(failure_mutex);
+				if (!has_failed.exchange(true, std::memory_order_relaxed)) {
+					failure = std::current_exception();
+				}
+			}
+		}
+	};
+
+	std::size_t worker_count = thread_count < chunk_count ? thread_count : chunk_count;
+	std::vector<std::thread> workers;
+
+	if (worker_count > 1) {
+		workers.reserve(worker_count - 1);
+		try {
+			for (std::size_t i{ 1 }; i < worker_count; i++) {
+				workers.emplace_back(run);
+			}
+		}
+		catch (const std::system_error&) {
+			// Fewer threads than asked for still finish every chunk.
+		}
+	}
+
+	run();
+
+	for (std::thread& worker : workers) {
+		worker.join();
+	}
+
+	if (failure) {
+		std::rethrow_exception(failure);
+	}
+}
+
+// A few chunks per thread even out uneven per-element work.
+template <typename List>
+std::vector<typename List::iterator> split_for_threads(List& list, std::size_t thread_count) {
+	if (thread_count == 0) {
+		throw std::invalid_argument("The thread count must not be zero.");
+	}
+	return split_into_chunks(list, 4 * thread_count);
+}
+
+// Calls func on the data of every node, for the chunks given by chunk_starts
+// from split_for_threads or split_into_chunks. The list must not have
+// changed since it was split.
+template <typename T, bool TaggedLinks, LinkMode Mode, typename Func>
+void parallel_for_each(
+	NodeList<T, TaggedLinks, Mode>& list,
+	const std::vector<typename NodeList<T, TaggedLinks, Mode>::iterator>& chunk_starts,
+	Func func,
+	std::size_t thread_count = default_thread_count()
+) {
+	using iterator = typename NodeList<T, TaggedLinks, Mode>::iterator;
+
+	for_each_chunk(
+		chunk_starts,
+		list.end(),
+		[&func](iterator first, iterator last, std::size_t) {
+			for (; first != last; ++first) {
+				func(*first);
+			}
+		},
+		thread_count
+	);
+}
+
+// Calls func on the data of every node. Each call splits the list first,
+// which walks the whole list on the calling thread; to run several
+// algorithms over an unchanged list, split it once with split_for_threads
+// and pass the chunk starts instead.
+template <typename T, bool TaggedLinks, LinkMode Mode, typename Func>
+void parallel_for_each(NodeList<T, TaggedLinks, Mode>& list, Func func, std::size_t thread_count = default_thread_count()) {
+	parallel_for_each(list, split_for_threads(list, thread_count), std::move(func), thread_count);
+}
+
+// Returns init combined with transform(data) for every node through reduce,
+// which must be associative, for the chunks given by chunk_starts. The
+// chunks' results are combined in list order, so reduce need not be
+// commutative. The list must not have changed since it was split.
+template <typename T, bool TaggedLinks, LinkMode Mode, typename U, typename Reduce, typename Transform>
+U parallel_transform_reduce(
+	NodeList<T, TaggedLinks, Mode>& list,
+	const std::vector<typename NodeList<T, TaggedLinks, Mode>::iterator>& chunk_starts,
+	U init,
+	Reduce reduce,
+	Transform transform,
+	std::size_t thread_count = default_thread_count()
+) {
+	using iterator = typename NodeList<T, TaggedLinks, Mode>::iterator;
+
+	// Each chunk's result is wrapped so that std::vector<bool> does not pack
+	// the results of different threads into the same word.
+	struct Partial {
+		U value;
+	};
+
+	std::vector<Partial> partials(chunk_starts.size(), Partial{ init });
+
+	for_each_chunk(
+		chunk_starts,
+		list.end(),
+		[&](iterator first, iterator last, std::size_t chunk) {
+			U partial = transform(*first);
+			for (++first; first != last; ++first) {
+				partial = reduce(std::move(partial), transform(*first));
+			}
+			partials[chunk].value = std::move(partial);
+		},
+		thread_count
+	);
+
+	for (Partial& partial : partials) {
+		init = reduce(std::move(init), std::move(partial.value));
+	}
+
+	return init;
+}
+
+// Returns init combined with transform(data) for every node through reduce,
+// which must be associative. Like parallel_for_each, each call splits the
+// list first.
+template <typename T, bool TaggedLinks, LinkMode Mode, typename U, typename Reduce, typename Transform>
+U parallel_transform_reduce(
+	NodeList<T, TaggedLinks, Mode>& list,
+	U init,
+	Reduce reduce,
+	Transform transform,
+	std::size_t thread_count = default_thread_count()
+) {
+	return parallel_transform_reduce(
+		list,
+		split_for_threads(list, thread_count),
+		std::move(init),
+		std::move(reduce),
+		std::move(transform),
+		thread_count
+	);
+}
+
+// Returns the number of nodes whose data satisfies the predicate, for the
+// chunks given by chunk_starts.
+template <typename T, bool TaggedLinks, LinkMode Mode, typename Predicate>
+std::size_t parallel_count_if(
+	NodeList<T, TaggedLinks, Mode>& list,
+	const std::vector<typename NodeList<T, TaggedLinks, Mode>::iterator>& chunk_starts,
+	Predicate pred,
+	std::size_t thread_count = default_thread_count()
+) {
+	return parallel_transform_reduce(
+		list,
+		chunk_starts,
+		std::size_t{ 0 },
+		[](std::size_t a, std::size_t b) { return a + b; },
+		[&pred](T& data) { return std::size_t{ pred(data) ? 1u : 0u }; },
+		thread_count
+	);
+}
+
+// Returns the number of nodes whose data satisfies the predicate.
+template <typename T, bool TaggedLinks, LinkMode Mode, typename Predicate>
+std::size_t parallel_count_if(NodeList<T, TaggedLinks, Mode>& list, Predicate pred, std::size_t thread_count = default_thread_count()) {
+	return parallel_count_if(list, split_for_threads(list, thread_count), std::move(pred), thread_count);
+}
+
+} // namespace goldenrockefeller
+
+#endif
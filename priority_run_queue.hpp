@@ -0,0 +1,343 @@
+// MIT License
+
+// Copyright(c) 2021 Golden Rockefeller
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef GOLDENROCKEFELLER_PRIORITY_RUN_QUEUE_HPP
+#define GOLDENROCKEFELLER_PRIORITY_RUN_QUEUE_HPP
+
+#include <stdexcept>
+#include <cstdint>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#include "node_list.hpp"
+
+namespace goldenrockefeller {
+
+// A multi-level run queue made of one NodeList per priority level and a
+// bitmap of the levels that may hold tasks. Level 0 has the highest priority.
+// Tasks are DataNodes: enqueuing attaches a task to the back of its level,
+// so changing the priority of a queued task is a single O(1) re-enqueue.
+//
+// The bitmap is kept up by enqueue and dequeue: enqueuing marks a level and
+// dequeuing its last task unmarks it. Tasks can also detach themselves (or be
+// destructed) while queued, so a set bit is only a hint. The const queries
+// skip a marked level that turns out to be empty, and the next dequeue that
+// passes it clears its bit.
+template <typename T, std::size_t Levels = 64>
+class PriorityRunQueue {
+
+	static_assert(Levels > 0, "PriorityRunQueue must have at least one level.");
+
+public:
+	using list_type = NodeList<T>;
+	using DataNode = typename list_type::DataNode;
+	using value_type = T;
+	using size_type = std::size_t;
+
+	static constexpr size_type level_count = Levels;
+
+private:
+	using word_type = std::uint64_t;
+
+	static constexpr size_type word_bits = 64;
+	static constexpr size_type word_count = (Levels + word_bits - 1) / word_bits;
+
+	list_type levels[Levels];
+	word_type bitmap[word_count];
+
+	// Deficit round robin state. current_level is Levels when no level is
+	// being served.
+	size_type quanta[Levels];
+	size_type deficits[Levels];
+	size_type current_level;
+
+	static size_type lowest_set_bit(word_type word) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+		return static_cast<size_type>(__builtin_ctzll(word));
+#elif defined(_MSC_VER) && defined(_M_X64)
+		unsigned long index;
+		_BitScanForward64(&index, word);
+		return static_cast<size_type>(index);
+#else
+		size_type index{ 0 };
+		while (!(word & 1u)) {
+			word >>= 1;
+			index++;
+		}
+		return index;
+#endif
+	}
+
+	void mark_level(size_type level) noexcept {
+		this->bitmap[level / word_bits] |= word_type{ 1 } << (level % word_bits);
+	}
+
+	void unmark_level(size_type level) noexcept {
+		this->bitmap[level / word_bits] &= ~(word_type{ 1 } << (level % word_bits));
+	}
+
+	// Returns the first marked level at or after the given level, or Levels.
+	size_type next_marked_level(size_type level) const noexcept {
+		size_type word_index = level / word_bits;
+		if (word_index >= word_count) {
+			return Levels;
+		}
+
+		word_type word = this->bitmap[word_index] & (~word_type{ 0 } << (level % word_bits));
+
+		while (!word) {
+			if (++word_index == word_count) {
+				return Levels;
+			}
+			word = this->bitmap[word_index];
+		}
+
+		return word_index * word_bits + lowest_set_bit(word);
+	}
+
+	// Returns the first non-empty level at or after the given level, or
+	// Levels.
+	size_type next_ready_level(size_type level) const noexcept {
+		for (level = this->next_marked_level(level); level < Levels; level = this->next_marked_level(level + 1)) {
+			if (!this->levels[level].is_empty()) {
+				return level;
+			}
+		}
+		return Levels;
+	}
+
+	// As next_ready_level, but also clears the bits of the empty levels it
+	// passes, which tasks that detached themselves left behind.
+	size_type take_ready_level(size_type level) noexcept {
+		for (level = this->next_marked_level(level); level < Levels; level = this->next_marked_level(level + 1)) {
+			if (!this->levels[level].is_empty()) {
+				return level;
+			}
+			this->unmark_level(level);
+			this->deficits[level] = 0;
+		}
+		return Levels;
+	}
+
+	// Detaches the first task of a non-empty level. If that empties the
+	// level, it is unmarked and, as in deficit round robin, loses its deficit.
+	DataNode* pop_task(size_type level) noexcept {
+		DataNode* task = this->levels[level].front_node();
+		task->detach();
+		if (this->levels[level].is_empty()) {
+			this->unmark_level(level);
+			this->deficits[level] = 0;
+		}
+		return task;
+	}
+
+	// Adds to every non-empty level the quanta of the rounds that would pass
+	// before the first task of any of them is covered by its deficit.
+	template <typename Cost>
+	void skip_rounds(Cost& cost) {
+		size_type rounds{ 0 };
+		bool is_first = true;
+
+		for (size_type level = this->next_ready_level(0); level < Levels; level = this->next_ready_level(level + 1)) {
+			const T& data = this->levels[level].front_node()->data;
+			size_type task_cost = static_cast<size_type>(cost(data));
+			if (task_cost <= this->deficits[level]) {
+				return;
+			}
+
+			size_type missing = task_cost - this->deficits[level];
+			size_type level_rounds = missing / this->quanta[level] + (missing % this->quanta[level] != 0);
+			if (is_first || level_rounds < rounds) {
+				rounds = level_rounds;
+				is_first = false;
+			}
+		}
+
+		// The last of the rounds is left to the visits themselves, which
+		// decide between the levels that it covers.
+		if (rounds <= 1) {
+			return;
+		}
+
+		for (size_type level = this->next_ready_level(0); level < Levels; level = this->next_ready_level(level + 1)) {
+			this->deficits[level] += (rounds - 1) * this->quanta[level];
+		}
+	}
+
+	void check_level(size_type level) const {
+		if (level >= Levels) {
+			throw std::out_of_range("The level must be less than the level count.");
+		}
+	}
+
+public:
+	PriorityRunQueue() noexcept : bitmap{}, current_level{ Levels } {
+		for (size_type level{ 0 }; level < Levels; level++) {
+			this->quanta[level] = 1;
+			this->deficits[level] = 0;
+		}
+	};
+
+	PriorityRunQueue(const PriorityRunQueue& obj) = delete;
+	PriorityRunQueue(PriorityRunQueue&& obj) = delete;
+	PriorityRunQueue& operator=(const PriorityRunQueue& obj) = delete;
+	PriorityRunQueue& operator=(PriorityRunQueue&& obj) = delete;
+
+	// Attaches the task to the back of the level, detaching it from any list
+	// (including another level) it is attached to.
+	void enqueue(DataNode& task, size_type level) {
+		this->check_level(level);
+		task.attach_to(this->levels[level]);
+		this->mark_level(level);
+	};
+
+	void change_priority(DataNode& task, size_type level) {
+		this->enqueue(task, level);
+	};
+
+	bool is_empty() const noexcept {
+		return this->next_ready_level(0) == Levels;
+	};
+
+	// Returns the highest-priority non-empty level, or level_count if the
+	// queue is empty.
+	size_type highest_level() const noexcept {
+		return this->next_ready_level(0);
+	};
+
+	list_type& level(size_type level) {
+		this->check_level(level);
+		return this->levels[level];
+	};
+
+	// Detaches and returns the first task of the highest-priority non-empty
+	// level, or null if the queue is empty.
+	DataNode* dequeue() noexcept {
+		size_type level = this->take_ready_level(0);
+		if (level == Levels) {
+			return nullptr;
+		}
+
+		return this->pop_task(level);
+	};
+
+	// Sets how much service a level receives per round in dequeue_fair.
+	void set_quantum(size_type level, size_type quantum) {
+		this->check_level(level);
+		if (quantum == 0) {
+			throw std::invalid_argument("The quantum must not be zero.");
+		}
+		this->quanta[level] = quantum;
+	};
+
+	// Deficit round robin across levels: the levels are visited in turn, and
+	// each visit adds the level's quantum to its deficit. Tasks are dequeued
+	// from the level, in FIFO order, while the deficit covers cost(task), so
+	// every level receives service in proportion to its quantum, measured in
+	// the units of cost. Rounds in which no level could be served are added
+	// in one step, so a cost much larger than the quanta does not make the
+	// call loop. The weighting is per level only: within a level, tasks are
+	// served in FIFO order whatever their cost, so tasks that need their own
+	// share belong on their own levels. Returns null if the queue is empty.
+	template <typename Cost>
+	DataNode* dequeue_fair(Cost cost) {
+		size_type level = this->current_level;
+
+		if (level >= Levels || this->levels[level].is_empty()) {
+			if (level < Levels) {
+				this->deficits[level] = 0;
+			}
+			level = this->take_ready_level(level < Levels ? level + 1 : 0);
+			if (level == Levels) {
+				level = this->take_ready_level(0);
+			}
+			if (level == Levels) {
+				this->current_level = Levels;
+				return nullptr;
+			}
+			this->deficits[level] += this->quanta[level];
+		}
+
+		size_type first_failed_level = Levels;
+		bool has_skipped = false;
+
+		for (;;) {
+			DataNode* task = this->levels[level].front_node();
+			size_type task_cost = static_cast<size_type>(cost(static_cast<const T&>(task->data)));
+
+			if (task_cost <= this->deficits[level]) {
+				this->deficits[level] -= task_cost;
+				this->current_level = level;
+				return this->pop_task(level);
+			}
+
+			// The level has used up its quantum for this round. If a whole
+			// round passes without service, the rounds before some level can
+			// be served are skipped, after which the loop ends within one more
+			// round.
+			if (first_failed_level == Levels) {
+				first_failed_level = level;
+			}
+			else if (level == first_failed_level && !has_skipped) {
+				this->skip_rounds(cost);
+				has_skipped = true;
+			}
+
+			size_type next_level = this->take_ready_level(level + 1);
+			if (next_level == Levels) {
+				next_level = this->take_ready_level(0);
+			}
+			level = next_level;
+			this->deficits[level] += this->quanta[level];
+		}
+	};
+
+	DataNode* dequeue_fair() {
+		return this->dequeue_fair([](const T&) { return size_type{ 1 }; });
+	};
+
+	void clear() noexcept {
+		for (size_type level{ 0 }; level < Levels; level++) {
+			this->levels[level].clear();
+			this->deficits[level] = 0;
+		}
+		for (size_type word_index{ 0 }; word_index < word_count; word_index++) {
+			this->bitmap[word_index] = 0;
+		}
+		this->current_level = Levels;
+	};
+};
+
+template <typename T, std::size_t Levels>
+constexpr typename PriorityRunQueue<T, Levels>::size_type PriorityRunQueue<T, Levels>::level_count;
+
+template <typename T, std::size_t Levels>
+constexpr typename PriorityRunQueue<T, Levels>::size_type PriorityRunQueue<T, Levels>::word_bits;
+
+template <typename T, std::size_t Levels>
+constexpr typename PriorityRunQueue<T, Levels>::size_type PriorityRunQueue<T, Levels>::word_count;
+
+} // namespace goldenrockefeller
+
+#endif
@@ -0,0 +1,476 @@
+// MIT License
+
+// Copyright(c) 2021 Golden Rockefeller
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef GOLDENROCKEFELLER_RCU_NODE_LIST_HPP
+#define GOLDENROCKEFELLER_RCU_NODE_LIST_HPP
+
+#include <stdexcept>
+#include <atomic>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <cstdint>
+
+#include "sync_primitives.hpp"
+
+#if !defined(__cpp_aligned_new)
+#error "RcuNodeList needs C++17 aligned new for its cache-line-aligned reader slots."
+#endif
+
+namespace goldenrockefeller {
+
+// A list for read-mostly data, in the style of RCU: readers traverse it with
+// acquire loads of the next links and never block, while writers serialize
+// on a mutex. A removed node keeps its next link, so a reader standing on it
+// can still walk on, and the node is only disposed of once every reader that
+// could have seen it has left its read-side critical section, as tracked by
+// epoch-based reclamation (Fraser, 2004).
+//
+// Unlike NodeList, the list owns the nodes attached to it: removed nodes, and
+// the nodes still attached when the list is destructed, are passed to the
+// list's disposer, which deletes them by default.
+//
+// Readers go through a Reader, which claims one of the reader slots allocated
+// at construction and is a BasicLockable for the read-side critical section.
+template <typename T>
+class RcuNodeList {
+
+public:
+	using value_type = T;
+	using size_type = std::size_t;
+	using epoch_type = std::uint64_t;
+
+	static constexpr size_type cache_line_size = 64;
+
+private:
+	class Link {
+	public:
+		std::atomic<Link*> next_link;
+		Link* prev_link;
+
+		Link() noexcept : next_link{ nullptr }, prev_link{ nullptr } {};
+
+		Link(const Link& link) = delete;
+		Link& operator=(const Link& link) = delete;
+	};
+
+public:
+	class DataNode : private Link {
+		friend class RcuNodeList;
+
+		// Writer-only state for nodes waiting to be disposed of.
+		DataNode* next_retired;
+		epoch_type retire_epoch;
+		bool is_linked;
+
+	public:
+		value_type data;
+
+		DataNode() : Link(), next_retired{ nullptr }, retire_epoch{ 0 }, is_linked{ false }, data{} {};
+
+		explicit DataNode(T data) : Link(), next_retired{ nullptr }, retire_epoch{ 0 }, is_linked{ false }, data{ data } {};
+
+		DataNode(const DataNode& node) = delete;
+		DataNode& operator=(const DataNode& node) = delete;
+
+		bool is_attached() const noexcept {
+			return this->is_linked;
+		};
+	};
+
+	using disposer_type = void (*)(DataNode*);
+
+	// Forward iteration for readers; valid only inside a read-side critical
+	// section.
+	class const_iterator {
+		const Link* current_link;
+
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using difference_type = std::ptrdiff_t;
+		using value_type = T;
+		using pointer = const T*;
+		using reference = const T&;
+
+		const_iterator() noexcept : current_link{ nullptr } {};
+		explicit const_iterator(const Link* link) noexcept : current_link(link) {};
+
+		reference operator*() const noexcept {
+			return static_cast<const DataNode*>(this->current_link)->data;
+		};
+
+		pointer operator->() const noexcept {
+			return &(static_cast<const DataNode*>(this->current_link)->data);
+		};
+
+		const_iterator& operator++() noexcept {
+			this->current_link = this->current_link->next_link.load(std::memory_order_acquire);
+			return *this;
+		};
+
+		const_iterator operator++(int) noexcept {
+			const_iterator it(*this);
+			++(*this);
+			return it;
+		};
+
+		bool operator==(const const_iterator& it) const noexcept {
+			return this->current_link == it.current_link;
+		};
+
+		bool operator!=(const const_iterator& it) const noexcept {
+			return this->current_link != it.current_link;
+		};
+	};
+
+private:
+	struct alignas(cache_line_size) ReaderSlot {
+		// The epoch the reader entered at, or zero outside critical sections.
+		std::atomic<epoch_type> epoch;
+		ClaimFlag is_claimed;
+
+		ReaderSlot() noexcept : epoch{ 0 }, is_claimed{} {};
+	};
+
+	// Retire this many nodes between reclamation attempts.
+	static constexpr size_type reclaim_threshold = 64;
+
+	Link head;
+	Link* tail;
+	disposer_type disposer;
+
+	std::mutex writer_mutex;
+	DataNode* oldest_retired;
+	DataNode* newest_retired;
+	size_type retired_since_reclaim;
+
+	alignas(cache_line_size) std::atomic<epoch_type> global_epoch;
+
+	std::unique_ptr<ReaderSlot[]> slots;
+	size_type slot_count;
+
+	static void delete_node(DataNode* node) {
+		delete node;
+	}
+
+	static Link* link_of(DataNode* node) noexcept {
+		return static_cast<Link*>(node);
+	}
+
+	static DataNode* node_of(Link* link) noexcept {
+		return static_cast<DataNode*>(link);
+	}
+
+	// Writer only. Links the node in after the given link.
+	void link_after(Link* prev, DataNode& node) {
+		if (node.is_linked || node.next_retired || node.retire_epoch) {
+			throw std::invalid_argument("The node must not be attached or retired.");
+		}
+
+		Link* link = link_of(&node);
+		Link* next = prev->next_link.load(std::memory_order_relaxed);
+
+		link->next_link.store(next, std::memory_order_relaxed);
+		link->prev_link = prev;
+
+		// Publishes the node, with its data and next link, to readers.
+		prev->next_link.store(link, std::memory_order_release);
+
+		if (next) {
+			next->prev_link = link;
+		}
+		else {
+			this->tail = link;
+		}
+
+		node.is_linked = true;
+	}
+
+	// Writer only. Unlinks the node, leaving its own next link intact for
+	// in-flight readers, and queues it for disposal.
+	void unlink_and_retire(DataNode& node) noexcept {
+		Link* link = link_of(&node);
+		Link* prev = link->prev_link;
+		Link* next = link->next_link.load(std::memory_order_relaxed);
+
+		prev->next_link.store(next, std::memory_order_release);
+
+		if (next) {
+			next->prev_link = prev;
+		}
+		else {
+			this->tail = prev;
+		}
+
+		link->prev_link = nullptr;
+		node.is_linked = false;
+
+		// Readers that can still reach the node entered at or before the
+		// current epoch.
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		node.retire_epoch = this->global_epoch.load(std::memory_order_relaxed);
+
+		if (this->newest_retired) {
+			this->newest_retired->next_retired = &node;
+		}
+		else {
+			this->oldest_retired = &node;
+		}
+		this->newest_retired = &node;
+
+		if (++(this->retired_since_reclaim) >= reclaim_threshold) {
+			this->reclaim_retired();
+		}
+	}
+
+	// Advances the global epoch if every reader inside a critical section
+	// has entered at the current epoch. Returns the resulting epoch.
+	epoch_type try_advance_epoch() noexcept {
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		epoch_type epoch = this->global_epoch.load(std::memory_order_relaxed);
+
+		for (size_type i{ 0 }; i < this->slot_count; i++) {
+			epoch_type reader_epoch = this->slots[i].epoch.load(std::memory_order_acquire);
+			if (reader_epoch && reader_epoch != epoch) {
+				return epoch;
+			}
+		}
+
+		this->global_epoch.store(epoch + 1, std::memory_order_release);
+		return epoch + 1;
+	}
+
+	// Writer only. Disposes of the retired nodes that no reader can reach:
+	// those retired two or more epochs ago.
+	size_type reclaim_retired() noexcept {
+		this->retired_since_reclaim = 0;
+
+		this->try_advance_epoch();
+		epoch_type epoch = this->try_advance_epoch();
+
+		size_type reclaimed{ 0 };
+
+		while (this->oldest_retired && this->oldest_retired->retire_epoch + 2 <= epoch) {
+			DataNode* node = this->oldest_retired;
+			this->oldest_retired = node->next_retired;
+			if (!this->oldest_retired) {
+				this->newest_retired = nullptr;
+			}
+
+			node->next_retired = nullptr;
+			node->retire_epoch = 0;
+			link_of(node)->next_link.store(nullptr, std::memory_order_relaxed);
+			this->disposer(node);
+			reclaimed++;
+		}
+
+		return reclaimed;
+	}
+
+public:
+	class Reader {
+		RcuNodeList& owner;
+		ReaderSlot* slot;
+
+	public:
+		// Throws std::length_error if every reader slot is claimed.
+		explicit Reader(RcuNodeList& owner) :
+			owner(owner),
+			slot{ &claim_first_slot(owner.slots.get(), owner.slot_count, "Every reader slot of the list is claimed.") }
+		{};
+
+		~Reader() {
+			this->slot->epoch.store(0, std::memory_order_release);
+			this->slot->is_claimed.release();
+		};
+
+		Reader(const Reader& obj) = delete;
+		Reader(Reader&& obj) = delete;
+		Reader& operator=(const Reader& obj) = delete;
+		Reader& operator=(Reader&& obj) = delete;
+
+		// Enters a read-side critical section. Critical sections do not nest.
+		void lock() noexcept {
+			this->slot->epoch.store(this->owner.global_epoch.load(std::memory_order_relaxed), std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+		};
+
+		void unlock() noexcept {
+			this->slot->epoch.store(0, std::memory_order_release);
+		};
+
+		// Calls func on the data of every node inside one critical section.
+		template <typename Func>
+		void for_each(Func func) {
+			std::lock_guard<Reader> guard(*this);
+			for (const T& data : this->owner) {
+				func(data);
+			}
+		};
+	};
+
+	explicit RcuNodeList(size_type reader_slot_count = 64, disposer_type disposer = &delete_node) :
+		head{},
+		tail{ &(this->head) },
+		disposer{ disposer },
+		writer_mutex{},
+		oldest_retired{ nullptr },
+		newest_retired{ nullptr },
+		retired_since_reclaim{ 0 },
+		global_epoch{ 1 },
+		slots{},
+		slot_count{ reader_slot_count }
+	{
+		if (reader_slot_count == 0) {
+			throw std::invalid_argument("The reader slot count must not be zero.");
+		}
+		if (!disposer) {
+			throw std::invalid_argument("The disposer must not be null.");
+		}
+
+		this->slots.reset(new ReaderSlot[reader_slot_count]);
+	};
+
+	RcuNodeList(const RcuNodeList& obj) = delete;
+	RcuNodeList(RcuNodeList&& obj) = delete;
+	RcuNodeList& operator=(const RcuNodeList& obj) = delete;
+	RcuNodeList& operator=(RcuNodeList&& obj) = delete;
+
+	// Every Reader must be gone. Disposes of the retired and attached nodes.
+	~RcuNodeList() {
+		while (DataNode* node = this->oldest_retired) {
+			this->oldest_retired = node->next_retired;
+			this->disposer(node);
+		}
+
+		Link* link = this->head.next_link.load(std::memory_order_relaxed);
+		while (link) {
+			Link* next = link->next_link.load(std::memory_order_relaxed);
+			this->disposer(node_of(link));
+			link = next;
+		}
+	};
+
+	// Reader iteration; valid only inside a read-side critical section.
+	const_iterator begin() const noexcept {
+		return const_iterator(this->head.next_link.load(std::memory_order_acquire));
+	};
+
+	const_iterator end() const noexcept {
+		return const_iterator();
+	};
+
+	// Writer operations. They serialize on the writer mutex and never wait
+	// for readers.
+
+	void push_back(DataNode& node) {
+		std::lock_guard<std::mutex> guard(this->writer_mutex);
+		this->link_after(this->tail, node);
+	};
+
+	void push_front(DataNode& node) {
+		std::lock_guard<std::mutex> guard(this->writer_mutex);
+		this->link_after(&(this->head), node);
+	};
+
+	// Links the node after pos, which must be attached to this list.
+	void insert_after(DataNode& pos, DataNode& node) {
+		std::lock_guard<std::mutex> guard(this->writer_mutex);
+		if (!pos.is_linked) {
+			throw std::invalid_argument("The position must be attached.");
+		}
+		this->link_after(link_of(&pos), node);
+	};
+
+	// Unlinks a node of this list; it is disposed of once no reader can
+	// reach it. The caller must not touch the node afterwards.
+	void remove(DataNode& node) {
+		std::lock_guard<std::mutex> guard(this->writer_mutex);
+		if (!node.is_linked) {
+			throw std::invalid_argument("The node must be attached.");
+		}
+		this->unlink_and_retire(node);
+	};
+
+	// Removes every node whose data satisfies the predicate. Returns the
+	// number of removed nodes.
+	template <typename Predicate>
+	size_type remove_if(Predicate pred) {
+		std::lock_guard<std::mutex> guard(this->writer_mutex);
+		size_type removed{ 0 };
+
+		Link* link = this->head.next_link.load(std::memory_order_relaxed);
+		while (link) {
+			Link* next = link->next_link.load(std::memory_order_relaxed);
+			DataNode* node = node_of(link);
+			if (pred(static_cast<const T&>(node->data))) {
+				this->unlink_and_retire(*node);
+				removed++;
+			}
+			link = next;
+		}
+
+		return removed;
+	};
+
+	// Disposes of the removed nodes that no reader can reach any more,
+	// without waiting. Returns the number of disposed nodes.
+	size_type try_reclaim() {
+		std::lock_guard<std::mutex> guard(this->writer_mutex);
+		return this->reclaim_retired();
+	};
+
+	// Waits until every reader that might see a removed node has left its
+	// critical section, then disposes of every removed node. Must not be
+	// called from inside a read-side critical section.
+	void synchronize() {
+		std::lock_guard<std::mutex> guard(this->writer_mutex);
+
+		unsigned spins{ 0 };
+		while (this->oldest_retired) {
+			if (!this->reclaim_retired() && ++spins > 64) {
+				std::this_thread::yield();
+			}
+		}
+	};
+
+	// Writer-side size; exact while no other writer is running.
+	size_type size() {
+		std::lock_guard<std::mutex> guard(this->writer_mutex);
+		size_type size{ 0 };
+		for (Link* link = this->head.next_link.load(std::memory_order_relaxed); link; link = link->next_link.load(std::memory_order_relaxed)) {
+			size++;
+		}
+		return size;
+	};
+};
+
+template <typename T>
+constexpr typename RcuNodeList<T>::size_type RcuNodeList<T>::cache_line_size;
+
+template <typename T>
+constexpr typename RcuNodeList<T>::size_type RcuNodeList<T>::reclaim_threshold;
+
+} // namespace goldenrockefeller
+
+#endif
@@ -0,0 +1,277 @@
+// MIT License
+
+// Copyright(c) 2021 Golden Rockefeller
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef GOLDENROCKEFELLER_SHARDED_NODE_LIST_HPP
+#define GOLDENROCKEFELLER_SHARDED_NODE_LIST_HPP
+
+#include <stdexcept>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "node_list.hpp"
+#include "sync_primitives.hpp"
+
+#if !defined(__cpp_aligned_new)
+#error "ShardedNodeList needs C++17 aligned new for its cache-line-aligned shards."
+#endif
+
+namespace goldenrockefeller {
+
+// A list split into shards, each a NodeList with its own lock and count on
+// its own cache lines. Each thread attaches to its own shard, chosen
+// round-robin the first time the thread uses any sharded list, so threads
+// that only attach never contend. Nodes remember their shard, so any thread
+// can detach them.
+//
+// Iteration visits the shards in turn, locking one at a time, so it does not
+// see a consistent snapshot of the whole list.
+template <typename T>
+class ShardedNodeList {
+
+public:
+	using list_type = NodeList<T>;
+	using value_type = T;
+	using size_type = std::size_t;
+
+	static constexpr size_type cache_line_size = 64;
+
+	// A DataNode that records which list and shard it is attached to.
+	// Destructing a node detaches it under its shard's lock.
+	//
+	// The list and shard are only changed under the shard's lock, but are
+	// read before it is taken, so they are atomic; detach checks them again
+	// once it holds the lock, in case clear got there first. Clearing the
+	// list releases the node's links along with it, so that a thread that
+	// then sees the node detached can attach it elsewhere.
+	class DataNode : public list_type::DataNode {
+		friend class ShardedNodeList;
+
+		std::atomic<ShardedNodeList*> owner;
+		std::atomic<size_type> shard;
+
+		// Nodes are attached and detached through the sharded list, under the
+		// shard's lock.
+		using list_type::DataNode::attach_to;
+		using list_type::DataNode::attach_before;
+		using list_type::DataNode::attach_after;
+		using list_type::DataNode::detach;
+
+	public:
+		DataNode() noexcept : list_type::DataNode(), owner{ nullptr }, shard{ 0 } {};
+
+		explicit DataNode(T data) noexcept : list_type::DataNode(data), owner{ nullptr }, shard{ 0 } {};
+
+		~DataNode() {
+			if (ShardedNodeList* owner_list = this->owner.load(std::memory_order_acquire)) {
+				owner_list->detach(*this);
+			}
+		};
+
+		// Returns the sharded list the node is attached to, or null.
+		ShardedNodeList* sharded_list() const noexcept {
+			return this->owner.load(std::memory_order_acquire);
+		};
+	};
+
+private:
+	struct alignas(cache_line_size) Shard {
+		SpinLock lock;
+		std::atomic<size_type> count;
+		list_type list;
+
+		Shard() noexcept : lock{}, count{ 0 }, list{} {};
+	};
+
+	std::unique_ptr<Shard[]> shards;
+	size_type shard_count;
+
+	static size_type thread_index() noexcept {
+		static std::atomic<size_type> next_index{ 0 };
+		static thread_local size_type index = next_index.fetch_add(1, std::memory_order_relaxed);
+		return index;
+	}
+
+	void check_shard(size_type shard) const {
+		if (shard >= this->shard_count) {
+			throw std::out_of_range("The shard must be less than the shard count.");
+		}
+	}
+
+public:
+	explicit ShardedNodeList(size_type shard_count = std::thread::hardware_concurrency()) :
+		shards{},
+		shard_count{ shard_count ? shard_count : 1 }
+	{
+		this->shards.reset(new Shard[this->shard_count]);
+	};
+
+	ShardedNodeList(const ShardedNodeList& obj) = delete;
+	ShardedNodeList(ShardedNodeList&& obj) = delete;
+	ShardedNodeList& operator=(const ShardedNodeList& obj) = delete;
+	ShardedNodeList& operator=(ShardedNodeList&& obj) = delete;
+
+	// The remaining nodes are detached; they must not be detached or
+	// destructed concurrently.
+	~ShardedNodeList() {
+		this->clear();
+	};
+
+	size_type get_shard_count() const noexcept {
+		return this->shard_count;
+	};
+
+	// The shard that the calling thread attaches to.
+	size_type local_shard() const noexcept {
+		return thread_index() % this->shard_count;
+	};
+
+	// Attaches the node to the back of the calling thread's shard, detaching
+	// it first if it is attached to a sharded list.
+	void attach(DataNode& node) {
+		this->attach_to_shard(node, this->local_shard());
+	};
+
+	void attach_to_shard(DataNode& node, size_type shard) {
+		this->check_shard(shard);
+
+		if (ShardedNodeList* owner_list = node.owner.load(std::memory_order_acquire)) {
+			owner_list->detach(node);
+		}
+
+		Shard& target = this->shards[shard];
+		std::lock_guard<SpinLock> guard(target.lock);
+		node.attach_to(target.list);
+		node.owner.store(this, std::memory_order_release);
+		node.shard.store(shard, std::memory_order_relaxed);
+		target.count.store(target.count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+	};
+
+	// Detaches the node from its shard. Does nothing if the node is not
+	// attached to this list, including when clear detaches it concurrently.
+	void detach(DataNode& node) noexcept {
+		while (node.owner.load(std::memory_order_acquire) == this) {
+			size_type shard = node.shard.load(std::memory_order_relaxed);
+			Shard& owner_shard = this->shards[shard];
+			std::lock_guard<SpinLock> guard(owner_shard.lock);
+
+			if (
+				node.owner.load(std::memory_order_acquire) == this
+				&& node.shard.load(std::memory_order_relaxed) == shard
+			) {
+				node.detach();
+				node.owner.store(nullptr, std::memory_order_release);
+				owner_shard.count.store(owner_shard.count.load(std::memory_order_relaxed) - 1, std::memory_order_relaxed);
+				return;
+			}
+		}
+	};
+
+	// The sum of the shards' counts, read without locking.
+	size_type size_estimate() const noexcept {
+		size_type size{ 0 };
+		for (size_type i{ 0 }; i < this->shard_count; i++) {
+			size += this->shards[i].count.load(std::memory_order_relaxed);
+		}
+		return size;
+	};
+
+	// The exact size, read with every shard locked at once.
+	size_type size() noexcept {
+		for (size_type i{ 0 }; i < this->shard_count; i++) {
+			this->shards[i].lock.lock();
+		}
+
+		size_type size{ 0 };
+		for (size_type i{ 0 }; i < this->shard_count; i++) {
+			size += this->shards[i].count.load(std::memory_order_relaxed);
+		}
+
+		for (size_type i{ this->shard_count }; i > 0; i--) {
+			this->shards[i - 1].lock.unlock();
+		}
+
+		return size;
+	};
+
+	bool is_empty_estimate() const noexcept {
+		return this->size_estimate() == 0;
+	};
+
+	// Calls func on the data of every node, one shard at a time, with that
+	// shard locked. func must not attach or detach nodes of this list.
+	template <typename Func>
+	void for_each(Func func) {
+		for (size_type i{ 0 }; i < this->shard_count; i++) {
+			Shard& shard = this->shards[i];
+			std::lock_guard<SpinLock> guard(shard.lock);
+			for (T& data : shard.list) {
+				func(data);
+			}
+		}
+	};
+
+	// Moves every node to one plain NodeList, shard by shard, and returns it.
+	// This is O(n), as every node must forget its shard.
+	// The nodes no longer belong to this list, so detaching them is up to
+	// the caller.
+	list_type collect() {
+		list_type collected;
+
+		for (size_type i{ 0 }; i < this->shard_count; i++) {
+			Shard& shard = this->shards[i];
+			std::lock_guard<SpinLock> guard(shard.lock);
+
+			while (typename list_type::DataNode* node = shard.list.front_node()) {
+				node->attach_to(collected);
+				static_cast<DataNode*>(node)->owner.store(nullptr, std::memory_order_release);
+			}
+
+			shard.count.store(0, std::memory_order_relaxed);
+		}
+
+		return collected;
+	};
+
+	// Detaches every node.
+	void clear() noexcept {
+		for (size_type i{ 0 }; i < this->shard_count; i++) {
+			Shard& shard = this->shards[i];
+			std::lock_guard<SpinLock> guard(shard.lock);
+
+			while (typename list_type::DataNode* node = shard.list.front_node()) {
+				node->detach();
+				static_cast<DataNode*>(node)->owner.store(nullptr, std::memory_order_release);
+			}
+
+			shard.count.store(0, std::memory_order_relaxed);
+		}
+	};
+};
+
+template <typename T>
+constexpr typename ShardedNodeList<T>::size_type ShardedNodeList<T>::cache_line_size;
+
+} // namespace goldenrockefeller
+
+#endif
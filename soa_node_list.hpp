@@ -0,0 +1,515 @@
+// MIT License
+
+// Copyright(c) 2021 Golden Rockefeller
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef GOLDENROCKEFELLER_SOA_NODE_LIST_HPP
+#define GOLDENROCKEFELLER_SOA_NODE_LIST_HPP
+
+#include <stdexcept>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace goldenrockefeller {
+
+// A structure-of-arrays variant of NodeList. The links of every node live in
+// one dense array and the payloads live in a parallel array, so a traversal
+// only touches the link array until an iterator is dereferenced.
+//
+// The list owns the storage of its nodes. A DataNode is a handle to a slot in
+// that storage; it can only be attached to the list that created it, and the
+// slot is released when the handle is destructed. Handles must not outlive
+// their list.
+template <typename T>
+class SoaNodeList {
+
+public:
+	using value_type = T;
+	using allocator_type = std::allocator<value_type>;
+	using reference = value_type&;
+	using const_reference = const value_type&;
+	using pointer = typename std::allocator_traits<allocator_type>::pointer;
+	using const_pointer = typename std::allocator_traits<allocator_type>::const_pointer;
+	using size_type = std::size_t;
+	using difference_type = std::ptrdiff_t;
+
+	// Index of a missing link, the equivalent of a null Node pointer.
+	static constexpr size_type npos = static_cast<size_type>(-1);
+
+private:
+	struct Link {
+		size_type next_node;
+		size_type prev_node;
+	};
+
+	// Slots 0 and 1 of the link array hold the sentinels; the payload of link
+	// slot i is stored at payloads[i - sentinel_count].
+	static constexpr size_type before_start_node = 0;
+	static constexpr size_type past_end_node = 1;
+	static constexpr size_type sentinel_count = 2;
+
+	std::vector<Link> links;
+	std::vector<value_type> payloads;
+	size_type free_node;
+
+	void link_before(size_type node, size_type other_node) noexcept {
+		Link* links = this->links.data();
+		size_type prev_node = links[other_node].prev_node;
+
+		links[node].next_node = other_node;
+		links[node].prev_node = prev_node;
+		links[prev_node].next_node = node;
+		links[other_node].prev_node = node;
+	}
+
+	void link_after(size_type node, size_type other_node) noexcept {
+		Link* links = this->links.data();
+		size_type next_node = links[other_node].next_node;
+
+		links[node].next_node = next_node;
+		links[node].prev_node = other_node;
+		links[next_node].prev_node = node;
+		links[other_node].next_node = node;
+	}
+
+	void unlink(size_type node) noexcept {
+		Link* links = this->links.data();
+		size_type next_node = links[node].next_node;
+		size_type prev_node = links[node].prev_node;
+
+		if (prev_node != npos) {
+			links[prev_node].next_node = next_node;
+		}
+		if (next_node != npos) {
+			links[next_node].prev_node = prev_node;
+		}
+
+		links[node].next_node = npos;
+		links[node].prev_node = npos;
+	}
+
+	template <typename... Args>
+	size_type acquire_node(Args&&... args) {
+		if (this->free_node != npos) {
+			size_type node = this->free_node;
+			this->payloads[node - sentinel_count] = value_type(std::forward<Args>(args)...);
+			this->free_node = this->links[node].next_node;
+			this->links[node].next_node = npos;
+			return node;
+		}
+
+		// The two arrays must grow together, so the payload is taken back if
+		// the link array cannot grow.
+		this->payloads.emplace_back(std::forward<Args>(args)...);
+		try {
+			this->links.push_back(Link{ npos, npos });
+		}
+		catch (...) {
+			this->payloads.pop_back();
+			throw;
+		}
+		return this->links.size() - 1;
+	}
+
+	// Frees the resources of a released payload by resetting it to a
+	// default-constructed value. A payload that cannot be reset without
+	// throwing keeps its value until its slot is reused.
+	void reset_payload(size_type node, std::true_type) noexcept {
+		this->payloads[node - sentinel_count] = value_type();
+	}
+
+	void reset_payload(size_type, std::false_type) noexcept {}
+
+	void release_node(size_type node) noexcept {
+		this->unlink(node);
+		this->reset_payload(
+			node,
+			std::integral_constant<
+				bool,
+				std::is_nothrow_default_constructible<value_type>::value
+				&& std::is_nothrow_move_assignable<value_type>::value
+			>()
+		);
+		this->links[node].next_node = this->free_node;
+		this->free_node = node;
+	}
+
+public:
+	class DataNode {
+		SoaNodeList* list;
+		size_type node;
+
+		friend class SoaNodeList;
+
+	public:
+		explicit DataNode(SoaNodeList& list) : list{ &list }, node{ list.acquire_node() } {};
+
+		DataNode(SoaNodeList& list, T data) : list{ &list }, node{ list.acquire_node(std::move(data)) } {};
+
+		~DataNode() {
+			if (this->list) {
+				this->list->release_node(this->node);
+			}
+		};
+
+		DataNode(const DataNode& node) = delete;
+
+		// Handles are only indices, so moving one does not touch the list.
+		DataNode(DataNode&& node) noexcept : list{ node.list }, node{ node.node } {
+			node.list = nullptr;
+		};
+
+		DataNode& operator=(const DataNode& node) = delete;
+		DataNode& operator=(DataNode&& node) = delete;
+
+		T& data() {
+			if (!this->list) {
+				throw std::runtime_error("The node handle must not be moved-from.");
+			}
+			return this->list->payloads[this->node - sentinel_count];
+		}
+
+		const T& data() const {
+			if (!this->list) {
+				throw std::runtime_error("The node handle must not be moved-from.");
+			}
+			return this->list->payloads[this->node - sentinel_count];
+		}
+
+		bool is_attached() const noexcept {
+			if (!this->list) {
+				return false;
+			}
+			const Link& link = this->list->links[this->node];
+			return link.next_node != npos && link.prev_node != npos;
+		}
+
+		void attach_to(SoaNodeList& list) {
+			if (this->list != &list) {
+				throw std::invalid_argument("The node can only attach to the list that owns its storage.");
+			}
+
+			this->list->unlink(this->node);
+			this->list->link_before(this->node, past_end_node);
+		};
+
+		void attach_before(const DataNode& node) {
+			if (!this->list || this->list != node.list) {
+				throw std::invalid_argument("The other node must belong to the same list.");
+			}
+
+			if (!node.is_attached()) {
+				throw std::invalid_argument("The other node must be attached.");
+			}
+
+			if (&node == this) {
+				return;
+			}
+
+			this->list->unlink(this->node);
+			this->list->link_before(this->node, node.node);
+		};
+
+		void attach_after(const DataNode& node) {
+			if (!this->list || this->list != node.list) {
+				throw std::invalid_argument("The other node must belong to the same list.");
+			}
+
+			if (!node.is_attached()) {
+				throw std::invalid_argument("The other node must be attached.");
+			}
+
+			if (&node == this) {
+				return;
+			}
+
+			this->list->unlink(this->node);
+			this->list->link_after(this->node, node.node);
+		};
+
+		void detach() noexcept {
+			if (this->list) {
+				this->list->unlink(this->node);
+			}
+		};
+
+		operator T() const {
+			return this->data();
+		}
+	};
+
+	template <typename Type>
+	class base_iterator
+	{
+		template <typename OtherType>
+		friend class base_iterator;
+
+	protected:
+		using list_pointer = typename std::conditional<
+			std::is_const<Type>::value,
+			const SoaNodeList*,
+			SoaNodeList*
+		>::type;
+
+		list_pointer list;
+		size_type current_node;
+
+		const Link& current_link() const noexcept {
+			return this->list->links[this->current_node];
+		}
+
+	public:
+		using iterator_category = std::bidirectional_iterator_tag;
+		using difference_type = std::ptrdiff_t;
+		using value_type = Type;
+		using pointer = Type*;
+		using reference = Type&;
+
+		base_iterator() noexcept : list{ nullptr }, current_node{ npos } {};
+		base_iterator(list_pointer list, size_type starting_node) noexcept :
+			list{ list },
+			current_node{ starting_node }
+		{};
+
+		bool is_at_nullptr() const noexcept {
+			return !this->list || this->current_node == npos;
+		}
+
+		bool is_at_datanode_no_null_check() const noexcept {
+			return this->current_node >= sentinel_count;
+		}
+
+		bool is_at_datanode() const {
+			if (this->is_at_nullptr()) {
+				throw std::runtime_error("The iterator's current node must not be null.");
+			}
+			return this->is_at_datanode_no_null_check();
+		}
+
+		bool is_past_the_end_no_null_check() const noexcept {
+			return this->current_link().next_node == npos && this->current_link().prev_node != npos;
+		}
+
+		bool is_past_the_end() const {
+			if (this->is_at_nullptr()) {
+				throw std::runtime_error("The iterator's current node must not be null.");
+			}
+			return this->is_past_the_end_no_null_check();
+		}
+
+		bool is_before_the_start_no_null_check() const noexcept {
+			return this->current_link().prev_node == npos && this->current_link().next_node != npos;
+		}
+
+		bool is_before_the_start() const {
+			if (this->is_at_nullptr()) {
+				throw std::runtime_error("The iterator's current node must not be null.");
+			}
+			return this->is_before_the_start_no_null_check();
+		}
+
+		base_iterator& operator++() {
+			if (this->is_at_nullptr()) {
+				throw std::runtime_error("The iterator's current node must not be null.");
+			}
+			if (this->is_past_the_end_no_null_check()) {
+				throw std::runtime_error("Cannot increment iterator that is past-the-end.");
+			}
+
+			this->current_node = this->current_link().next_node;
+
+			return *this;
+		}
+
+		base_iterator& operator--() {
+			if (this->is_at_nullptr()) {
+				throw std::runtime_error("The iterator's current node must not be null.");
+			}
+			if (this->is_before_the_start_no_null_check()) {
+				throw std::runtime_error("Cannot decrement iterator that is before-the-start.");
+			}
+
+			this->current_node = this->current_link().prev_node;
+
+			return *this;
+		}
+
+		base_iterator operator++(int) {
+			base_iterator it(*this);
+			++(*this);
+			return it;
+		}
+
+		base_iterator operator--(int) {
+			base_iterator it(*this);
+			--(*this);
+			return it;
+		}
+
+		reference operator*() const {
+			if (this->is_at_nullptr()) {
+				throw std::runtime_error("The iterator's current node must not be null.");
+			}
+			if (!this->is_at_datanode_no_null_check()) {
+				throw std::runtime_error("Cannot dereference iterator that is not at data node");
+			}
+
+			return this->list->payloads[this->current_node - sentinel_count];
+		};
+
+		pointer operator->() const {
+			return &(**this);
+		};
+
+		template<typename OtherType>
+		bool operator==(const base_iterator<OtherType>& it) const noexcept {
+			// Invalid iterators are never equal.
+			return (
+				this->list == it.list
+				&& this->current_node == it.current_node
+				&& !this->is_at_nullptr()
+			);
+		}
+
+		template<typename OtherType>
+		bool operator!=(const base_iterator<OtherType>& it) const noexcept {
+			return !(*this == it);
+		}
+
+		operator base_iterator<const value_type>() const noexcept
+		{
+			return base_iterator<const value_type>(this->list, this->current_node);
+		}
+	};
+
+	using iterator = base_iterator<value_type>;
+	using const_iterator = base_iterator<const value_type>;
+	using reverse_iterator = std::reverse_iterator<iterator>;
+	using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+	SoaNodeList() :
+		links{ Link{ past_end_node, npos }, Link{ npos, before_start_node } },
+		payloads{},
+		free_node{ npos }
+	{};
+
+	SoaNodeList(const SoaNodeList& obj) = delete;
+	SoaNodeList(SoaNodeList&& obj) = delete;
+	SoaNodeList& operator=(const SoaNodeList& obj) = delete;
+	SoaNodeList& operator=(SoaNodeList&& obj) = delete;
+
+	// Reserves storage for the given number of nodes so that creating them
+	// does not reallocate the link and payload arrays.
+	void reserve(size_type capacity) {
+		this->links.reserve(capacity + sentinel_count);
+		this->payloads.reserve(capacity);
+	}
+
+	iterator begin() noexcept {
+		return iterator(this, this->links[before_start_node].next_node);
+	};
+	const_iterator begin() const noexcept {
+		return const_iterator(this, this->links[before_start_node].next_node);
+	};
+	const_iterator cbegin() const noexcept {
+		return this->begin();
+	};
+	iterator end() noexcept {
+		return iterator(this, past_end_node);
+	};
+	const_iterator end() const noexcept {
+		return const_iterator(this, past_end_node);
+	};
+	const_iterator cend() const noexcept {
+		return this->end();
+	};
+
+	reverse_iterator rbegin() noexcept {
+		return reverse_iterator(this->end());
+	};
+	const_reverse_iterator rbegin() const noexcept {
+		return const_reverse_iterator(this->end());
+	};
+	const_reverse_iterator crbegin() const noexcept {
+		return this->rbegin();
+	};
+	reverse_iterator rend() noexcept {
+		return reverse_iterator(this->begin());
+	};
+	const_reverse_iterator rend() const noexcept {
+		return const_reverse_iterator(this->begin());
+	};
+	const_reverse_iterator crend() const noexcept {
+		return this->rend();
+	};
+
+	bool is_empty() const noexcept {
+		return this->links[before_start_node].next_node == past_end_node;
+	};
+
+	size_type size() const noexcept {
+		size_type size{ 0 };
+		const Link* links = this->links.data();
+		size_type node{ links[before_start_node].next_node };
+
+		while (node != past_end_node) {
+			node = links[node].next_node;
+			size++;
+		}
+
+		return size;
+	};
+
+	void clear() noexcept {
+		Link* links = this->links.data();
+		size_type node{ before_start_node };
+
+		// Manually detach all nodes in the list.
+		while (node != npos) {
+			size_type next_node = links[node].next_node;
+			links[node].next_node = npos;
+			links[node].prev_node = npos;
+			node = next_node;
+		}
+
+		// Reattach this list's past-the-end and before-the-start nodes.
+		links[before_start_node].next_node = past_end_node;
+		links[past_end_node].prev_node = before_start_node;
+	};
+};
+
+template <typename T>
+constexpr typename SoaNodeList<T>::size_type SoaNodeList<T>::npos;
+
+template <typename T>
+constexpr typename SoaNodeList<T>::size_type SoaNodeList<T>::before_start_node;
+
+template <typename T>
+constexpr typename SoaNodeList<T>::size_type SoaNodeList<T>::past_end_node;
+
+template <typename T>
+constexpr typename SoaNodeList<T>::size_type SoaNodeList<T>::sentinel_count;
+
+} // namespace goldenrockefeller
+
+#endif
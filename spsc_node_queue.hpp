@@ -0,0 +1,231 @@
+// MIT License
+
+// Copyright(c) 2021 Golden Rockefeller
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef GOLDENROCKEFELLER_SPSC_NODE_QUEUE_HPP
+#define GOLDENROCKEFELLER_SPSC_NODE_QUEUE_HPP
+
+#include <stdexcept>
+#include <atomic>
+#include <memory>
+#include <cstdint>
+#include <limits>
+
+#include "node_list.hpp"
+
+#if !defined(__cpp_aligned_new)
+#error "SpscNodeQueue needs C++17 aligned new for its cache-line-aligned indices."
+#endif
+
+namespace goldenrockefeller {
+
+// A wait-free single-producer/single-consumer queue of DataNode pointers.
+// Only the node pointers go through the ring; the payloads stay in the
+// preallocated nodes.
+//
+// The producer's index, and its cached copy of the consumer's index, share
+// one cache line, and the consumer's state shares another, so each side only
+// reads the other's line when its cached copy says the queue looks full or
+// empty. Batched operations move a whole run of nodes and publish it with one
+// index store.
+//
+// The ring buffer is allocated once, at construction; enqueue returns false
+// when it is full. The queue never touches the links of the nodes, so a node
+// must stay alive, and must not be attached to a list, while it is queued.
+template <typename T>
+class SpscNodeQueue {
+
+public:
+	using list_type = NodeList<T>;
+	using DataNode = typename list_type::DataNode;
+	using size_type = std::size_t;
+
+	static constexpr size_type cache_line_size = 64;
+
+private:
+	// Producer state.
+	alignas(cache_line_size) std::atomic<size_type> tail;
+	size_type cached_head;
+
+	// Consumer state.
+	alignas(cache_line_size) std::atomic<size_type> head;
+	size_type cached_tail;
+
+	// Shared, read-only after construction.
+	alignas(cache_line_size) std::unique_ptr<DataNode*[]> buffer;
+	size_type mask;
+
+	// Returns how many more nodes the producer can enqueue, refreshing the
+	// cached consumer index if fewer than the wanted count seem free.
+	size_type free_count(size_type tail_index, size_type wanted) noexcept {
+		size_type free = this->capacity() - (tail_index - this->cached_head);
+		if (free < wanted) {
+			this->cached_head = this->head.load(std::memory_order_acquire);
+			free = this->capacity() - (tail_index - this->cached_head);
+		}
+		return free;
+	}
+
+	// Returns how many nodes the consumer can dequeue, refreshing the cached
+	// producer index if fewer than the wanted count seem available.
+	size_type available_count(size_type head_index, size_type wanted) noexcept {
+		size_type available = this->cached_tail - head_index;
+		if (available < wanted) {
+			this->cached_tail = this->tail.load(std::memory_order_acquire);
+			available = this->cached_tail - head_index;
+		}
+		return available;
+	}
+
+public:
+	// The capacity is rounded up to a power of two.
+	explicit SpscNodeQueue(size_type capacity = 1024) :
+		tail{ 0 },
+		cached_head{ 0 },
+		head{ 0 },
+		cached_tail{ 0 },
+		buffer{},
+		mask{ 0 }
+	{
+		if (capacity == 0) {
+			throw std::invalid_argument("The capacity must not be zero.");
+		}
+
+		if (capacity > std::numeric_limits<size_type>::max() / 2 + 1) {
+			throw std::length_error("The capacity is too large.");
+		}
+
+		size_type rounded_capacity{ 1 };
+		while (rounded_capacity < capacity) {
+			rounded_capacity <<= 1;
+		}
+
+		this->buffer.reset(new DataNode*[rounded_capacity]());
+		this->mask = rounded_capacity - 1;
+	};
+
+	SpscNodeQueue(const SpscNodeQueue& obj) = delete;
+	SpscNodeQueue(SpscNodeQueue&& obj) = delete;
+	SpscNodeQueue& operator=(const SpscNodeQueue& obj) = delete;
+	SpscNodeQueue& operator=(SpscNodeQueue&& obj) = delete;
+
+	size_type capacity() const noexcept {
+		return this->mask + 1;
+	};
+
+	// A snapshot of the number of queued nodes; exact only from a thread
+	// that is not racing the other side. The head is read first: the tail
+	// can only have moved further by the time it is read, so the difference
+	// never wraps around.
+	size_type size_estimate() const noexcept {
+		size_type head_index = this->head.load(std::memory_order_acquire);
+		return this->tail.load(std::memory_order_acquire) - head_index;
+	};
+
+	// Producer only. Enqueues a detached node, or returns false if the queue
+	// is full.
+	bool enqueue(DataNode& node) noexcept {
+		size_type tail_index = this->tail.load(std::memory_order_relaxed);
+
+		if (this->free_count(tail_index, 1) == 0) {
+			return false;
+		}
+
+		this->buffer[tail_index & this->mask] = &node;
+		this->tail.store(tail_index + 1, std::memory_order_release);
+
+		return true;
+	};
+
+	// Producer only. Detaches nodes from the front of the list and enqueues
+	// them, in order, until the list is empty or the queue is full. Returns
+	// the number of enqueued nodes.
+	size_type enqueue_list(list_type& list) noexcept {
+		size_type tail_index = this->tail.load(std::memory_order_relaxed);
+		size_type free = this->free_count(tail_index, this->capacity());
+		size_type count{ 0 };
+
+		while (count < free) {
+			DataNode* node = list.front_node();
+			if (!node) {
+				break;
+			}
+			node->detach();
+			this->buffer[(tail_index + count) & this->mask] = node;
+			count++;
+		}
+
+		if (count > 0) {
+			this->tail.store(tail_index + count, std::memory_order_release);
+		}
+
+		return count;
+	};
+
+	// Consumer only. Dequeues the oldest node, or returns null if the queue
+	// is empty.
+	DataNode* dequeue() noexcept {
+		size_type head_index = this->head.load(std::memory_order_relaxed);
+
+		if (this->available_count(head_index, 1) == 0) {
+			return nullptr;
+		}
+
+		DataNode* node = this->buffer[head_index & this->mask];
+		this->head.store(head_index + 1, std::memory_order_release);
+
+		return node;
+	};
+
+	// Consumer only. Dequeues up to max_count nodes, oldest first, and
+	// attaches them to the back of the list. Returns the number of dequeued
+	// nodes.
+	size_type dequeue_list(list_type& list, size_type max_count) {
+		size_type head_index = this->head.load(std::memory_order_relaxed);
+		size_type count = this->available_count(head_index, max_count);
+
+		if (count > max_count) {
+			count = max_count;
+		}
+
+		for (size_type i{ 0 }; i < count; i++) {
+			this->buffer[(head_index + i) & this->mask]->attach_to(list);
+		}
+
+		if (count > 0) {
+			this->head.store(head_index + count, std::memory_order_release);
+		}
+
+		return count;
+	};
+
+	// Consumer only. Dequeues every available node into the list.
+	size_type dequeue_list(list_type& list) {
+		return this->dequeue_list(list, this->capacity());
+	};
+};
+
+template <typename T>
+constexpr typename SpscNodeQueue<T>::size_type SpscNodeQueue<T>::cache_line_size;
+
+} // namespace goldenrockefeller
+
+#endif
@@ -0,0 +1,456 @@
+// MIT License
+
+// Copyright(c) 2021 Golden Rockefeller
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef GOLDENROCKEFELLER_STATIC_NODE_LIST_HPP
+#define GOLDENROCKEFELLER_STATIC_NODE_LIST_HPP
+
+#include <stdexcept>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <cstdint>
+
+namespace goldenrockefeller {
+
+// A fixed-capacity list that stores up to N values inline and never
+// allocates. Links are 16-bit indices when N allows it and 32-bit indices
+// otherwise, and freed slots are kept on an intrusive free list, so every
+// insertion and erasure is O(1).
+//
+// The constructor is constexpr, so a StaticNodeList with static storage
+// duration is constant-initialized. Slots are handed out in order until the
+// capacity is first reached, which keeps construction free of loops.
+template <typename T, std::size_t N>
+class StaticNodeList {
+
+	static_assert(N > 0, "StaticNodeList must have a capacity of at least one value.");
+	static_assert(N <= 0xFFFFFFFDu, "StaticNodeList capacity must fit 32-bit indices.");
+
+public:
+	using value_type = T;
+	using allocator_type = std::allocator<value_type>;
+	using reference = value_type&;
+	using const_reference = const value_type&;
+	using pointer = typename std::allocator_traits<allocator_type>::pointer;
+	using const_pointer = typename std::allocator_traits<allocator_type>::const_pointer;
+	using size_type = std::size_t;
+	using difference_type = std::ptrdiff_t;
+	using index_type = typename std::conditional<(N < 0xFFFDu), std::uint16_t, std::uint32_t>::type;
+
+	// Index of a missing link, the equivalent of a null Node pointer.
+	static constexpr index_type npos = static_cast<index_type>(-1);
+
+private:
+	struct Link {
+		index_type next_node;
+		index_type prev_node;
+	};
+
+	// Slots 0 and 1 of the link array hold the sentinels; the value of link
+	// slot i is stored at storage[i - sentinel_count].
+	static constexpr index_type before_start_node = 0;
+	static constexpr index_type past_end_node = 1;
+	static constexpr index_type sentinel_count = 2;
+
+	Link links[N + sentinel_count];
+	typename std::aligned_storage<sizeof(value_type), alignof(value_type)>::type storage[N];
+	index_type free_node;
+	index_type unused_node;
+	size_type value_count;
+
+	value_type* value_at(index_type node) noexcept {
+		return reinterpret_cast<value_type*>(&(this->storage[node - sentinel_count]));
+	}
+
+	const value_type* value_at(index_type node) const noexcept {
+		return reinterpret_cast<const value_type*>(&(this->storage[node - sentinel_count]));
+	}
+
+	index_type acquire_node() {
+		if (this->free_node != npos) {
+			index_type node = this->free_node;
+			this->free_node = this->links[node].next_node;
+			return node;
+		}
+
+		if (this->unused_node < N + sentinel_count) {
+			return this->unused_node++;
+		}
+
+		throw std::length_error("The list is full.");
+	}
+
+	void release_node(index_type node) noexcept {
+		this->links[node].next_node = this->free_node;
+		this->links[node].prev_node = npos;
+		this->free_node = node;
+	}
+
+	template <typename... Args>
+	index_type emplace_before(index_type other_node, Args&&... args) {
+		index_type node = this->acquire_node();
+
+		try {
+			::new (static_cast<void*>(this->value_at(node))) value_type(std::forward<Args>(args)...);
+		}
+		catch (...) {
+			this->release_node(node);
+			throw;
+		}
+
+		index_type prev_node = this->links[other_node].prev_node;
+		this->links[node].next_node = other_node;
+		this->links[node].prev_node = prev_node;
+		this->links[prev_node].next_node = node;
+		this->links[other_node].prev_node = node;
+		this->value_count++;
+
+		return node;
+	}
+
+	index_type erase_node(index_type node) noexcept {
+		index_type next_node = this->links[node].next_node;
+		index_type prev_node = this->links[node].prev_node;
+
+		this->links[prev_node].next_node = next_node;
+		this->links[next_node].prev_node = prev_node;
+		this->value_at(node)->~value_type();
+		this->release_node(node);
+		this->value_count--;
+
+		return next_node;
+	}
+
+public:
+	template <typename Type>
+	class base_iterator
+	{
+		template <typename OtherType>
+		friend class base_iterator;
+
+		friend class StaticNodeList;
+
+	protected:
+		using list_pointer = typename std::conditional<
+			std::is_const<Type>::value,
+			const StaticNodeList*,
+			StaticNodeList*
+		>::type;
+
+		list_pointer list;
+		index_type current_node;
+
+		const Link& current_link() const noexcept {
+			return this->list->links[this->current_node];
+		}
+
+	public:
+		using iterator_category = std::bidirectional_iterator_tag;
+		using difference_type = std::ptrdiff_t;
+		using value_type = Type;
+		using pointer = Type*;
+		using reference = Type&;
+
+		base_iterator() noexcept : list{ nullptr }, current_node{ npos } {};
+		base_iterator(list_pointer list, index_type starting_node) noexcept :
+			list{ list },
+			current_node{ starting_node }
+		{};
+
+		bool is_at_nullptr() const noexcept {
+			return !this->list || this->current_node == npos;
+		}
+
+		bool is_at_datanode_no_null_check() const noexcept {
+			return this->current_node >= sentinel_count;
+		}
+
+		bool is_at_datanode() const {
+			if (this->is_at_nullptr()) {
+				throw std::runtime_error("The iterator's current node must not be null.");
+			}
+			return this->is_at_datanode_no_null_check();
+		}
+
+		bool is_past_the_end_no_null_check() const noexcept {
+			return this->current_node == past_end_node;
+		}
+
+		bool is_past_the_end() const {
+			if (this->is_at_nullptr()) {
+				throw std::runtime_error("The iterator's current node must not be null.");
+			}
+			return this->is_past_the_end_no_null_check();
+		}
+
+		bool is_before_the_start_no_null_check() const noexcept {
+			return this->current_node == before_start_node;
+		}
+
+		bool is_before_the_start() const {
+			if (this->is_at_nullptr()) {
+				throw std::runtime_error("The iterator's current node must not be null.");
+			}
+			return this->is_before_the_start_no_null_check();
+		}
+
+		base_iterator& operator++() {
+			if (this->is_at_nullptr()) {
+				throw std::runtime_error("The iterator's current node must not be null.");
+			}
+			if (this->is_past_the_end_no_null_check()) {
+				throw std::runtime_error("Cannot increment iterator that is past-the-end.");
+			}
+
+			this->current_node = this->current_link().next_node;
+
+			return *this;
+		}
+
+		base_iterator& operator--() {
+			if (this->is_at_nullptr()) {
+				throw std::runtime_error("The iterator's current node must not be null.");
+			}
+			if (this->is_before_the_start_no_null_check()) {
+				throw std::runtime_error("Cannot decrement iterator that is before-the-start.");
+			}
+
+			this->current_node = this->current_link().prev_node;
+
+			return *this;
+		}
+
+		base_iterator operator++(int) {
+			base_iterator it(*this);
+			++(*this);
+			return it;
+		}
+
+		base_iterator operator--(int) {
+			base_iterator it(*this);
+			--(*this);
+			return it;
+		}
+
+		reference operator*() const {
+			if (this->is_at_nullptr()) {
+				throw std::runtime_error("The iterator's current node must not be null.");
+			}
+			if (!this->is_at_datanode_no_null_check()) {
+				throw std::runtime_error("Cannot dereference iterator that is not at data node");
+			}
+
+			return *(this->list->value_at(this->current_node));
+		};
+
+		pointer operator->() const {
+			return &(**this);
+		};
+
+		template<typename OtherType>
+		bool operator==(const base_iterator<OtherType>& it) const noexcept {
+			// Invalid iterators are never equal.
+			return (
+				this->list == it.list
+				&& this->current_node == it.current_node
+				&& !this->is_at_nullptr()
+			);
+		}
+
+		template<typename OtherType>
+		bool operator!=(const base_iterator<OtherType>& it) const noexcept {
+			return !(*this == it);
+		}
+
+		operator base_iterator<const value_type>() const noexcept
+		{
+			return base_iterator<const value_type>(this->list, this->current_node);
+		}
+	};
+
+	using iterator = base_iterator<value_type>;
+	using const_iterator = base_iterator<const value_type>;
+	using reverse_iterator = std::reverse_iterator<iterator>;
+	using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+	constexpr StaticNodeList() noexcept :
+		links{ Link{ past_end_node, npos }, Link{ npos, before_start_node } },
+		storage{},
+		free_node{ npos },
+		unused_node{ sentinel_count },
+		value_count{ 0 }
+	{};
+
+	~StaticNodeList() noexcept {
+		this->clear();
+	};
+
+	StaticNodeList(const StaticNodeList& obj) = delete;
+	StaticNodeList(StaticNodeList&& obj) = delete;
+	StaticNodeList& operator=(const StaticNodeList& obj) = delete;
+	StaticNodeList& operator=(StaticNodeList&& obj) = delete;
+
+	iterator begin() noexcept {
+		return iterator(this, this->links[before_start_node].next_node);
+	};
+	const_iterator begin() const noexcept {
+		return const_iterator(this, this->links[before_start_node].next_node);
+	};
+	const_iterator cbegin() const noexcept {
+		return this->begin();
+	};
+	iterator end() noexcept {
+		return iterator(this, past_end_node);
+	};
+	const_iterator end() const noexcept {
+		return const_iterator(this, past_end_node);
+	};
+	const_iterator cend() const noexcept {
+		return this->end();
+	};
+
+	reverse_iterator rbegin() noexcept {
+		return reverse_iterator(this->end());
+	};
+	const_reverse_iterator rbegin() const noexcept {
+		return const_reverse_iterator(this->end());
+	};
+	const_reverse_iterator crbegin() const noexcept {
+		return this->rbegin();
+	};
+	reverse_iterator rend() noexcept {
+		return reverse_iterator(this->begin());
+	};
+	const_reverse_iterator rend() const noexcept {
+		return const_reverse_iterator(this->begin());
+	};
+	const_reverse_iterator crend() const noexcept {
+		return this->rend();
+	};
+
+	bool is_empty() const noexcept {
+		return this->value_count == 0;
+	};
+
+	bool is_full() const noexcept {
+		return this->value_count == N;
+	};
+
+	size_type size() const noexcept {
+		return this->value_count;
+	};
+
+	static constexpr size_type capacity() noexcept {
+		return N;
+	};
+
+	reference front() {
+		if (this->is_empty()) {
+			throw std::runtime_error("The list must not be empty.");
+		}
+		return *(this->value_at(this->links[before_start_node].next_node));
+	}
+
+	reference back() {
+		if (this->is_empty()) {
+			throw std::runtime_error("The list must not be empty.");
+		}
+		return *(this->value_at(this->links[past_end_node].prev_node));
+	}
+
+	template <typename... Args>
+	iterator emplace_back(Args&&... args) {
+		return iterator(this, this->emplace_before(past_end_node, std::forward<Args>(args)...));
+	}
+
+	template <typename... Args>
+	iterator emplace_front(Args&&... args) {
+		return iterator(this, this->emplace_before(this->links[before_start_node].next_node, std::forward<Args>(args)...));
+	}
+
+	// Constructs a value before the iterator's position and returns an
+	// iterator to it.
+	template <typename... Args>
+	iterator emplace(const_iterator pos, Args&&... args) {
+		if (pos.is_at_nullptr() || pos.list != this) {
+			throw std::runtime_error("The iterator must be a valid iterator of this list.");
+		}
+		if (pos.is_before_the_start_no_null_check()) {
+			throw std::runtime_error("Cannot insert before this iterator if this iterator is before-the-start.");
+		}
+
+		return iterator(this, this->emplace_before(pos.current_node, std::forward<Args>(args)...));
+	}
+
+	// Erases the value at the iterator's position and returns an iterator to
+	// the value after it.
+	iterator erase(const_iterator pos) {
+		if (pos.is_at_nullptr() || pos.list != this) {
+			throw std::runtime_error("The iterator must be a valid iterator of this list.");
+		}
+		if (!pos.is_at_datanode_no_null_check()) {
+			throw std::runtime_error("Cannot erase at an iterator that is not at data node.");
+		}
+
+		return iterator(this, this->erase_node(pos.current_node));
+	}
+
+	void pop_front() {
+		if (this->is_empty()) {
+			throw std::runtime_error("The list must not be empty.");
+		}
+		this->erase_node(this->links[before_start_node].next_node);
+	}
+
+	void pop_back() {
+		if (this->is_empty()) {
+			throw std::runtime_error("The list must not be empty.");
+		}
+		this->erase_node(this->links[past_end_node].prev_node);
+	}
+
+	void clear() noexcept {
+		index_type node{ this->links[before_start_node].next_node };
+
+		while (node != past_end_node) {
+			node = this->erase_node(node);
+		}
+	};
+};
+
+template <typename T, std::size_t N>
+constexpr typename StaticNodeList<T, N>::index_type StaticNodeList<T, N>::npos;
+
+template <typename T, std::size_t N>
+constexpr typename StaticNodeList<T, N>::index_type StaticNodeList<T, N>::before_start_node;
+
+template <typename T, std::size_t N>
+constexpr typename StaticNodeList<T, N>::index_type StaticNodeList<T, N>::past_end_node;
+
+template <typename T, std::size_t N>
+constexpr typename StaticNodeList<T, N>::index_type StaticNodeList<T, N>::sentinel_count;
+
+} // namespace goldenrockefeller
+
+#endif
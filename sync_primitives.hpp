@@ -0,0 +1,615 @@
+// MIT License
+
+// Copyright(c) 2021 Golden Rockefeller
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef GOLDENROCKEFELLER_SYNC_PRIMITIVES_HPP
+#define GOLDENROCKEFELLER_SYNC_PRIMITIVES_HPP
+
+#include <stdexcept>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <cstdint>
+#include <cstddef>
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <ctime>
+#endif
+
+#if defined(__cpp_impl_coroutine) && defined(__has_include)
+#if __has_include(<coroutine>)
+#include <coroutine>
+#define GOLDENROCKEFELLER_HAS_COROUTINES
+#endif
+#endif
+
+#include "node_list.hpp"
+
+namespace goldenrockefeller {
+
+// A test-and-test-and-set spin lock for short critical sections.
+class SpinLock {
+	std::atomic<bool> locked;
+
+public:
+	SpinLock() noexcept : locked{ false } {};
+
+	SpinLock(const SpinLock& obj) = delete;
+	SpinLock& operator=(const SpinLock& obj) = delete;
+
+	bool try_lock() noexcept {
+		return !this->locked.load(std::memory_order_relaxed) && !this->locked.exchange(true, std::memory_order_acquire);
+	};
+
+	void lock() noexcept {
+		unsigned spins{ 0 };
+		while (!this->try_lock()) {
+			while (this->locked.load(std::memory_order_relaxed)) {
+				if (++spins > 64) {
+					std::this_thread::yield();
+				}
+			}
+		}
+	};
+
+	void unlock() noexcept {
+		this->locked.store(false, std::memory_order_release);
+	};
+};
+
+// A flag that one owner at a time can claim, such as one of an array of
+// per-thread slots.
+class ClaimFlag {
+	std::atomic<bool> claimed;
+
+public:
+	ClaimFlag() noexcept : claimed{ false } {};
+
+	ClaimFlag(const ClaimFlag& obj) = delete;
+	ClaimFlag& operator=(const ClaimFlag& obj) = delete;
+
+	bool try_claim() noexcept {
+		return !this->claimed.load(std::memory_order_relaxed) && !this->claimed.exchange(true, std::memory_order_acquire);
+	};
+
+	void release() noexcept {
+		this->claimed.store(false, std::memory_order_release);
+	};
+};
+
+// Claims and returns the first slot whose is_claimed ClaimFlag is free.
+// Throws std::length_error with the message if every slot is claimed.
+template <typename Slot>
+Slot& claim_first_slot(Slot* slots, std::size_t slot_count, const char* message) {
+	for (std::size_t i{ 0 }; i < slot_count; i++) {
+		if (slots[i].is_claimed.try_claim()) {
+			return slots[i];
+		}
+	}
+	throw std::length_error(message);
+}
+
+// The state of one blocked thread or coroutine. Waiters are DataNodes that
+// live on the waiting thread's stack or in the coroutine's frame, so blocking
+// never allocates.
+//
+// A waiter is waiting until a waker claims it under the primitive's spin
+// lock, which moves it to claimed: from then on only the waker may touch the
+// waiter's node, until it stores woken. A waiter that times out or is
+// cancelled while still waiting detaches itself under the spin lock instead.
+//
+// A suspended coroutine waits with a resume function, which the waker calls
+// with the resume context instead of waking a parked thread. The two members
+// are type-erased so that the layout of Waiter does not depend on whether
+// coroutines are available.
+class Waiter {
+public:
+	static constexpr std::uint32_t waiting = 0;
+	static constexpr std::uint32_t claimed = 1;
+	static constexpr std::uint32_t woken = 2;
+
+	std::atomic<std::uint32_t> state;
+	void* resume_context;
+	void (*resume_function)(void*);
+
+	Waiter() noexcept : state{ waiting }, resume_context{ nullptr }, resume_function{ nullptr } {};
+
+	Waiter(const Waiter& obj) = delete;
+	Waiter& operator=(const Waiter& obj) = delete;
+
+	using list_type = NodeList<Waiter>;
+	using DataNode = list_type::DataNode;
+
+	// Blocks until the waiter is woken.
+	static void park(DataNode& node) noexcept {
+		std::uint32_t state;
+		while ((state = node.data.state.load(std::memory_order_acquire)) != woken) {
+			wait_on(node.data.state, state, nullptr);
+		}
+	};
+
+	// Blocks until the waiter is woken or the deadline passes. Returns true
+	// if the waiter was woken.
+	template <typename Clock, typename Duration>
+	static bool park_until(DataNode& node, const std::chrono::time_point<Clock, Duration>& deadline) noexcept {
+		std::uint32_t state;
+		while ((state = node.data.state.load(std::memory_order_acquire)) != woken) {
+			auto now = Clock::now();
+			if (now >= deadline) {
+				return false;
+			}
+			auto timeout = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline - now);
+			wait_on(node.data.state, state, &timeout);
+		}
+		return true;
+	};
+
+	// Marks the waiter as claimed and detaches it from the shared list. Must
+	// be called under the spin lock that guards the list.
+	static void claim(DataNode& node) noexcept {
+		node.data.state.store(claimed, std::memory_order_relaxed);
+		node.detach();
+	};
+
+	// Detaches a claimed waiter from any private list and resumes it. The node must not be touched
+	// afterwards, as its owner may return and destroy it.
+	//
+	// A coroutine waiter is posted to this thread's resume queue rather than
+	// resumed from inside the wake. Only the outermost wake on the thread
+	// drains the queue, so a resumed coroutine that hands a mutex or permit
+	// to another coroutine just queues it, and a chain of handoffs runs in a
+	// loop instead of growing the stack.
+	static void wake(DataNode& node) noexcept {
+		node.detach();
+
+		if (node.data.resume_function) {
+			post(node);
+			return;
+		}
+
+		std::atomic<std::uint32_t>* state = &(node.data.state);
+		state->store(woken, std::memory_order_release);
+		wake_one(*state);
+	};
+
+	// Wakes every claimed waiter of the list.
+	static void wake_all(list_type& list) noexcept {
+		while (DataNode* node = list.front_node()) {
+			wake(*node);
+		}
+	};
+
+private:
+	static list_type& posted_waiters() noexcept {
+		static thread_local list_type list;
+		return list;
+	}
+
+	static bool& is_resuming() noexcept {
+		static thread_local bool resuming{ false };
+		return resuming;
+	}
+
+	static void post(DataNode& node) noexcept {
+		list_type& posted = posted_waiters();
+		node.attach_to(posted);
+
+		bool& resuming = is_resuming();
+		if (resuming) {
+			return;
+		}
+
+		resuming = true;
+		while (DataNode* next = posted.front_node()) {
+			next->detach();
+			void* context = next->data.resume_context;
+			void (*resume_function)(void*) = next->data.resume_function;
+			next->data.state.store(woken, std::memory_order_release);
+			resume_function(context);
+		}
+		resuming = false;
+	}
+
+#if defined(__linux__)
+	// A wake may race with the waiter returning and reusing its stack, so
+	// futex waits only ever see spurious wake-ups, which the loops absorb.
+	static void wait_on(std::atomic<std::uint32_t>& state, std::uint32_t value, const std::chrono::nanoseconds* timeout) noexcept {
+		struct timespec relative_timeout;
+		struct timespec* timeout_pointer = nullptr;
+
+		if (timeout) {
+			relative_timeout.tv_sec = static_cast<std::time_t>(timeout->count() / 1000000000);
+			relative_timeout.tv_nsec = static_cast<long>(timeout->count() % 1000000000);
+			timeout_pointer = &relative_timeout;
+		}
+
+		syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&state), FUTEX_WAIT_PRIVATE, value, timeout_pointer, nullptr, 0);
+	}
+
+	static void wake_one(std::atomic<std::uint32_t>& state) noexcept {
+		syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&state), FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+	}
+#else
+	// Without futexes, waiters poll and yield.
+	static void wait_on(std::atomic<std::uint32_t>& state, std::uint32_t value, const std::chrono::nanoseconds*) noexcept {
+		for (unsigned spins{ 0 }; spins < 64 && state.load(std::memory_order_relaxed) == value; spins++) {
+		}
+		std::this_thread::yield();
+	}
+
+	static void wake_one(std::atomic<std::uint32_t>&) noexcept {
+	}
+#endif
+};
+
+#if defined(GOLDENROCKEFELLER_HAS_COROUTINES)
+// The resume function of a coroutine waiter, whose resume context is the
+// address of the coroutine's frame.
+inline void resume_coroutine(void* address) {
+	std::coroutine_handle<>::from_address(address).resume();
+}
+#endif
+
+// A mutex that hands ownership to its waiters in FIFO order. When the mutex
+// is unlocked with waiters present it stays locked and passes directly to the
+// first waiter, so no thread can barge ahead of the queue.
+class FairMutex {
+	SpinLock spin_lock;
+	bool locked;
+	Waiter::list_type waiters;
+
+	// Returns true if the mutex was acquired, otherwise queues the node.
+	bool lock_or_enqueue(Waiter::DataNode& node) noexcept {
+		std::lock_guard<SpinLock> guard(this->spin_lock);
+		if (!this->locked) {
+			this->locked = true;
+			return true;
+		}
+		node.attach_to(this->waiters);
+		return false;
+	}
+
+	// Returns true if the node was still waiting and has been removed,
+	// false if ownership has already been handed to it.
+	bool cancel(Waiter::DataNode& node) noexcept {
+		std::lock_guard<SpinLock> guard(this->spin_lock);
+		if (node.data.state.load(std::memory_order_relaxed) != Waiter::waiting) {
+			return false;
+		}
+		node.detach();
+		return true;
+	}
+
+public:
+	FairMutex() noexcept : spin_lock{}, locked{ false }, waiters{} {};
+
+	FairMutex(const FairMutex& obj) = delete;
+	FairMutex& operator=(const FairMutex& obj) = delete;
+
+	bool try_lock() noexcept {
+		std::lock_guard<SpinLock> guard(this->spin_lock);
+		if (this->locked) {
+			return false;
+		}
+		this->locked = true;
+		return true;
+	};
+
+	void lock() noexcept {
+		Waiter::DataNode node;
+		if (this->lock_or_enqueue(node)) {
+			return;
+		}
+		Waiter::park(node);
+	};
+
+	template <typename Rep, typename Period>
+	bool try_lock_for(const std::chrono::duration<Rep, Period>& timeout) noexcept {
+		return this->try_lock_until(std::chrono::steady_clock::now() + timeout);
+	};
+
+	template <typename Clock, typename Duration>
+	bool try_lock_until(const std::chrono::time_point<Clock, Duration>& deadline) noexcept {
+		Waiter::DataNode node;
+		if (this->lock_or_enqueue(node)) {
+			return true;
+		}
+		if (Waiter::park_until(node, deadline) || !this->cancel(node)) {
+			// Ownership was handed over before the node could be removed.
+			Waiter::park(node);
+			return true;
+		}
+		return false;
+	};
+
+	void unlock() noexcept {
+		Waiter::DataNode* node;
+		{
+			std::lock_guard<SpinLock> guard(this->spin_lock);
+			node = this->waiters.front_node();
+			if (!node) {
+				this->locked = false;
+				return;
+			}
+			Waiter::claim(*node);
+		}
+		Waiter::wake(*node);
+	};
+
+#if defined(GOLDENROCKEFELLER_HAS_COROUTINES)
+	// co_await mutex.lock_async() acquires the mutex without blocking the
+	// thread. The waiter node lives in the awaiting coroutine's frame, and the
+	// coroutine is resumed by the thread that hands it the mutex.
+	class LockAwaiter {
+		FairMutex& mutex;
+		Waiter::DataNode node;
+
+	public:
+		explicit LockAwaiter(FairMutex& mutex) noexcept : mutex(mutex), node{} {};
+
+		// Destroying a suspended coroutine cancels its wait.
+		~LockAwaiter() {
+			if (this->node.data.resume_function && !this->node.data.state.load(std::memory_order_acquire)) {
+				this->mutex.cancel(this->node);
+			}
+		};
+
+		bool await_ready() noexcept {
+			return this->mutex.try_lock();
+		};
+
+		bool await_suspend(std::coroutine_handle<> coroutine) noexcept {
+			this->node.data.resume_context = coroutine.address();
+			this->node.data.resume_function = &resume_coroutine;
+			return !this->mutex.lock_or_enqueue(this->node);
+		};
+
+		void await_resume() noexcept {};
+	};
+
+	LockAwaiter lock_async() noexcept {
+		return LockAwaiter(*this);
+	};
+#endif
+};
+
+// A condition variable whose waiters queue in FIFO order. It works with any
+// lockable type, including FairMutex and std::mutex.
+class ConditionVariable {
+	SpinLock spin_lock;
+	Waiter::list_type waiters;
+
+	void enqueue(Waiter::DataNode& node) noexcept {
+		std::lock_guard<SpinLock> guard(this->spin_lock);
+		node.attach_to(this->waiters);
+	}
+
+	bool cancel(Waiter::DataNode& node) noexcept {
+		std::lock_guard<SpinLock> guard(this->spin_lock);
+		if (node.data.state.load(std::memory_order_relaxed) != Waiter::waiting) {
+			return false;
+		}
+		node.detach();
+		return true;
+	}
+
+public:
+	ConditionVariable() noexcept : spin_lock{}, waiters{} {};
+
+	ConditionVariable(const ConditionVariable& obj) = delete;
+	ConditionVariable& operator=(const ConditionVariable& obj) = delete;
+
+	template <typename Lock>
+	void wait(Lock& lock) {
+		Waiter::DataNode node;
+		this->enqueue(node);
+		lock.unlock();
+		Waiter::park(node);
+		lock.lock();
+	};
+
+	template <typename Lock, typename Predicate>
+	void wait(Lock& lock, Predicate pred) {
+		while (!pred()) {
+			this->wait(lock);
+		}
+	};
+
+	// Returns false if the deadline passed before the waiter was notified.
+	template <typename Lock, typename Clock, typename Duration>
+	bool wait_until(Lock& lock, const std::chrono::time_point<Clock, Duration>& deadline) {
+		Waiter::DataNode node;
+		this->enqueue(node);
+		lock.unlock();
+
+		bool notified = Waiter::park_until(node, deadline);
+		if (!notified && !this->cancel(node)) {
+			// A notification claimed the node before it could be removed.
+			Waiter::park(node);
+			notified = true;
+		}
+
+		lock.lock();
+		return notified;
+	};
+
+	template <typename Lock, typename Rep, typename Period>
+	bool wait_for(Lock& lock, const std::chrono::duration<Rep, Period>& timeout) {
+		return this->wait_until(lock, std::chrono::steady_clock::now() + timeout);
+	};
+
+	void notify_one() noexcept {
+		Waiter::DataNode* node;
+		{
+			std::lock_guard<SpinLock> guard(this->spin_lock);
+			node = this->waiters.front_node();
+			if (!node) {
+				return;
+			}
+			Waiter::claim(*node);
+		}
+		Waiter::wake(*node);
+	};
+
+	void notify_all() noexcept {
+		Waiter::list_type claimed;
+		{
+			std::lock_guard<SpinLock> guard(this->spin_lock);
+			for (Waiter& waiter : this->waiters) {
+				waiter.state.store(Waiter::claimed, std::memory_order_relaxed);
+			}
+			claimed = std::move(this->waiters);
+		}
+		Waiter::wake_all(claimed);
+	};
+};
+
+// A counting semaphore that grants permits to its waiters in FIFO order.
+// Released permits go directly to queued waiters before they are added to
+// the count, so a late acquirer cannot take a permit ahead of the queue.
+class Semaphore {
+	SpinLock spin_lock;
+	std::size_t count;
+	Waiter::list_type waiters;
+
+	bool acquire_or_enqueue(Waiter::DataNode& node) noexcept {
+		std::lock_guard<SpinLock> guard(this->spin_lock);
+		if (this->count > 0 && this->waiters.is_empty()) {
+			this->count--;
+			return true;
+		}
+		node.attach_to(this->waiters);
+		return false;
+	}
+
+	bool cancel(Waiter::DataNode& node) noexcept {
+		std::lock_guard<SpinLock> guard(this->spin_lock);
+		if (node.data.state.load(std::memory_order_relaxed) != Waiter::waiting) {
+			return false;
+		}
+		node.detach();
+		return true;
+	}
+
+public:
+	explicit Semaphore(std::size_t count = 0) noexcept : spin_lock{}, count{ count }, waiters{} {};
+
+	Semaphore(const Semaphore& obj) = delete;
+	Semaphore& operator=(const Semaphore& obj) = delete;
+
+	bool try_acquire() noexcept {
+		std::lock_guard<SpinLock> guard(this->spin_lock);
+		if (this->count > 0 && this->waiters.is_empty()) {
+			this->count--;
+			return true;
+		}
+		return false;
+	};
+
+	void acquire() noexcept {
+		Waiter::DataNode node;
+		if (this->acquire_or_enqueue(node)) {
+			return;
+		}
+		Waiter::park(node);
+	};
+
+	template <typename Rep, typename Period>
+	bool try_acquire_for(const std::chrono::duration<Rep, Period>& timeout) noexcept {
+		return this->try_acquire_until(std::chrono::steady_clock::now() + timeout);
+	};
+
+	template <typename Clock, typename Duration>
+	bool try_acquire_until(const std::chrono::time_point<Clock, Duration>& deadline) noexcept {
+		Waiter::DataNode node;
+		if (this->acquire_or_enqueue(node)) {
+			return true;
+		}
+		if (Waiter::park_until(node, deadline) || !this->cancel(node)) {
+			// A permit was granted before the node could be removed.
+			Waiter::park(node);
+			return true;
+		}
+		return false;
+	};
+
+	void release(std::size_t permits = 1) noexcept {
+		Waiter::list_type granted;
+		{
+			std::lock_guard<SpinLock> guard(this->spin_lock);
+			while (permits > 0) {
+				Waiter::DataNode* node = this->waiters.front_node();
+				if (!node) {
+					break;
+				}
+				Waiter::claim(*node);
+				node->attach_to(granted);
+				permits--;
+			}
+			this->count += permits;
+		}
+		Waiter::wake_all(granted);
+	};
+
+#if defined(GOLDENROCKEFELLER_HAS_COROUTINES)
+	// co_await semaphore.acquire_async() acquires a permit without blocking
+	// the thread; see FairMutex::lock_async.
+	class AcquireAwaiter {
+		Semaphore& semaphore;
+		Waiter::DataNode node;
+
+	public:
+		explicit AcquireAwaiter(Semaphore& semaphore) noexcept : semaphore(semaphore), node{} {};
+
+		// Destroying a suspended coroutine cancels its wait.
+		~AcquireAwaiter() {
+			if (this->node.data.resume_function && !this->node.data.state.load(std::memory_order_acquire)) {
+				this->semaphore.cancel(this->node);
+			}
+		};
+
+		bool await_ready() noexcept {
+			return this->semaphore.try_acquire();
+		};
+
+		bool await_suspend(std::coroutine_handle<> coroutine) noexcept {
+			this->node.data.resume_context = coroutine.address();
+			this->node.data.resume_function = &resume_coroutine;
+			return !this->semaphore.acquire_or_enqueue(this->node);
+		};
+
+		void await_resume() noexcept {};
+	};
+
+	AcquireAwaiter acquire_async() noexcept {
+		return AcquireAwaiter(*this);
+	};
+#endif
+};
+
+} // namespace goldenrockefeller
+
+#endif
@@ -0,0 +1,305 @@
+// MIT License
+
+// Copyright(c) 2021 Golden Rockefeller
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+// Build and run:
+//   g++ -std=c++11 -g -fsanitize=address,undefined tests/arena_node_list_test.cpp -o arena_node_list_test && ./arena_node_list_test
+
+#undef NDEBUG
+#include <cassert>
+#include <cstdio>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "../arena_node_list.hpp"
+
+using namespace goldenrockefeller;
+
+template <typename ListType>
+static std::vector<int> values_of(const ListType& list) {
+	return std::vector<int>(list.begin(), list.end());
+}
+
+static void test_element_size() {
+	static_assert(ArenaNodeList<long>::Arena::node_size() == 8 + sizeof(long), "An 8-byte payload costs one 16-byte slot.");
+	static_assert(ArenaNodeList<int>::Arena::node_size() == 12, "Links are 32-bit indices.");
+}
+
+static void test_emplace_and_erase() {
+	ArenaNodeList<int>::Arena arena;
+	ArenaNodeList<int> list(arena);
+	assert(list.is_empty());
+
+	list.emplace_back(2);
+	list.emplace_back(4);
+	list.emplace_front(1);
+	ArenaNodeList<int>::iterator it = list.emplace(--list.end(), 3);
+	assert(*it == 3);
+	assert(values_of(list) == (std::vector<int>{ 1, 2, 3, 4 }));
+	assert(list.size() == 4);
+	assert(list.front() == 1 && list.back() == 4);
+
+	it = list.erase(it);
+	assert(*it == 4);
+	list.pop_front();
+	list.pop_back();
+	assert(values_of(list) == (std::vector<int>{ 2 }));
+	assert(list.size() == 1);
+
+	bool has_thrown = false;
+	try {
+		list.erase(list.end());
+	}
+	catch (const std::runtime_error&) {
+		has_thrown = true;
+	}
+	assert(has_thrown);
+
+	list.clear();
+	assert(list.is_empty());
+
+	has_thrown = false;
+	try {
+		list.pop_back();
+	}
+	catch (const std::runtime_error&) {
+		has_thrown = true;
+	}
+	assert(has_thrown);
+}
+
+static void test_lists_share_an_arena() {
+	ArenaNodeList<int>::Arena arena;
+	ArenaNodeList<int> first(arena);
+	ArenaNodeList<int> second(arena);
+
+	ArenaNodeList<int>::iterator a = first.emplace_back(1);
+	ArenaNodeList<int>::iterator b = first.emplace_back(2);
+	assert(first.size() == 2);
+
+	// Splicing relinks the slot; iterators to it stay valid.
+	second.splice(second.end(), first, a);
+	assert(values_of(first) == (std::vector<int>{ 2 }));
+	assert(values_of(second) == (std::vector<int>{ 1 }));
+	second.splice(a, first, b);
+	assert(first.is_empty() && first.size() == 0);
+	assert(values_of(second) == (std::vector<int>{ 2, 1 }));
+	second.splice(a, second, a);
+	assert(values_of(second) == (std::vector<int>{ 2, 1 }));
+
+	ArenaNodeList<int>::Arena other_arena;
+	ArenaNodeList<int> stranger(other_arena);
+	bool has_thrown = false;
+	try {
+		stranger.splice(stranger.end(), second, a);
+	}
+	catch (const std::invalid_argument&) {
+		has_thrown = true;
+	}
+	assert(has_thrown);
+
+	has_thrown = false;
+	try {
+		stranger.emplace(second.begin(), 3);
+	}
+	catch (const std::runtime_error&) {
+		has_thrown = true;
+	}
+	assert(has_thrown);
+}
+
+static void test_growth_keeps_links() {
+	ArenaNodeList<std::string>::Arena arena;
+	ArenaNodeList<std::string> odd(arena);
+	ArenaNodeList<std::string> even(arena);
+	ArenaNodeList<std::string>::iterator first = even.end();
+
+	for (int i{ 0 }; i < 1000; i++) {
+		ArenaNodeList<std::string>::iterator it = (i % 2 ? odd : even).emplace_back(std::to_string(i));
+		if (i == 0) {
+			first = it;
+		}
+	}
+	assert(arena.capacity() >= 1004);
+	assert(*first == "0");
+
+	int expected{ 0 };
+	for (const std::string& value : even) {
+		assert(value == std::to_string(expected));
+		expected += 2;
+	}
+	assert(expected == 1000);
+
+	expected = 999;
+	for (ArenaNodeList<std::string>::reverse_iterator it = odd.rbegin(); it != odd.rend(); ++it) {
+		assert(*it == std::to_string(expected));
+		expected -= 2;
+	}
+	assert(expected == -1);
+}
+
+static void test_emplace_from_own_value() {
+	ArenaNodeList<std::string>::Arena arena;
+	ArenaNodeList<std::string> list(arena);
+	std::string value(40, 'x');
+	list.emplace_back(value);
+
+	// The arguments refer to values of the arena while it grows past 16, 32,
+	// 64 and 128 slots.
+	for (int i{ 0 }; i < 200; i++) {
+		if (i % 2) {
+			list.emplace_back(list.front());
+		}
+		else {
+			list.emplace_front(list.back());
+		}
+	}
+	assert(arena.capacity() >= 202);
+	assert(list.size() == 201);
+	for (const std::string& copy : list) {
+		assert(copy == value);
+	}
+
+	// Freed slots are reused without growth.
+	list.pop_back();
+	list.emplace(list.begin(), *list.begin());
+	assert(list.size() == 201);
+	assert(list.front() == value);
+}
+
+struct NoDefault {
+	int value;
+	explicit NoDefault(int value) : value{ value } {};
+};
+
+static void test_payloads_need_no_default_constructor() {
+	ArenaNodeList<NoDefault>::Arena arena;
+	ArenaNodeList<NoDefault> list(arena);
+	list.emplace_back(5);
+	assert(list.begin()->value == 5);
+}
+
+static void test_erase_frees_payload() {
+	std::shared_ptr<int> resource = std::make_shared<int>(1);
+	ArenaNodeList<std::shared_ptr<int>>::Arena arena;
+	{
+		ArenaNodeList<std::shared_ptr<int>> list(arena);
+		list.emplace_back(resource);
+		assert(resource.use_count() == 2);
+		list.erase(list.begin());
+		assert(resource.use_count() == 1);
+
+		list.emplace_back(resource);
+		list.emplace_back(resource);
+		assert(resource.use_count() == 3);
+	}
+	// Destructing the list destroys its values.
+	assert(resource.use_count() == 1);
+
+	// The freed slots are reused.
+	ArenaNodeList<std::shared_ptr<int>> list(arena);
+	for (int i{ 0 }; i < 12; i++) {
+		list.emplace_back(resource);
+	}
+	assert(arena.capacity() == 16);
+}
+
+struct ThrowingValue {
+	explicit ThrowingValue(bool fail) {
+		if (fail) {
+			throw std::runtime_error("Construction failed.");
+		}
+	};
+};
+
+static void test_failed_construction_returns_slot() {
+	ArenaNodeList<ThrowingValue>::Arena arena;
+	ArenaNodeList<ThrowingValue> list(arena);
+
+	for (int i{ 0 }; i < 100; i++) {
+		try {
+			list.emplace_back(false);
+			list.emplace_front(true);
+		}
+		catch (const std::runtime_error&) {
+		}
+		list.pop_back();
+	}
+
+	// Two sentinels and the two slots reused on every round.
+	assert(arena.capacity() == 16);
+	assert(list.is_empty());
+}
+
+static void test_iterators() {
+	ArenaNodeList<int>::Arena arena;
+	ArenaNodeList<int> list(arena);
+	list.emplace_back(1);
+	list.emplace_back(2);
+
+	ArenaNodeList<int>::iterator it = list.end();
+	assert(it.is_past_the_end());
+	--it;
+	assert(*it == 2);
+	--it;
+	assert(*it == 1);
+	assert(it.is_at_datanode());
+	--it;
+	assert(it.is_before_the_start());
+	assert(!it.is_at_datanode());
+
+	bool has_thrown = false;
+	try {
+		--it;
+	}
+	catch (const std::runtime_error&) {
+		has_thrown = true;
+	}
+	assert(has_thrown);
+
+	has_thrown = false;
+	try {
+		*list.end();
+	}
+	catch (const std::runtime_error&) {
+		has_thrown = true;
+	}
+	assert(has_thrown);
+
+	ArenaNodeList<int>::const_iterator const_it = list.begin();
+	assert(const_it == list.cbegin());
+}
+
+int main() {
+	test_element_size();
+	test_emplace_and_erase();
+	test_lists_share_an_arena();
+	test_growth_keeps_links();
+	test_emplace_from_own_value();
+	test_payloads_need_no_default_constructor();
+	test_erase_frees_payload();
+	test_failed_construction_returns_slot();
+	test_iterators();
+	std::puts("arena_node_list_test passed");
+}
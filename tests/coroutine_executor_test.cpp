@@ -0,0 +1,185 @@
+// MIT License
+
+// Copyright(c) 2021 Golden Rockefeller
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+// Build and run (the executors need C++20):
+//   g++ -std=c++20 -g -fsanitize=address,undefined -pthread tests/coroutine_executor_test.cpp -o coroutine_executor_test && ./coroutine_executor_test
+
+#undef NDEBUG
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "../coroutine_executor.hpp"
+
+#if defined(GOLDENROCKEFELLER_HAS_COROUTINES)
+
+using namespace goldenrockefeller;
+
+// Counts the frames that are alive.
+struct FrameCounter {
+	static int alive;
+
+	FrameCounter() noexcept { alive++; }
+	~FrameCounter() { alive--; }
+};
+
+int FrameCounter::alive{ 0 };
+
+static Task record_rounds(SingleThreadExecutor& executor, std::string& trace, char name, int rounds) {
+	FrameCounter counter;
+	for (int round{ 0 }; round < rounds; round++) {
+		trace += name;
+		co_await executor.yield();
+	}
+}
+
+static void test_round_robin() {
+	std::string trace;
+	{
+		SingleThreadExecutor executor;
+		executor.spawn(record_rounds(executor, trace, 'a', 3));
+		executor.spawn(record_rounds(executor, trace, 'b', 1));
+		executor.spawn(record_rounds(executor, trace, 'c', 2));
+		assert(trace.empty());
+
+		executor.run();
+		assert(trace == "abcaca");
+		assert(FrameCounter::alive == 0);
+	}
+
+	// Frames of tasks that did not finish are destroyed with the executor,
+	// and tasks that were never spawned with their handle.
+	{
+		SingleThreadExecutor executor;
+		executor.spawn(record_rounds(executor, trace, 'd', 10));
+		Task unspawned = record_rounds(executor, trace, 'e', 1);
+		assert(executor.run_once());
+		// The unspawned task has not started, so only one counter exists.
+		assert(FrameCounter::alive == 1);
+
+		Task spawned = record_rounds(executor, trace, 'f', 1);
+		executor.schedule(spawned.release());
+		bool has_thrown = false;
+		try {
+			spawned.release();
+		}
+		catch (const std::runtime_error&) {
+			has_thrown = true;
+		}
+		assert(has_thrown);
+	}
+	assert(FrameCounter::alive == 0);
+}
+
+static Task sleep_and_record(SingleThreadExecutor& executor, std::vector<int>& order, int milliseconds) {
+	co_await executor.sleep_for(std::chrono::milliseconds(milliseconds));
+	order.push_back(milliseconds);
+}
+
+static void test_sleep_order() {
+	SingleThreadExecutor executor;
+	std::vector<int> order;
+
+	for (int milliseconds : { 30, 10, 20, 0 }) {
+		executor.spawn(sleep_and_record(executor, order, milliseconds));
+	}
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	executor.run();
+	assert(std::chrono::steady_clock::now() - start >= std::chrono::milliseconds(30));
+	assert(order == (std::vector<int>{ 0, 10, 20, 30 }));
+}
+
+static Task count_yields(ThreadPoolExecutor& executor, std::atomic<int>& count, int yields) {
+	for (int i{ 0 }; i < yields; i++) {
+		count.fetch_add(1, std::memory_order_relaxed);
+		co_await executor.yield();
+	}
+}
+
+static Task lock_and_increment(ThreadPoolExecutor& executor, FairMutex& mutex, long& counter) {
+	for (int i{ 0 }; i < 50; i++) {
+		co_await mutex.lock_async();
+		counter++;
+		mutex.unlock();
+		co_await executor.yield();
+	}
+}
+
+static Task sleep_briefly(ThreadPoolExecutor& executor, std::atomic<int>& count) {
+	co_await executor.sleep_for(std::chrono::milliseconds(5));
+	count.fetch_add(1, std::memory_order_relaxed);
+}
+
+static void test_thread_pool() {
+	ThreadPoolExecutor executor(3, 8);
+	assert(executor.thread_count() == 3);
+
+	std::atomic<int> count{ 0 };
+	for (int i{ 0 }; i < 200; i++) {
+		executor.spawn(count_yields(executor, count, 100));
+	}
+	for (int i{ 0 }; i < 20; i++) {
+		executor.spawn(sleep_briefly(executor, count));
+	}
+	executor.wait_idle();
+	assert(count.load() == 200 * 100 + 20);
+
+	FairMutex mutex;
+	long counter{ 0 };
+	for (int i{ 0 }; i < 40; i++) {
+		executor.spawn(lock_and_increment(executor, mutex, counter));
+	}
+	executor.wait_idle();
+	mutex.lock();
+	assert(counter == 40 * 50);
+	mutex.unlock();
+
+	bool has_thrown = false;
+	try {
+		ThreadPoolExecutor invalid(1, 0);
+	}
+	catch (const std::invalid_argument&) {
+		has_thrown = true;
+	}
+	assert(has_thrown);
+}
+
+int main() {
+	test_round_robin();
+	test_sleep_order();
+	test_thread_pool();
+	std::puts("coroutine_executor_test passed");
+}
+
+#else
+
+int main() {
+	std::puts("coroutine_executor_test skipped: C++20 coroutines are not available");
+}
+
+#endif
@@ -0,0 +1,194 @@
+// MIT License
+
+// Copyright(c) 2021 Golden Rockefeller
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+// Build and run:
+//   g++ -std=c++17 -g -fsanitize=address,undefined -pthread tests/flat_combining_node_list_test.cpp -o flat_combining_node_list_test && ./flat_combining_node_list_test
+//
+// The stress test is also meant to be run under -fsanitize=thread.
+
+#undef NDEBUG
+#include <cassert>
+#include <cstdio>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "../flat_combining_node_list.hpp"
+
+using namespace goldenrockefeller;
+
+using List = FlatCombiningNodeList<int>;
+
+static std::vector<int> values_of(List& list) {
+	List::list_type& nodes = list.unsynchronized_list();
+	return std::vector<int>(nodes.begin(), nodes.end());
+}
+
+static void test_single_thread() {
+	List list(2);
+	assert(list.max_handle_count() == 2);
+
+	std::vector<List::DataNode> nodes;
+	nodes.reserve(4);
+	for (int i{ 0 }; i < 4; i++) {
+		nodes.emplace_back(i);
+	}
+
+	List::Handle handle(list);
+	assert(handle.pop_front() == nullptr);
+	assert(handle.pop_back() == nullptr);
+
+	handle.push_back(nodes[1]);
+	handle.push_back(nodes[2]);
+	handle.push_front(nodes[0]);
+	handle.push_back(nodes[3]);
+	assert(values_of(list) == (std::vector<int>{ 0, 1, 2, 3 }));
+
+	// Pushing a node that is already at that end leaves it there.
+	handle.push_front(nodes[0]);
+	handle.push_back(nodes[3]);
+	assert(values_of(list) == (std::vector<int>{ 0, 1, 2, 3 }));
+
+	// Pushing an attached node moves it.
+	handle.push_front(nodes[2]);
+	assert(values_of(list) == (std::vector<int>{ 2, 0, 1, 3 }));
+
+	handle.detach(nodes[0]);
+	assert(!nodes[0].is_attached());
+	assert(values_of(list) == (std::vector<int>{ 2, 1, 3 }));
+
+	assert(handle.pop_front() == &nodes[2]);
+	assert(handle.pop_back() == &nodes[3]);
+	assert(!nodes[2].is_attached() && !nodes[3].is_attached());
+	assert(values_of(list) == (std::vector<int>{ 1 }));
+
+	list.unsynchronized_list().clear();
+}
+
+static void test_handles() {
+	List list(2);
+
+	{
+		List::Handle first(list);
+		List::Handle second(list);
+
+		bool has_thrown = false;
+		try {
+			List::Handle third(list);
+		}
+		catch (const std::length_error&) {
+			has_thrown = true;
+		}
+		assert(has_thrown);
+	}
+
+	// Destructed handles give their slots back.
+	List::Handle first(list);
+	List::Handle second(list);
+
+	bool has_thrown = false;
+	try {
+		List empty(0);
+	}
+	catch (const std::invalid_argument&) {
+		has_thrown = true;
+	}
+	assert(has_thrown);
+}
+
+// Threads push the nodes they hold at either end and pop nodes from either
+// end. A popped node belongs to the popping thread alone, so every node must
+// end up either held by exactly one thread or in the list.
+static void test_stress() {
+	const int thread_count{ 8 };
+	const int nodes_per_thread{ 16 };
+	const int operation_count{ 40000 };
+	const int node_count{ thread_count * nodes_per_thread };
+
+	List list(thread_count);
+	std::unique_ptr<List::DataNode[]> nodes(new List::DataNode[node_count]);
+	for (int i{ 0 }; i < node_count; i++) {
+		nodes[i].data = i;
+	}
+
+	std::vector<std::vector<List::DataNode*>> held(thread_count);
+	std::vector<std::thread> threads;
+
+	for (int thread{ 0 }; thread < thread_count; thread++) {
+		threads.emplace_back([&, thread]() {
+			List::Handle handle(list);
+			std::vector<List::DataNode*>& mine = held[thread];
+			for (int i{ 0 }; i < nodes_per_thread; i++) {
+				mine.push_back(&nodes[thread * nodes_per_thread + i]);
+			}
+
+			for (int i{ 0 }; i < operation_count; i++) {
+				if (!mine.empty() && i % 3 != 2) {
+					List::DataNode* node = mine.back();
+					mine.pop_back();
+					if (i % 2 == 0) {
+						handle.push_back(*node);
+					}
+					else {
+						handle.push_front(*node);
+					}
+				}
+				else {
+					List::DataNode* node = i % 2 == 0 ? handle.pop_front() : handle.pop_back();
+					if (node) {
+						assert(!node->is_attached());
+						mine.push_back(node);
+					}
+				}
+			}
+		});
+	}
+
+	for (std::thread& thread : threads) {
+		thread.join();
+	}
+
+	std::vector<int> seen(node_count, 0);
+	for (const std::vector<List::DataNode*>& mine : held) {
+		for (List::DataNode* node : mine) {
+			assert(!node->is_attached());
+			seen[node->data]++;
+		}
+	}
+	for (int value : list.unsynchronized_list()) {
+		seen[value]++;
+	}
+	for (int i{ 0 }; i < node_count; i++) {
+		assert(seen[i] == 1);
+	}
+
+	list.unsynchronized_list().clear();
+}
+
+int main() {
+	test_single_thread();
+	test_handles();
+	test_stress();
+	std::puts("flat_combining_node_list_test passed");
+}
@@ -0,0 +1,176 @@
+// MIT License
+
+// Copyright(c) 2021 Golden Rockefeller
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+// Build and run:
+//   g++ -std=c++17 -g -fsanitize=address,undefined -pthread tests/lock_free_node_stack_test.cpp -o lock_free_node_stack_test && ./lock_free_node_stack_test
+//
+// The stress test is also meant to be run under -fsanitize=thread.
+
+#undef NDEBUG
+#include <atomic>
+#include <cassert>
+#include <cstdio>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "../lock_free_node_stack.hpp"
+
+using namespace goldenrockefeller;
+
+using Stack = LockFreeNodeStack<int>;
+
+static void test_single_thread() {
+	Stack stack;
+	Stack::DataNode a(1);
+	Stack::DataNode b(2);
+	Stack::DataNode c(3);
+
+	assert(stack.is_empty_estimate());
+	assert(stack.pop() == nullptr);
+
+	stack.push(a);
+	stack.push(b);
+	assert(!stack.is_empty_estimate());
+	assert(stack.pop() == &b);
+	assert(!b.is_attached());
+
+	Stack::list_type list;
+	b.attach_to(list);
+	c.attach_to(list);
+
+	bool has_thrown = false;
+	try {
+		stack.push(b);
+	}
+	catch (const std::invalid_argument&) {
+		has_thrown = true;
+	}
+	assert(has_thrown);
+
+	// The front of the list becomes the top of the stack.
+	stack.push_list(list);
+	assert(list.is_empty());
+	assert(stack.pop() == &b);
+	assert(stack.pop() == &c);
+	assert(stack.pop() == &a);
+	assert(stack.pop() == nullptr);
+
+	stack.push(a);
+	stack.push(b);
+	stack.push(c);
+	Stack::list_type popped = stack.pop_all();
+	assert(stack.is_empty_estimate());
+	assert(popped.size() == 3);
+	assert(popped.front_node() == &c);
+	assert(popped.back_node() == &a);
+	popped.clear();
+}
+
+// Threads pop nodes, take exclusive ownership of each, and push them back
+// singly or as lists. A node handed to two threads at once, or lost, fails
+// the test.
+static void test_stress() {
+	const int node_count{ 64 };
+	const int thread_count{ 4 };
+	const int iteration_count{ 50000 };
+
+	Stack stack;
+	std::unique_ptr<Stack::DataNode[]> nodes(new Stack::DataNode[node_count]);
+	std::unique_ptr<std::atomic<int>[]> owners(new std::atomic<int>[node_count]);
+	for (int i{ 0 }; i < node_count; i++) {
+		nodes[i].data = i;
+		owners[i].store(-1, std::memory_order_relaxed);
+		stack.push(nodes[i]);
+	}
+
+	auto take = [&](Stack::DataNode* node, int thread) {
+		int expected{ -1 };
+		bool is_exclusive = owners[node->data].compare_exchange_strong(expected, thread);
+		assert(is_exclusive);
+		static_cast<void>(is_exclusive);
+	};
+	auto give_back = [&](Stack::DataNode* node) {
+		owners[node->data].store(-1, std::memory_order_relaxed);
+	};
+
+	std::vector<std::thread> threads;
+	for (int thread{ 0 }; thread < thread_count; thread++) {
+		threads.emplace_back([&, thread]() {
+			Stack::list_type list;
+			for (int iteration{ 0 }; iteration < iteration_count; iteration++) {
+				if (iteration % 101 == 0) {
+					Stack::list_type taken = stack.pop_all();
+					for (int& value : taken) {
+						take(&nodes[value], thread);
+					}
+					for (int& value : taken) {
+						give_back(&nodes[value]);
+					}
+					stack.push_list(taken);
+					continue;
+				}
+
+				for (int i{ 0 }; i < 3; i++) {
+					if (Stack::DataNode* node = stack.pop()) {
+						take(node, thread);
+						node->attach_to(list);
+					}
+				}
+
+				if (iteration % 2 == 0) {
+					for (int& value : list) {
+						give_back(&nodes[value]);
+					}
+					stack.push_list(list);
+				}
+				else {
+					while (Stack::DataNode* node = list.front_node()) {
+						node->detach();
+						give_back(node);
+						stack.push(*node);
+					}
+				}
+			}
+		});
+	}
+	for (std::thread& thread : threads) {
+		thread.join();
+	}
+
+	Stack::list_type all = stack.pop_all();
+	assert(all.size() == std::size_t(node_count));
+	std::vector<bool> seen(node_count, false);
+	for (int value : all) {
+		assert(!seen[value]);
+		seen[value] = true;
+	}
+	all.clear();
+}
+
+int main() {
+	test_single_thread();
+	test_stress();
+	std::puts("lock_free_node_stack_test passed");
+}
@@ -0,0 +1,143 @@
+// MIT License
+
+// Copyright(c) 2021 Golden Rockefeller
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+// Build and run:
+//   g++ -std=c++11 -g -fsanitize=address,undefined tests/mapped_node_arena_test.cpp -o mapped_node_arena_test && ./mapped_node_arena_test
+
+#undef NDEBUG
+#include <cassert>
+#include <cstdio>
+#include <limits>
+#include <new>
+#include <stdexcept>
+
+#include "../mapped_node_arena.hpp"
+
+using namespace goldenrockefeller;
+
+static int live_count{ 0 };
+
+struct Counted {
+	int value;
+
+	Counted() : value{ 0 } {
+		live_count++;
+	};
+
+	explicit Counted(int value) : value{ value } {
+		live_count++;
+	};
+
+	Counted(const Counted& other) : value{ other.value } {
+		live_count++;
+	};
+
+	~Counted() {
+		live_count--;
+	};
+};
+
+using Arena = MappedNodeArena<Counted>;
+
+static void test_allocation(HugePages huge_pages, bool prefault) {
+	live_count = 0;
+	Arena::list_type list;
+
+	{
+		Arena arena(1000, huge_pages, prefault);
+		assert(arena.capacity() == 1000);
+		assert(arena.size() == 0);
+
+		// The arena only reports huge pages it asked for.
+		if (huge_pages == HugePages::none) {
+			assert(arena.huge_pages() == HugePages::none);
+		}
+		else if (huge_pages == HugePages::transparent) {
+			assert(arena.huge_pages() != HugePages::explicit_pool);
+		}
+
+		Arena::DataNode* previous = nullptr;
+		for (int i{ 0 }; i < 1000; i++) {
+			Arena::DataNode& node = arena.allocate(Counted(i));
+			assert(node.data.value == i);
+			if (previous) {
+				assert(&node == previous + 1);
+			}
+			previous = &node;
+			node.attach_to(list);
+		}
+		assert(arena.is_full());
+		assert(live_count == 1000);
+
+		bool has_thrown = false;
+		try {
+			arena.allocate();
+		}
+		catch (const std::bad_alloc&) {
+			has_thrown = true;
+		}
+		assert(has_thrown);
+		assert(arena.size() == 1000);
+
+		int expected{ 0 };
+		for (const Counted& data : list) {
+			assert(data.value == expected);
+			expected++;
+		}
+		assert(expected == 1000);
+	}
+
+	// Destructing the arena destructs its nodes, which detach themselves.
+	assert(live_count == 0);
+	assert(list.is_empty());
+}
+
+static void test_capacity_checks() {
+	bool has_thrown = false;
+	try {
+		Arena empty(0);
+	}
+	catch (const std::invalid_argument&) {
+		has_thrown = true;
+	}
+	assert(has_thrown);
+
+	has_thrown = false;
+	try {
+		Arena huge(std::numeric_limits<Arena::size_type>::max() / 2);
+	}
+	catch (const std::length_error&) {
+		has_thrown = true;
+	}
+	assert(has_thrown);
+}
+
+int main() {
+	test_allocation(HugePages::none, false);
+	test_allocation(HugePages::transparent, false);
+	test_allocation(HugePages::transparent, true);
+	test_allocation(HugePages::explicit_pool, false);
+	test_allocation(HugePages::explicit_pool, true);
+	test_capacity_checks();
+	std::puts("mapped_node_arena_test passed");
+}
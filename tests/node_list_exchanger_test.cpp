@@ -0,0 +1,212 @@
+// MIT License
+
+// Copyright(c) 2021 Golden Rockefeller
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+// Build and run:
+//   g++ -std=c++17 -g -fsanitize=address,undefined -pthread tests/node_list_exchanger_test.cpp -o node_list_exchanger_test && ./node_list_exchanger_test
+//
+// The stress test is also meant to be run under -fsanitize=thread.
+
+#undef NDEBUG
+#include <cassert>
+#include <cstdio>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "../node_list_exchanger.hpp"
+
+using namespace goldenrockefeller;
+
+using Exchanger = NodeListExchanger<int>;
+using List = Exchanger::list_type;
+
+static std::vector<int> values_of(const List& list) {
+	return std::vector<int>(list.begin(), list.end());
+}
+
+static void test_splice_and_swap() {
+	std::vector<List::DataNode> nodes;
+	nodes.reserve(5);
+	for (int i{ 0 }; i < 5; i++) {
+		nodes.emplace_back(i);
+	}
+
+	List a;
+	List b;
+	nodes[0].attach_to(a);
+	nodes[1].attach_to(a);
+	nodes[2].attach_to(b);
+	nodes[3].attach_to(b);
+
+	a.splice_back(b);
+	assert(b.is_empty());
+	assert(values_of(a) == (std::vector<int>{ 0, 1, 2, 3 }));
+	std::vector<int> reversed(a.rbegin(), a.rend());
+	assert(reversed == (std::vector<int>{ 3, 2, 1, 0 }));
+
+	// Splicing an empty list, or a list into itself, changes nothing.
+	a.splice_back(b);
+	a.splice_back(a);
+	assert(values_of(a) == (std::vector<int>{ 0, 1, 2, 3 }));
+
+	nodes[4].attach_to(b);
+	a.swap(b);
+	assert(values_of(a) == (std::vector<int>{ 4 }));
+	assert(values_of(b) == (std::vector<int>{ 0, 1, 2, 3 }));
+
+	// The nodes are linked to the sentinels of their new list.
+	nodes[4].detach();
+	assert(a.is_empty());
+	nodes[0].detach();
+	nodes[3].detach();
+	assert(values_of(b) == (std::vector<int>{ 1, 2 }));
+
+	a.swap(b);
+	assert(b.is_empty());
+	assert(values_of(a) == (std::vector<int>{ 1, 2 }));
+
+	// Moving a non-empty list repoints its end nodes at the new sentinels.
+	List moved(std::move(a));
+	assert(a.is_empty());
+	nodes[4].attach_to(moved);
+	assert(values_of(moved) == (std::vector<int>{ 1, 2, 4 }));
+	nodes[1].detach();
+	assert(values_of(moved) == (std::vector<int>{ 2, 4 }));
+}
+
+static void test_single_thread() {
+	Exchanger exchanger;
+	std::vector<List::DataNode> nodes;
+	nodes.reserve(5);
+	for (int i{ 0 }; i < 5; i++) {
+		nodes.emplace_back(i);
+	}
+
+	List batch;
+	List taken;
+
+	assert(!exchanger.has_batch());
+	assert(!exchanger.take(taken));
+
+	// Publishing an empty batch succeeds without handing anything over.
+	assert(exchanger.publish(batch));
+	assert(!exchanger.has_batch());
+
+	nodes[0].attach_to(batch);
+	nodes[1].attach_to(batch);
+	assert(exchanger.publish(batch));
+	assert(batch.is_empty());
+	assert(exchanger.has_batch());
+
+	// While the first batch is untaken, the next one stays with the producer.
+	nodes[2].attach_to(batch);
+	assert(!exchanger.publish(batch));
+	assert(values_of(batch) == (std::vector<int>{ 2 }));
+
+	nodes[3].attach_to(taken);
+	assert(exchanger.take(taken));
+	assert(!exchanger.has_batch());
+	assert(values_of(taken) == (std::vector<int>{ 3, 0, 1 }));
+
+	nodes[4].attach_to(batch);
+	assert(exchanger.publish(batch));
+	assert(exchanger.take(taken));
+	assert(values_of(taken) == (std::vector<int>{ 3, 0, 1, 2, 4 }));
+	assert(!exchanger.take(taken));
+}
+
+// The producer numbers the nodes of a pool as it batches them and the
+// consumer checks that every number arrives once and in order, then returns
+// the nodes through a second exchanger.
+static void test_stress() {
+	const int message_count{ 100000 };
+	const int node_count{ 256 };
+
+	Exchanger forward;
+	Exchanger backward;
+	std::unique_ptr<List::DataNode[]> nodes(new List::DataNode[node_count]);
+
+	List pool;
+	for (int i{ 0 }; i < node_count; i++) {
+		nodes[i].attach_to(pool);
+	}
+
+	std::thread consumer([&]() {
+		List received;
+		List returned;
+		int expected{ 0 };
+
+		while (expected < message_count) {
+			if (!forward.take(received)) {
+				std::this_thread::yield();
+			}
+			while (List::DataNode* node = received.front_node()) {
+				assert(node->data == expected);
+				expected++;
+				node->attach_to(returned);
+			}
+			backward.publish(returned);
+		}
+		while (!returned.is_empty()) {
+			if (!backward.publish(returned)) {
+				std::this_thread::yield();
+			}
+		}
+	});
+
+	List batch;
+	int next{ 0 };
+
+	while (next < message_count) {
+		backward.take(pool);
+		for (int i{ 0 }; i < 17 && next < message_count; i++) {
+			List::DataNode* node = pool.front_node();
+			if (!node) {
+				break;
+			}
+			node->data = next;
+			next++;
+			node->attach_to(batch);
+		}
+		if (!forward.publish(batch)) {
+			std::this_thread::yield();
+		}
+	}
+	while (!batch.is_empty()) {
+		if (!forward.publish(batch)) {
+			std::this_thread::yield();
+		}
+	}
+
+	consumer.join();
+	while (backward.take(pool)) {
+	}
+	assert(pool.size() == static_cast<List::size_type>(node_count));
+}
+
+int main() {
+	test_splice_and_swap();
+	test_single_thread();
+	test_stress();
+	std::puts("node_list_exchanger_test passed");
+}
@@ -0,0 +1,125 @@
+// MIT License
+
+// Copyright(c) 2021 Golden Rockefeller
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+// Checks the parts of NodeList that behave differently in release builds.
+// node_list.hpp is included with NDEBUG defined, as in a release build, and
+// the test's own asserts are enabled afterwards.
+//
+// Build and run:
+//   g++ -std=c++11 -g -fsanitize=address,undefined tests/node_list_release_test.cpp -o node_list_release_test && ./node_list_release_test
+
+#define NDEBUG
+#include "../node_list.hpp"
+
+#undef NDEBUG
+#include <algorithm>
+#include <cassert>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+using namespace goldenrockefeller;
+
+using NormalList = NodeList<int, false, LinkMode::normal>;
+
+template <typename ListType>
+static std::vector<int> values_of(const ListType& list) {
+	return std::vector<int>(list.begin(), list.end());
+}
+
+// In release builds, clear_and_dispose leaves the links of normal-mode
+// nodes as they were; a disposer that returns the nodes to a pool must not
+// write through them.
+static void test_dispose_to_pool() {
+	std::unique_ptr<NormalList::DataNode[]> nodes(new NormalList::DataNode[6]);
+	NormalList pool;
+	NormalList active;
+	for (int i{ 0 }; i < 6; i++) {
+		nodes[i].data = i;
+		nodes[i].attach_to(i == 0 ? pool : active);
+	}
+
+	active.clear_and_dispose([&](NormalList::DataNode& node) { node.attach_to(pool); });
+	assert(active.is_empty());
+	assert(values_of(pool) == (std::vector<int>{ 0, 1, 2, 3, 4, 5 }));
+	std::vector<int> reversed(pool.rbegin(), pool.rend());
+	assert(reversed == (std::vector<int>{ 5, 4, 3, 2, 1, 0 }));
+
+	// The nodes go round again, attached one by one and then in a range.
+	for (int round{ 0 }; round < 3; round++) {
+		pool.clear_and_dispose([&](NormalList::DataNode& node) {
+			if (node.data % 2) {
+				node.attach_to(active);
+			}
+			else {
+				active.begin().attach_node_before(node);
+			}
+		});
+		assert(pool.is_empty());
+		assert(values_of(active) == (std::vector<int>{ 4, 2, 0, 1, 3, 5 }));
+
+		std::vector<NormalList::DataNode*> disposed;
+		active.clear_and_dispose([&](NormalList::DataNode& node) { disposed.push_back(&node); });
+		std::sort(disposed.begin(), disposed.end(), [](NormalList::DataNode* a, NormalList::DataNode* b) {
+			return a->data < b->data;
+		});
+		pool.attach_range(disposed);
+		assert(active.is_empty());
+		assert(values_of(pool) == (std::vector<int>{ 0, 1, 2, 3, 4, 5 }));
+		reversed.assign(pool.rbegin(), pool.rend());
+		assert(reversed == (std::vector<int>{ 5, 4, 3, 2, 1, 0 }));
+	}
+
+	pool.clear();
+}
+
+// A disposer that frees some nodes and returns the others to a pool: the
+// returned nodes' stale links point at freed ones.
+static void test_dispose_and_free() {
+	NormalList pool;
+	NormalList active;
+	for (int i{ 0 }; i < 8; i++) {
+		(new NormalList::DataNode(i))->attach_to(active);
+	}
+
+	active.clear_and_dispose([&](NormalList::DataNode& node) {
+		if (node.data % 2) {
+			delete &node;
+		}
+		else {
+			node.attach_to(pool);
+		}
+	});
+	assert(active.is_empty());
+	assert(values_of(pool) == (std::vector<int>{ 0, 2, 4, 6 }));
+	std::vector<int> reversed(pool.rbegin(), pool.rend());
+	assert(reversed == (std::vector<int>{ 6, 4, 2, 0 }));
+
+	pool.clear_and_dispose([](NormalList::DataNode& node) { delete &node; });
+}
+
+int main() {
+	test_dispose_to_pool();
+	test_dispose_and_free();
+	std::puts("node_list_release_test passed");
+}
@@ -0,0 +1,580 @@
+// MIT License
+
+// Copyright(c) 2021 Golden Rockefeller
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+// Build and run:
+//   g++ -std=c++11 -g -fsanitize=address,undefined tests/node_list_test.cpp -o node_list_test && ./node_list_test
+
+#undef NDEBUG
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <list>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "../node_list.hpp"
+
+using namespace goldenrockefeller;
+
+using List = NodeList<int>;
+using TaggedList = NodeList<int, true>;
+
+template <typename ListType>
+static std::vector<int> values_of(const ListType& list) {
+	return std::vector<int>(list.begin(), list.end());
+}
+
+static void test_attach_and_detach() {
+	List list;
+	List::DataNode a(1);
+	List::DataNode b(2);
+	List::DataNode c(3);
+
+	a.attach_to(list);
+	c.attach_to(list);
+	b.attach_before(&c);
+	assert(values_of(list) == (std::vector<int>{ 1, 2, 3 }));
+	assert(list.size() == 3);
+
+	b.detach();
+	assert(!b.is_attached());
+	assert(values_of(list) == (std::vector<int>{ 1, 3 }));
+
+	b.attach_after(&c);
+	assert(values_of(list) == (std::vector<int>{ 1, 3, 2 }));
+
+	{
+		List::DataNode d(4);
+		d.attach_to(list);
+		assert(list.size() == 4);
+	}
+	// An auto-unlink node leaves its list when it is destructed.
+	assert(list.size() == 3);
+
+	list.clear();
+	assert(list.is_empty());
+	assert(!a.is_attached() && !b.is_attached() && !c.is_attached());
+}
+
+static void test_untagged_layout() {
+	static_assert(List::DataNode::flag_count == 0, "Untagged nodes hold no flags.");
+	static_assert(sizeof(List::DataNode) == sizeof(TaggedList::DataNode), "Flags take no extra space.");
+}
+
+static void test_flags() {
+	static_assert(TaggedList::DataNode::flag_count >= 2, "Tagged nodes hold at least one flag per link.");
+
+	TaggedList list;
+	TaggedList::DataNode a(1);
+	TaggedList::DataNode b(2);
+	TaggedList::DataNode c(3);
+	a.attach_to(list);
+	b.attach_to(list);
+	c.attach_to(list);
+
+	const unsigned all_flags = (1u << TaggedList::DataNode::flag_count) - 1;
+	b.set_flags(all_flags);
+	assert(b.flags() == all_flags);
+	assert(a.flags() == 0 && c.flags() == 0);
+
+	// Flags do not disturb traversal in either direction.
+	assert(values_of(list) == (std::vector<int>{ 1, 2, 3 }));
+	std::vector<int> reversed(list.rbegin(), list.rend());
+	assert(reversed == (std::vector<int>{ 3, 2, 1 }));
+
+	b.set_flags(0);
+	b.set_flag(0);
+	b.set_flag(TaggedList::DataNode::flag_count - 1);
+	assert(b.test_flag(0));
+	assert(!b.test_flag(1));
+	assert(b.test_flag(TaggedList::DataNode::flag_count - 1));
+	b.reset_flag(0);
+	assert(!b.test_flag(0));
+
+	// Relinking the neighbours keeps the flags.
+	a.detach();
+	c.detach();
+	a.attach_before(&b);
+	c.attach_after(&b);
+	assert(b.test_flag(TaggedList::DataNode::flag_count - 1));
+	assert(values_of(list) == (std::vector<int>{ 1, 2, 3 }));
+
+	// So do detach() and clear().
+	b.detach();
+	assert(!b.is_attached());
+	assert(b.test_flag(TaggedList::DataNode::flag_count - 1));
+	b.attach_to(list);
+	list.clear();
+	assert(!b.is_attached());
+	assert(b.test_flag(TaggedList::DataNode::flag_count - 1));
+
+	bool has_thrown = false;
+	try {
+		b.set_flag(TaggedList::DataNode::flag_count);
+	}
+	catch (const std::out_of_range&) {
+		has_thrown = true;
+	}
+	assert(has_thrown);
+}
+
+static void test_attach_range() {
+	List list;
+	std::vector<List::DataNode> nodes;
+	nodes.reserve(6);
+	for (int i{ 0 }; i < 6; i++) {
+		nodes.emplace_back(i);
+	}
+
+	// A range of references: the nodes themselves.
+	list.attach_range(nodes.begin() + 3, nodes.end());
+	assert(values_of(list) == (std::vector<int>{ 3, 4, 5 }));
+
+	// A range of pointers, before a node in the middle.
+	std::list<List::DataNode*> pointers{ &nodes[0], &nodes[1], &nodes[2] };
+	List::iterator pos = list.begin();
+	++pos;
+	list.attach_range_before(pos, pointers);
+	assert(values_of(list) == (std::vector<int>{ 3, 0, 1, 2, 4, 5 }));
+	assert(list.size() == 6);
+
+	// Nodes that are already attached, here or to another list, move.
+	List other;
+	List::DataNode extra(9);
+	extra.attach_to(other);
+	std::vector<List::DataNode*> moved{ &nodes[5], &extra, &nodes[4] };
+	list.attach_range_before(list.begin(), moved);
+	assert(values_of(list) == (std::vector<int>{ 5, 9, 4, 3, 0, 1, 2 }));
+	assert(other.is_empty());
+
+	// Invalid ranges leave the list as it was.
+	std::vector<List::DataNode*> with_null{ &nodes[0], nullptr };
+	bool has_thrown = false;
+	try {
+		list.attach_range(with_null);
+	}
+	catch (const std::invalid_argument&) {
+		has_thrown = true;
+	}
+	assert(has_thrown);
+
+	std::vector<List::DataNode*> with_position{ &nodes[1], &nodes[2] };
+	pos = list.end();
+	--pos;
+	has_thrown = false;
+	try {
+		list.attach_range_before(pos, with_position);
+	}
+	catch (const std::invalid_argument&) {
+		has_thrown = true;
+	}
+	assert(has_thrown);
+	assert(values_of(list) == (std::vector<int>{ 5, 9, 4, 3, 0, 1, 2 }));
+
+	std::vector<List::DataNode*> empty;
+	list.attach_range(empty);
+	assert(list.size() == 7);
+
+	list.clear();
+}
+
+static void test_remove_if_and_unique() {
+	List list;
+	for (int i{ 0 }; i < 9; i++) {
+		(new List::DataNode(i))->attach_to(list);
+	}
+
+	int disposed{ 0 };
+	List::size_type removed = list.remove_if(
+		[](int value) { return value % 3 == 0; },
+		[&disposed](List::DataNode& node) {
+			assert(!node.is_attached());
+			delete &node;
+			disposed++;
+		}
+	);
+	assert(removed == 3 && disposed == 3);
+	assert(values_of(list) == (std::vector<int>{ 1, 2, 4, 5, 7, 8 }));
+	std::vector<int> reversed(list.rbegin(), list.rend());
+	assert(reversed == (std::vector<int>{ 8, 7, 5, 4, 2, 1 }));
+
+	// A throwing predicate leaves the nodes it has not reached in the list.
+	bool has_thrown = false;
+	try {
+		list.remove_if(
+			[](int value) {
+				if (value == 5) {
+					throw std::runtime_error("five");
+				}
+				return value == 2;
+			},
+			[](List::DataNode& node) { delete &node; }
+		);
+	}
+	catch (const std::runtime_error&) {
+		has_thrown = true;
+	}
+	assert(has_thrown);
+	assert(values_of(list) == (std::vector<int>{ 1, 4, 5, 7, 8 }));
+	assert(list.size() == 5);
+
+	list.clear_and_dispose([](List::DataNode& node) { delete &node; });
+
+	for (int value : { 1, 1, 2, 3, 3, 3, 1, 4, 4 }) {
+		(new List::DataNode(value))->attach_to(list);
+	}
+	removed = list.unique(
+		[](int a, int b) { return a == b; },
+		[](List::DataNode& node) { delete &node; }
+	);
+	assert(removed == 4);
+	assert(values_of(list) == (std::vector<int>{ 1, 2, 3, 1, 4 }));
+
+	list.clear_and_dispose([](List::DataNode& node) { delete &node; });
+}
+
+static void test_partition() {
+	std::vector<List::DataNode> nodes;
+	nodes.reserve(8);
+	List list;
+	for (int i{ 0 }; i < 8; i++) {
+		nodes.emplace_back(i);
+		nodes.back().attach_to(list);
+	}
+
+	List odd = list.partition([](int value) { return value % 2 == 1; });
+	assert(values_of(list) == (std::vector<int>{ 0, 2, 4, 6 }));
+	assert(values_of(odd) == (std::vector<int>{ 1, 3, 5, 7 }));
+	std::vector<int> reversed(odd.rbegin(), odd.rend());
+	assert(reversed == (std::vector<int>{ 7, 5, 3, 1 }));
+
+	// Move assignment empties the target first and rewires the sentinels.
+	List target;
+	List::DataNode extra(100);
+	extra.attach_to(target);
+	target = std::move(odd);
+	assert(!extra.is_attached());
+	assert(odd.is_empty());
+	assert(values_of(target) == (std::vector<int>{ 1, 3, 5, 7 }));
+	nodes[3].detach();
+	assert(values_of(target) == (std::vector<int>{ 1, 5, 7 }));
+	nodes[7].detach();
+	assert(values_of(target) == (std::vector<int>{ 1, 5 }));
+
+	List empty = list.partition([](int) { return false; });
+	assert(empty.is_empty());
+	assert(list.size() == 4);
+
+	// A throwing predicate leaves every node in the list, the nodes selected
+	// so far at the back.
+	bool has_thrown = false;
+	try {
+		list.partition([](int value) {
+			if (value == 4) {
+				throw std::runtime_error("predicate");
+			}
+			return value < 4;
+		});
+	}
+	catch (const std::runtime_error&) {
+		has_thrown = true;
+	}
+	assert(has_thrown);
+	assert(values_of(list) == (std::vector<int>{ 4, 6, 0, 2 }));
+	std::vector<int> list_reversed(list.rbegin(), list.rend());
+	assert(list_reversed == (std::vector<int>{ 2, 0, 6, 4 }));
+}
+
+static void test_relocation() {
+	List list;
+	List::DataNode a(1);
+	a.attach_to(list);
+
+	// Moving a node takes its place in the list and leaves it detached.
+	List::DataNode b(std::move(a));
+	assert(!a.is_attached());
+	assert(b.is_attached());
+	assert(values_of(list) == (std::vector<int>{ 1 }));
+
+	// A detached node moves as a detached node.
+	List::DataNode c(std::move(a));
+	assert(!c.is_attached());
+
+	// Nodes survive the reallocations of a growing vector.
+	std::vector<List::DataNode> nodes;
+	for (int i{ 2 }; i < 100; i++) {
+		nodes.emplace_back(i);
+		nodes.back().attach_to(list);
+	}
+	std::vector<int> expected;
+	for (int i{ 1 }; i < 100; i++) {
+		expected.push_back(i);
+	}
+	assert(values_of(list) == expected);
+	std::vector<int> reversed(list.rbegin(), list.rend());
+	assert(reversed == std::vector<int>(expected.rbegin(), expected.rend()));
+
+	// Compacting the vector moves the survivors over the erased nodes, which
+	// leave the list.
+	nodes.erase(
+		std::remove_if(nodes.begin(), nodes.end(), [](const List::DataNode& node) { return node.data % 2 == 0; }),
+		nodes.end()
+	);
+	expected.clear();
+	expected.push_back(1);
+	for (int i{ 3 }; i < 100; i += 2) {
+		expected.push_back(i);
+	}
+	assert(values_of(list) == expected);
+	assert(list.size() == nodes.size() + 1);
+
+	// Move assignment detaches the target, even when it is the source's
+	// neighbour.
+	nodes[0] = std::move(nodes[1]);
+	assert(!nodes[1].is_attached());
+	assert(list.front_node() == &b);
+	assert(&*(++list.begin()) == &(nodes[0].data));
+	assert(nodes[0].data == 5);
+	nodes[0] = std::move(nodes[0]);
+	assert(nodes[0].data == 5 && nodes[0].is_attached());
+
+	list.clear();
+	nodes.clear();
+
+	// Flags move with the node, and the neighbours keep theirs.
+	TaggedList tagged_list;
+	TaggedList::DataNode d(1);
+	TaggedList::DataNode e(2);
+	TaggedList::DataNode f(3);
+	d.attach_to(tagged_list);
+	e.attach_to(tagged_list);
+	f.attach_to(tagged_list);
+	d.set_flags(1);
+	e.set_flags((1u << TaggedList::DataNode::flag_count) - 1);
+	f.set_flag(TaggedList::DataNode::flag_count - 1);
+
+	TaggedList::DataNode g(std::move(e));
+	assert(!e.is_attached() && e.flags() == 0);
+	assert(g.flags() == (1u << TaggedList::DataNode::flag_count) - 1);
+	assert(d.flags() == 1);
+	assert(f.test_flag(TaggedList::DataNode::flag_count - 1));
+	assert(values_of(tagged_list) == (std::vector<int>{ 1, 2, 3 }));
+	std::vector<int> tagged_reversed(tagged_list.rbegin(), tagged_list.rend());
+	assert(tagged_reversed == (std::vector<int>{ 3, 2, 1 }));
+	tagged_list.clear();
+}
+
+static void test_link_modes() {
+	using NormalList = NodeList<int, false, LinkMode::normal>;
+	using SafeList = NodeList<int, false, LinkMode::safe>;
+
+	{
+		// Normal nodes must be detached before they are destructed.
+		NormalList list;
+		NormalList::DataNode a(1);
+		NormalList::DataNode b(2);
+		a.attach_to(list);
+		b.attach_to(list);
+		assert(values_of(list) == (std::vector<int>{ 1, 2 }));
+		list.clear();
+	}
+
+	// A destructed safe node leaves its list and its links are poisoned.
+	SafeList list;
+	SafeList::DataNode a(1);
+	SafeList::DataNode c(3);
+	a.attach_to(list);
+
+	alignas(SafeList::DataNode) unsigned char storage[sizeof(SafeList::DataNode)];
+	SafeList::DataNode* b = new (storage) SafeList::DataNode(2);
+	b->attach_to(list);
+	c.attach_to(list);
+	b->~DataNode();
+	assert(values_of(list) == (std::vector<int>{ 1, 3 }));
+
+	std::uintptr_t links[2];
+	std::memcpy(links, storage, sizeof(links));
+	assert(links[0] == SafeList::DataNode::poison_address);
+	assert(links[1] == SafeList::DataNode::poison_address);
+
+	list.clear();
+}
+
+static void test_clear_and_dispose() {
+	std::vector<List::DataNode> nodes;
+	nodes.reserve(5);
+	List list;
+	for (int i{ 0 }; i < 5; i++) {
+		nodes.emplace_back(i);
+		nodes.back().attach_to(list);
+	}
+
+	std::vector<int> disposed;
+	list.clear_and_dispose([&](List::DataNode& node) {
+		assert(!node.is_attached());
+		disposed.push_back(node.data);
+	});
+	assert(list.is_empty());
+	assert(disposed == (std::vector<int>{ 0, 1, 2, 3, 4 }));
+
+	// The disposer may destruct the nodes.
+	using NormalList = NodeList<int, false, LinkMode::normal>;
+	NormalList normal_list;
+	for (int i{ 0 }; i < 5; i++) {
+		(new NormalList::DataNode(i))->attach_to(normal_list);
+	}
+	int count{ 0 };
+	normal_list.clear_and_dispose([&](NormalList::DataNode& node) {
+		count++;
+		delete &node;
+	});
+	assert(count == 5);
+	assert(normal_list.is_empty());
+
+	// If the disposer throws, the nodes it did not reach stay in the list.
+	for (List::DataNode& node : nodes) {
+		node.attach_to(list);
+	}
+	disposed.clear();
+	bool has_thrown = false;
+	try {
+		list.clear_and_dispose([&](List::DataNode& node) {
+			disposed.push_back(node.data);
+			if (node.data == 2) {
+				throw std::runtime_error("dispose");
+			}
+		});
+	}
+	catch (const std::runtime_error&) {
+		has_thrown = true;
+	}
+	assert(has_thrown);
+	assert(disposed == (std::vector<int>{ 0, 1, 2 }));
+	assert(!nodes[2].is_attached());
+	assert(values_of(list) == (std::vector<int>{ 3, 4 }));
+	std::vector<int> reversed(list.rbegin(), list.rend());
+	assert(reversed == (std::vector<int>{ 4, 3 }));
+
+	// Throwing on the last node leaves the list empty.
+	has_thrown = false;
+	try {
+		list.clear_and_dispose([&](List::DataNode& node) {
+			if (node.data == 4) {
+				throw std::runtime_error("dispose");
+			}
+		});
+	}
+	catch (const std::runtime_error&) {
+		has_thrown = true;
+	}
+	assert(has_thrown);
+	assert(list.is_empty());
+}
+
+static void test_snapshots() {
+	TaggedList list;
+	std::vector<TaggedList::DataNode> nodes;
+	nodes.reserve(20);
+	for (int i{ 0 }; i < 20; i++) {
+		nodes.emplace_back(i);
+		nodes.back().attach_to(list);
+		// Flags must not leak into the snapshot's pointers.
+		nodes.back().set_flags(static_cast<unsigned>(i) & ((1u << TaggedList::DataNode::flag_count) - 1));
+	}
+
+	std::vector<TaggedList::DataNode*> node_snapshot = list.snapshot_nodes();
+	assert(node_snapshot.size() == 20);
+	for (int i{ 0 }; i < 20; i++) {
+		assert(node_snapshot[i] == &nodes[i]);
+	}
+
+	TaggedList::DataNode* node_buffer[8];
+	assert(list.snapshot_nodes(node_buffer, 8) == 8);
+	assert(node_buffer[7] == &nodes[7]);
+
+	std::vector<int> values = list.snapshot();
+	assert(values == values_of(list));
+
+	// A short buffer takes the front of the list; a long one the whole list.
+	int buffer[32];
+	assert(list.snapshot(buffer, 5) == 5);
+	assert(buffer[4] == 4);
+	assert(list.snapshot(buffer, 32) == 20);
+	assert(buffer[19] == 19);
+
+	// Gather and scatter through the node snapshot.
+	for (int& value : values) {
+		value *= 10;
+	}
+	TaggedList::scatter(node_snapshot.data(), node_snapshot.size(), values.data());
+	assert(nodes[3].data == 30);
+	assert(nodes[3].flags() == 3);
+
+	std::vector<int> gathered(node_snapshot.size());
+	TaggedList::gather(node_snapshot.data(), node_snapshot.size(), gathered.data());
+	assert(gathered == values);
+
+	// Scatter by list walk stops at whichever ends first.
+	std::vector<int> ones(30, 1);
+	assert(list.scatter(ones.data(), 3) == 3);
+	assert(nodes[2].data == 1 && nodes[3].data == 30);
+	assert(list.scatter(ones.data(), ones.size()) == 20);
+	assert(nodes[19].data == 1);
+
+	list.clear();
+	assert(list.snapshot_nodes().empty());
+	assert(list.snapshot().empty());
+	assert(list.scatter(ones.data(), ones.size()) == 0);
+
+	// Values that are not trivially copyable are copy-assigned.
+	NodeList<std::string> string_list;
+	NodeList<std::string>::DataNode a(std::string("a"));
+	NodeList<std::string>::DataNode b(std::string("b"));
+	a.attach_to(string_list);
+	b.attach_to(string_list);
+	std::string strings[2];
+	assert(string_list.snapshot(strings, 2) == 2);
+	assert(strings[0] == "a" && strings[1] == "b");
+	strings[1] = "a much longer string than the one it replaces";
+	assert(string_list.scatter(strings, 2) == 2);
+	assert(b.data == strings[1]);
+	string_list.clear();
+}
+
+int main() {
+	test_attach_and_detach();
+	test_untagged_layout();
+	test_flags();
+	test_attach_range();
+	test_remove_if_and_unique();
+	test_partition();
+	test_relocation();
+	test_link_modes();
+	test_clear_and_dispose();
+	test_snapshots();
+	std::puts("node_list_test passed");
+}
@@ -0,0 +1,200 @@
+// MIT License
+
+// Copyright(c) 2021 Golden Rockefeller
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+// Build and run:
+//   g++ -std=c++17 -g -fsanitize=address,undefined -pthread tests/node_pool_test.cpp -o node_pool_test && ./node_pool_test
+//
+// The stress test is also meant to be run under -fsanitize=thread.
+
+#undef NDEBUG
+#include <cassert>
+#include <cstdio>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "../node_pool.hpp"
+#include "../spsc_node_queue.hpp"
+
+using namespace goldenrockefeller;
+
+using Pool = NodePool<int>;
+
+static void test_single_thread() {
+	Pool pool(2, 4, 2);
+	assert(pool.capacity() == 0);
+
+	Pool::Handle handle(pool);
+	Pool::list_type list;
+
+	// The first acquire allocates a slab; the next ones come from it.
+	std::set<Pool::DataNode*> acquired;
+	for (int i{ 0 }; i < 4; i++) {
+		Pool::DataNode& node = handle.acquire(i);
+		assert(!node.is_attached());
+		assert(node.data == i);
+		assert(acquired.insert(&node).second);
+		node.attach_to(list);
+	}
+	assert(pool.capacity() == 4);
+
+	// Releasing takes the node out of its list, and the pool hands it out
+	// again before allocating another slab.
+	Pool::DataNode* first = list.front_node();
+	handle.release(*first);
+	assert(list.size() == 3);
+	assert(&handle.acquire() == first);
+	assert(first->data == 0);
+	assert(pool.capacity() == 4);
+
+	Pool::DataNode& fifth = handle.acquire();
+	assert(acquired.count(&fifth) == 0);
+	assert(pool.capacity() == 8);
+
+	handle.release(*first);
+	handle.release(fifth);
+	while (Pool::DataNode* node = list.front_node()) {
+		handle.release(*node);
+	}
+}
+
+static void test_remote_release() {
+	Pool pool(3, 4, 2);
+	Pool::Handle home(pool);
+	Pool::Handle remote(pool);
+
+	std::vector<Pool::DataNode*> nodes;
+	for (int i{ 0 }; i < 4; i++) {
+		nodes.push_back(&home.acquire(i));
+	}
+
+	// Nodes released by another handle go back to their home in batches,
+	// either when a batch is full or on flush.
+	remote.release(*nodes[0]);
+	remote.release(*nodes[1]);
+	remote.release(*nodes[2]);
+	remote.flush();
+
+	std::set<Pool::DataNode*> returned;
+	for (int i{ 0 }; i < 3; i++) {
+		returned.insert(&home.acquire());
+	}
+	assert(returned == (std::set<Pool::DataNode*>{ nodes[0], nodes[1], nodes[2] }));
+	assert(pool.capacity() == 4);
+
+	for (Pool::DataNode* node : returned) {
+		home.release(*node);
+	}
+	home.release(*nodes[3]);
+
+	// A remote node released by a handle that is then destructed is not lost.
+	{
+		Pool::Handle other(pool);
+		Pool::DataNode& node = home.acquire();
+		other.release(node);
+	}
+	for (int i{ 0 }; i < 4; i++) {
+		home.acquire();
+	}
+	assert(pool.capacity() == 4);
+}
+
+static void test_construction() {
+	Pool pool(1);
+	{
+		Pool::Handle handle(pool);
+
+		bool has_thrown = false;
+		try {
+			Pool::Handle second(pool);
+		}
+		catch (const std::length_error&) {
+			has_thrown = true;
+		}
+		assert(has_thrown);
+	}
+	Pool::Handle handle(pool);
+
+	const Pool::size_type bad_arguments[][3] = { { 0, 1, 1 }, { 1, 0, 1 }, { 1, 1, 0 } };
+	for (const Pool::size_type* arguments : bad_arguments) {
+		bool has_thrown = false;
+		try {
+			Pool bad(arguments[0], arguments[1], arguments[2]);
+		}
+		catch (const std::invalid_argument&) {
+			has_thrown = true;
+		}
+		assert(has_thrown);
+	}
+}
+
+// A producer acquires numbered nodes and passes them to a consumer, which
+// checks the numbers and releases the nodes to the producer's cache. Every
+// node must arrive once, in order, and the pool must keep reusing the
+// returned nodes instead of growing.
+static void test_stress() {
+	const int message_count{ 200000 };
+	const Pool::size_type slab_size{ 64 };
+
+	Pool pool(2, slab_size, 8);
+	SpscNodeQueue<int> queue(256);
+
+	std::thread consumer([&]() {
+		Pool::Handle handle(pool);
+		int expected{ 0 };
+		while (expected < message_count) {
+			Pool::DataNode* node = queue.dequeue();
+			if (!node) {
+				handle.flush();
+				std::this_thread::yield();
+				continue;
+			}
+			assert(node->data == expected);
+			expected++;
+			handle.release(*node);
+		}
+	});
+
+	{
+		Pool::Handle handle(pool);
+		for (int i{ 0 }; i < message_count; i++) {
+			Pool::DataNode& node = handle.acquire(i);
+			while (!queue.enqueue(node)) {
+				std::this_thread::yield();
+			}
+		}
+		consumer.join();
+	}
+
+	// The queue and the batches in flight bound the live nodes.
+	assert(pool.capacity() <= 2 * (256 + 8 + slab_size));
+}
+
+int main() {
+	test_single_thread();
+	test_remote_release();
+	test_construction();
+	test_stress();
+	std::puts("node_pool_test passed");
+}
@@ -0,0 +1,243 @@
+// MIT License
+
+// Copyright(c) 2021 Golden Rockefeller
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+// Build and run:
+//   g++ -std=c++17 -g -fsanitize=address,undefined tests/owning_node_list_test.cpp -o owning_node_list_test && ./owning_node_list_test
+//
+// The std::pmr test needs C++17; in older modes only the other tests run.
+
+#undef NDEBUG
+#include <cassert>
+#include <cstddef>
+#include <cstdio>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "../owning_node_list.hpp"
+
+using namespace goldenrockefeller;
+
+static int allocated_count{ 0 };
+
+// Counts the nodes that are allocated and not yet deallocated.
+template <typename T>
+struct CountingAllocator {
+	using value_type = T;
+
+	CountingAllocator() noexcept {};
+
+	template <typename U>
+	CountingAllocator(const CountingAllocator<U>&) noexcept {};
+
+	T* allocate(std::size_t count) {
+		allocated_count += static_cast<int>(count);
+		return std::allocator<T>().allocate(count);
+	};
+
+	void deallocate(T* pointer, std::size_t count) noexcept {
+		allocated_count -= static_cast<int>(count);
+		std::allocator<T>().deallocate(pointer, count);
+	};
+};
+
+template <typename T, typename U>
+bool operator==(const CountingAllocator<T>&, const CountingAllocator<U>&) noexcept {
+	return true;
+}
+
+template <typename T, typename U>
+bool operator!=(const CountingAllocator<T>&, const CountingAllocator<U>&) noexcept {
+	return false;
+}
+
+using List = OwningNodeList<std::string, CountingAllocator<std::string>>;
+
+static std::vector<std::string> values_of(List& list) {
+	return std::vector<std::string>(list.begin(), list.end());
+}
+
+// Throws from its constructor when asked to.
+struct Fragile {
+	int value;
+
+	explicit Fragile(int value) : value{ value } {
+		if (value < 0) {
+			throw std::invalid_argument("negative");
+		}
+	};
+};
+
+static void test_emplace_and_erase() {
+	allocated_count = 0;
+
+	{
+		List list;
+		assert(list.is_empty());
+
+		list.emplace_back("b");
+		list.emplace_back(3, 'c');
+		list.emplace_front("a");
+		assert(values_of(list) == (std::vector<std::string>{ "a", "b", "ccc" }));
+		assert(list.size() == 3);
+		assert(allocated_count == 3);
+		assert(list.front() == "a" && list.back() == "ccc");
+
+		List::iterator it = list.begin();
+		++it;
+		it = list.emplace(it, "ab");
+		assert(*it == "ab");
+		it = list.emplace(list.end(), "d");
+		assert(*it == "d");
+		assert(values_of(list) == (std::vector<std::string>{ "a", "ab", "b", "ccc", "d" }));
+
+		it = list.erase(list.begin());
+		assert(*it == "ab");
+		assert(allocated_count == 4);
+
+		list.pop_front();
+		list.pop_back();
+		assert(values_of(list) == (std::vector<std::string>{ "b", "ccc" }));
+		assert(allocated_count == 2);
+
+		bool has_thrown = false;
+		try {
+			list.erase(list.end());
+		}
+		catch (const std::runtime_error&) {
+			has_thrown = true;
+		}
+		assert(has_thrown);
+
+		list.clear();
+		assert(list.is_empty());
+		assert(allocated_count == 0);
+
+		has_thrown = false;
+		try {
+			list.front();
+		}
+		catch (const std::runtime_error&) {
+			has_thrown = true;
+		}
+		assert(has_thrown);
+
+		has_thrown = false;
+		try {
+			list.pop_back();
+		}
+		catch (const std::runtime_error&) {
+			has_thrown = true;
+		}
+		assert(has_thrown);
+
+		list.emplace_back("left to the destructor");
+	}
+
+	assert(allocated_count == 0);
+}
+
+static void test_throwing_constructor() {
+	allocated_count = 0;
+
+	OwningNodeList<Fragile, CountingAllocator<Fragile>> list;
+	list.emplace_back(1);
+
+	bool has_thrown = false;
+	try {
+		list.emplace_back(-1);
+	}
+	catch (const std::invalid_argument&) {
+		has_thrown = true;
+	}
+	assert(has_thrown);
+	assert(list.size() == 1);
+	assert(allocated_count == 1);
+}
+
+static void test_interop() {
+	allocated_count = 0;
+
+	List list;
+	List::DataNode& a = list.emplace_back("a");
+	List::DataNode& b = list.emplace_back("b");
+	list.emplace_back("c");
+
+	// Owned nodes can move to a plain NodeList and back.
+	List::list_type plain;
+	b.attach_to(plain);
+	assert(values_of(list) == (std::vector<std::string>{ "a", "c" }));
+	assert(plain.front_node() == &b);
+
+	list.get_list().iterator_to(a).attach_node_after(b);
+	assert(plain.is_empty());
+	assert(values_of(list) == (std::vector<std::string>{ "a", "b", "c" }));
+
+	// A node moved out is freed through dispose.
+	b.attach_to(plain);
+	list.dispose(b);
+	assert(plain.is_empty());
+	assert(allocated_count == 2);
+
+	// Moving the list takes its nodes.
+	List moved(std::move(list));
+	assert(list.is_empty());
+	assert(values_of(moved) == (std::vector<std::string>{ "a", "c" }));
+	moved.clear();
+	assert(allocated_count == 0);
+}
+
+static void test_memory_resource() {
+#if defined(GOLDENROCKEFELLER_HAS_MEMORY_RESOURCE)
+	// Every node comes from the buffer: the upstream resource refuses to
+	// allocate.
+	std::byte buffer[4096];
+	std::pmr::monotonic_buffer_resource resource(buffer, sizeof(buffer), std::pmr::null_memory_resource());
+
+	pmr::OwningNodeList<int> list(&resource);
+	assert(list.get_allocator().resource() == &resource);
+
+	for (int i{ 0 }; i < 10; i++) {
+		list.emplace_back(i);
+	}
+	list.pop_front();
+
+	int expected{ 1 };
+	for (int value : list) {
+		assert(value == expected);
+		expected++;
+	}
+	assert(expected == 10);
+#else
+	std::puts("owning_node_list_test: std::pmr test skipped, it needs C++17");
+#endif
+}
+
+int main() {
+	test_emplace_and_erase();
+	test_throwing_constructor();
+	test_interop();
+	test_memory_resource();
+	std::puts("owning_node_list_test passed");
+}
@@ -0,0 +1,250 @@
+// MIT License
+
+// Copyright(c) 2021 Golden Rockefeller
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+// Build and run:
+//   g++ -std=c++11 -g -fsanitize=address,undefined -pthread tests/parallel_algorithms_test.cpp -o parallel_algorithms_test && ./parallel_algorithms_test
+//
+// Also meant to be run under -fsanitize=thread.
+
+#undef NDEBUG
+#include <cassert>
+#include <cstddef>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "../parallel_algorithms.hpp"
+
+using namespace goldenrockefeller;
+
+using List = NodeList<int>;
+
+static void test_split_into_chunks() {
+	std::vector<List::DataNode> nodes;
+	nodes.reserve(300);
+	for (int i{ 0 }; i < 300; i++) {
+		nodes.emplace_back(i);
+	}
+
+	for (std::size_t size{ 0 }; size <= nodes.size(); size++) {
+		List list;
+		list.attach_range(nodes.data(), nodes.data() + size);
+
+		for (std::size_t chunk_count{ 1 }; chunk_count <= 9; chunk_count++) {
+			std::vector<List::iterator> chunk_starts = split_into_chunks(list, chunk_count);
+			std::size_t min_chunk_count = size < chunk_count ? size : chunk_count;
+			assert(chunk_starts.size() >= min_chunk_count);
+			assert(chunk_starts.size() <= 2 * chunk_count);
+
+			if (size == 0) {
+				continue;
+			}
+
+			// The chunks cover the list in order; all but the last have the
+			// same length, and the last is no longer.
+			assert(chunk_starts.front() == list.begin());
+			std::size_t stride = static_cast<std::size_t>(*chunk_starts[1 % chunk_starts.size()] - *chunk_starts[0]);
+			for (std::size_t i{ 0 }; i < chunk_starts.size(); i++) {
+				int start = *chunk_starts[i];
+				int end = i + 1 < chunk_starts.size() ? *chunk_starts[i + 1] : static_cast<int>(size);
+				assert(end > start);
+				if (i + 1 < chunk_starts.size()) {
+					assert(static_cast<std::size_t>(end - start) == stride);
+				}
+				else if (chunk_starts.size() > 1) {
+					assert(static_cast<std::size_t>(end - start) <= stride);
+				}
+			}
+		}
+
+		list.clear();
+	}
+
+	List list;
+	bool has_thrown = false;
+	try {
+		split_into_chunks(list, 0);
+	}
+	catch (const std::invalid_argument&) {
+		has_thrown = true;
+	}
+	assert(has_thrown);
+}
+
+static void test_algorithms() {
+	const int size{ 10000 };
+	std::vector<List::DataNode> nodes;
+	nodes.reserve(size);
+	List list;
+	for (int i{ 0 }; i < size; i++) {
+		nodes.emplace_back(0);
+		nodes.back().attach_to(list);
+	}
+
+	// Every node is visited exactly once.
+	int round{ 0 };
+	for (std::size_t thread_count{ 1 }; thread_count <= 8; thread_count++) {
+		parallel_for_each(list, [](int& value) { value++; }, thread_count);
+		round++;
+		for (List::DataNode& node : nodes) {
+			assert(node.data == round);
+		}
+	}
+
+	int index{ 0 };
+	for (List::DataNode& node : nodes) {
+		node.data = index++;
+	}
+
+	for (std::size_t thread_count{ 1 }; thread_count <= 8; thread_count++) {
+		long sum = parallel_transform_reduce(
+			list,
+			0L,
+			[](long a, long b) { return a + b; },
+			[](int value) { return long(value); },
+			thread_count
+		);
+		assert(sum == long(size) * (size - 1) / 2);
+
+		std::size_t odd_count = parallel_count_if(list, [](int value) { return value % 2 == 1; }, thread_count);
+		assert(odd_count == size / 2);
+	}
+
+	// A reduction that is associative but not commutative comes out in list
+	// order.
+	List short_list;
+	for (int i{ 0 }; i < 40; i++) {
+		nodes[i].attach_to(short_list);
+	}
+	std::string expected("<");
+	for (int i{ 0 }; i < 40; i++) {
+		expected += std::to_string(i) + ",";
+	}
+	std::string concatenated = parallel_transform_reduce(
+		short_list,
+		std::string("<"),
+		[](std::string a, const std::string& b) { return a + b; },
+		[](int value) { return std::to_string(value) + ","; },
+		4
+	);
+	assert(concatenated == expected);
+
+	// An empty list reduces to init.
+	short_list.clear();
+	assert(parallel_count_if(short_list, [](int) { return true; }, 4) == 0);
+	assert(parallel_transform_reduce(short_list, 7, [](int a, int b) { return a + b; }, [](int v) { return v; }, 4) == 7);
+
+	list.clear();
+}
+
+static void test_reused_split() {
+	const int size{ 10000 };
+	std::vector<List::DataNode> nodes;
+	nodes.reserve(size);
+	List list;
+	for (int i{ 0 }; i < size; i++) {
+		nodes.emplace_back(i);
+		nodes.back().attach_to(list);
+	}
+
+	// One split serves several algorithms while the list is unchanged.
+	for (std::size_t thread_count{ 1 }; thread_count <= 8; thread_count++) {
+		std::vector<List::iterator> chunk_starts = split_for_threads(list, thread_count);
+
+		parallel_for_each(list, chunk_starts, [](int& value) { value += 2; }, thread_count);
+		long sum = parallel_transform_reduce(
+			list,
+			chunk_starts,
+			0L,
+			[](long a, long b) { return a + b; },
+			[](int value) { return long(value); },
+			thread_count
+		);
+		assert(sum == long(size) * (size - 1) / 2 + 2L * size);
+
+		std::size_t odd_count = parallel_count_if(list, chunk_starts, [](int value) { return value % 2 == 1; }, thread_count);
+		assert(odd_count == size / 2);
+
+		parallel_for_each(list, chunk_starts, [](int& value) { value -= 2; }, thread_count);
+	}
+
+	// Boolean results of different chunks are kept apart, so threads do not
+	// race on a packed std::vector<bool>.
+	for (std::size_t thread_count{ 1 }; thread_count <= 8; thread_count++) {
+		for (int target : { -1, 0, size / 2, size - 1 }) {
+			bool found = parallel_transform_reduce(
+				list,
+				false,
+				[](bool a, bool b) { return a || b; },
+				[target](int value) { return value == target; },
+				thread_count
+			);
+			assert(found == (target >= 0));
+		}
+	}
+
+	list.clear();
+}
+
+static void test_exceptions() {
+	std::vector<List::DataNode> nodes;
+	nodes.reserve(1000);
+	List list;
+	for (int i{ 0 }; i < 1000; i++) {
+		nodes.emplace_back(i);
+		nodes.back().attach_to(list);
+	}
+
+	bool has_thrown = false;
+	try {
+		parallel_for_each(list, [](int& value) {
+			if (value == 500) {
+				throw std::runtime_error("element");
+			}
+		}, 4);
+	}
+	catch (const std::runtime_error&) {
+		has_thrown = true;
+	}
+	assert(has_thrown);
+
+	has_thrown = false;
+	try {
+		parallel_for_each(list, [](int&) {}, 0);
+	}
+	catch (const std::invalid_argument&) {
+		has_thrown = true;
+	}
+	assert(has_thrown);
+
+	list.clear();
+}
+
+int main() {
+	test_split_into_chunks();
+	test_algorithms();
+	test_reused_split();
+	test_exceptions();
+	std::puts("parallel_algorithms_test passed");
+}
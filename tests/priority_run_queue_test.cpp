@@ -0,0 +1,275 @@
+// MIT License
+
+// Copyright(c) 2021 Golden Rockefeller
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+// Build and run:
+//   g++ -std=c++11 -g -fsanitize=address,undefined tests/priority_run_queue_test.cpp -o priority_run_queue_test && ./priority_run_queue_test
+
+#undef NDEBUG
+#include <cassert>
+#include <cstdio>
+#include <deque>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "../priority_run_queue.hpp"
+
+using namespace goldenrockefeller;
+
+using Queue = PriorityRunQueue<int, 130>;
+
+static bool queue_is_empty(const Queue& queue) {
+	return queue.is_empty();
+}
+
+static void test_priority_order() {
+	Queue queue;
+	Queue::DataNode a(1);
+	Queue::DataNode b(2);
+	Queue::DataNode c(3);
+	Queue::DataNode d(4);
+
+	assert(queue_is_empty(queue));
+	assert(queue.highest_level() == Queue::level_count);
+
+	queue.enqueue(a, 129);
+	queue.enqueue(b, 64);
+	queue.enqueue(c, 64);
+	queue.enqueue(d, 3);
+	assert(!queue_is_empty(queue));
+	assert(queue.highest_level() == 3);
+
+	// Re-enqueuing moves a task to the back of its new level.
+	queue.change_priority(a, 3);
+	assert(queue.dequeue() == &d);
+	assert(queue.dequeue() == &a);
+	assert(queue.highest_level() == 64);
+	assert(queue.dequeue() == &b);
+	assert(queue.dequeue() == &c);
+	assert(queue.dequeue() == nullptr);
+	assert(queue_is_empty(queue));
+
+	bool has_thrown = false;
+	try {
+		queue.enqueue(a, Queue::level_count);
+	}
+	catch (const std::out_of_range&) {
+		has_thrown = true;
+	}
+	assert(has_thrown);
+}
+
+static void test_detached_tasks() {
+	Queue queue;
+	Queue::DataNode a(1);
+	Queue::DataNode b(2);
+
+	queue.enqueue(a, 5);
+	queue.enqueue(b, 70);
+
+	// The level of a task that detached itself is skipped by the const
+	// queries, and its stale bit is cleared by the next dequeue.
+	a.detach();
+	const Queue& view = queue;
+	assert(view.highest_level() == 70);
+	assert(!view.is_empty());
+	assert(queue.dequeue() == &b);
+	assert(view.is_empty());
+
+	{
+		Queue::DataNode c(3);
+		queue.enqueue(c, 0);
+	}
+	assert(view.is_empty());
+	assert(queue.dequeue() == nullptr);
+}
+
+static void test_dequeue_fair() {
+	PriorityRunQueue<int, 3> queue;
+	std::vector<PriorityRunQueue<int, 3>::DataNode> tasks;
+	tasks.reserve(300);
+	for (int i{ 0 }; i < 300; i++) {
+		tasks.emplace_back(i % 3);
+	}
+	for (PriorityRunQueue<int, 3>::DataNode& task : tasks) {
+		queue.enqueue(task, std::size_t(task.data));
+	}
+
+	queue.set_quantum(0, 3);
+	queue.set_quantum(1, 2);
+	queue.set_quantum(2, 1);
+
+	// While every level is busy, service follows the quanta.
+	int served[3] = { 0, 0, 0 };
+	for (int i{ 0 }; i < 60; i++) {
+		served[queue.dequeue_fair()->data]++;
+	}
+	assert(served[0] == 30 && served[1] == 20 && served[2] == 10);
+
+	// Costs are charged against the deficit.
+	queue.clear();
+	queue.set_quantum(0, 4);
+	queue.set_quantum(1, 4);
+	for (PriorityRunQueue<int, 3>::DataNode& task : tasks) {
+		if (task.data < 2) {
+			queue.enqueue(task, std::size_t(task.data));
+		}
+	}
+	served[0] = served[1] = 0;
+	for (int i{ 0 }; i < 50; i++) {
+		served[queue.dequeue_fair([](int level) { return level == 0 ? 4 : 1; })->data]++;
+	}
+	assert(served[0] == 10 && served[1] == 40);
+
+	bool has_thrown = false;
+	try {
+		queue.set_quantum(1, 0);
+	}
+	catch (const std::invalid_argument&) {
+		has_thrown = true;
+	}
+	assert(has_thrown);
+
+	// Draining the queue through dequeue_fair leaves it empty.
+	while (queue.dequeue_fair()) {
+	}
+	assert(queue.is_empty());
+}
+
+static void test_dequeue_fair_large_costs() {
+	PriorityRunQueue<long, 3> queue;
+	std::vector<PriorityRunQueue<long, 3>::DataNode> tasks;
+	tasks.reserve(40);
+	for (int i{ 0 }; i < 40; i++) {
+		tasks.emplace_back(i % 2);
+	}
+	for (PriorityRunQueue<long, 3>::DataNode& task : tasks) {
+		queue.enqueue(task, std::size_t(task.data));
+	}
+	queue.set_quantum(0, 3);
+
+	// Costs far above the quanta are reached without a visit per quantum,
+	// and service still follows the quanta.
+	long cost_calls{ 0 };
+	auto cost = [&cost_calls](long) {
+		cost_calls++;
+		return std::size_t{ 1000000000 };
+	};
+
+	int served[2] = { 0, 0 };
+	for (int i{ 0 }; i < 16; i++) {
+		served[queue.dequeue_fair(cost)->data]++;
+	}
+	assert(served[0] == 12 && served[1] == 4);
+	assert(cost_calls < 16 * 8);
+}
+
+// Deficit round robin one visit at a time, against which dequeue_fair is
+// checked.
+struct ReferenceDrr {
+	std::deque<int> levels[3];
+	std::size_t quanta[3];
+	std::size_t deficits[3] = { 0, 0, 0 };
+	std::size_t current_level{ 3 };
+
+	std::size_t next_ready_level(std::size_t level) {
+		for (std::size_t i{ 0 }; i < 3; i++) {
+			std::size_t candidate = (level + i) % 3;
+			if (!this->levels[candidate].empty()) {
+				return candidate;
+			}
+		}
+		return 3;
+	}
+
+	int dequeue(const std::vector<std::size_t>& costs) {
+		std::size_t level = this->current_level;
+		if (level == 3 || this->levels[level].empty()) {
+			if (level < 3) {
+				this->deficits[level] = 0;
+			}
+			level = this->next_ready_level(level < 3 ? level + 1 : 0);
+			if (level == 3) {
+				this->current_level = 3;
+				return -1;
+			}
+			this->deficits[level] += this->quanta[level];
+		}
+
+		for (;;) {
+			int task = this->levels[level].front();
+			if (costs[task] <= this->deficits[level]) {
+				this->deficits[level] -= costs[task];
+				this->current_level = level;
+				this->levels[level].pop_front();
+				if (this->levels[level].empty()) {
+					this->deficits[level] = 0;
+				}
+				return task;
+			}
+			level = this->next_ready_level(level + 1);
+			this->deficits[level] += this->quanta[level];
+		}
+	}
+};
+
+static void test_dequeue_fair_matches_reference() {
+	std::mt19937 random(7);
+
+	for (int trial{ 0 }; trial < 200; trial++) {
+		PriorityRunQueue<int, 3> queue;
+		ReferenceDrr reference;
+		std::vector<std::size_t> costs(60);
+		std::vector<PriorityRunQueue<int, 3>::DataNode> tasks;
+		tasks.reserve(costs.size());
+
+		for (std::size_t level{ 0 }; level < 3; level++) {
+			std::size_t quantum = 1 + random() % 5;
+			queue.set_quantum(level, quantum);
+			reference.quanta[level] = quantum;
+		}
+		for (int i{ 0 }; i < 60; i++) {
+			costs[i] = 1 + random() % 40;
+			std::size_t level = random() % 3;
+			tasks.emplace_back(i);
+			queue.enqueue(tasks.back(), level);
+			reference.levels[level].push_back(i);
+		}
+
+		auto cost = [&costs](int task) { return costs[task]; };
+		for (int i{ 0 }; i <= 60; i++) {
+			PriorityRunQueue<int, 3>::DataNode* task = queue.dequeue_fair(cost);
+			int expected = reference.dequeue(costs);
+			assert(task ? task->data == expected : expected == -1);
+		}
+	}
+}
+
+int main() {
+	test_priority_order();
+	test_detached_tasks();
+	test_dequeue_fair();
+	test_dequeue_fair_large_costs();
+	test_dequeue_fair_matches_reference();
+	std::puts("priority_run_queue_test passed");
+}
@@ -0,0 +1,240 @@
+// MIT License
+
+// Copyright(c) 2021 Golden Rockefeller
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+// Build and run:
+//   g++ -std=c++17 -g -fsanitize=address,undefined -pthread tests/rcu_node_list_test.cpp -o rcu_node_list_test && ./rcu_node_list_test
+//
+// The stress test is also meant to be run under -fsanitize=thread.
+
+#undef NDEBUG
+#include <atomic>
+#include <cassert>
+#include <cstdio>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "../rcu_node_list.hpp"
+
+using namespace goldenrockefeller;
+
+using List = RcuNodeList<int>;
+
+static std::atomic<int> disposed_count{ 0 };
+
+// Poisons the data before deleting the node, so that a reader that reached
+// a disposed node would see the poison if the sanitizers did not catch it.
+static void count_and_delete(List::DataNode* node) {
+	node->data = -1;
+	disposed_count.fetch_add(1, std::memory_order_relaxed);
+	delete node;
+}
+
+static std::vector<int> values_of(List::Reader& reader) {
+	std::vector<int> values;
+	reader.for_each([&](int value) { values.push_back(value); });
+	return values;
+}
+
+static void test_single_thread() {
+	disposed_count = 0;
+
+	{
+		List list(2, &count_and_delete);
+		List::Reader reader(list);
+
+		List::DataNode* a = new List::DataNode(1);
+		List::DataNode* b = new List::DataNode(2);
+		List::DataNode* c = new List::DataNode(3);
+		List::DataNode* d = new List::DataNode(4);
+
+		assert(values_of(reader).empty());
+
+		list.push_back(*b);
+		list.push_front(*a);
+		list.push_back(*d);
+		list.insert_after(*b, *c);
+		assert(a->is_attached());
+		assert(values_of(reader) == (std::vector<int>{ 1, 2, 3, 4 }));
+		assert(list.size() == 4);
+
+		bool has_thrown = false;
+		try {
+			list.push_back(*a);
+		}
+		catch (const std::invalid_argument&) {
+			has_thrown = true;
+		}
+		assert(has_thrown);
+
+		// A reader standing on a removed node can still walk on.
+		{
+			std::lock_guard<List::Reader> guard(reader);
+			List::const_iterator it = list.begin();
+			++it;
+			assert(*it == 2);
+
+			list.remove(*b);
+			assert(!b->is_attached());
+
+			// The reader is inside its critical section, so nothing it can
+			// reach is disposed of.
+			assert(list.try_reclaim() == 0);
+			assert(*it == 2);
+			++it;
+			assert(*it == 3);
+		}
+
+		assert(list.try_reclaim() == 1);
+		assert(disposed_count == 1);
+		assert(values_of(reader) == (std::vector<int>{ 1, 3, 4 }));
+
+		has_thrown = false;
+		List::DataNode detached(0);
+		try {
+			list.remove(detached);
+		}
+		catch (const std::invalid_argument&) {
+			has_thrown = true;
+		}
+		assert(has_thrown);
+
+		has_thrown = false;
+		List::DataNode unlinked(5);
+		try {
+			list.insert_after(detached, unlinked);
+		}
+		catch (const std::invalid_argument&) {
+			has_thrown = true;
+		}
+		assert(has_thrown);
+
+		assert(list.remove_if([](int value) { return value % 2 == 1; }) == 2);
+		assert(values_of(reader) == (std::vector<int>{ 4 }));
+		list.synchronize();
+		assert(disposed_count == 3);
+
+		// The list disposes of the nodes still attached.
+		list.push_back(*(new List::DataNode(6)));
+	}
+	assert(disposed_count == 5);
+}
+
+static void test_construction() {
+	List list(1);
+	{
+		List::Reader reader(list);
+
+		bool has_thrown = false;
+		try {
+			List::Reader second(list);
+		}
+		catch (const std::length_error&) {
+			has_thrown = true;
+		}
+		assert(has_thrown);
+	}
+	List::Reader reader(list);
+
+	bool has_thrown = false;
+	try {
+		List empty(0);
+	}
+	catch (const std::invalid_argument&) {
+		has_thrown = true;
+	}
+	assert(has_thrown);
+
+	has_thrown = false;
+	try {
+		List no_disposer(1, nullptr);
+	}
+	catch (const std::invalid_argument&) {
+		has_thrown = true;
+	}
+	assert(has_thrown);
+}
+
+// One writer keeps adding and removing nodes while three readers traverse
+// the list. Readers must only ever see live data, and every node must be
+// disposed of exactly once.
+static void test_stress() {
+	const int reader_count{ 3 };
+	const int round_count{ 20000 };
+
+	disposed_count = 0;
+	int created_count{ 0 };
+
+	{
+		List list(reader_count, &count_and_delete);
+		std::atomic<bool> done{ false };
+		std::vector<std::thread> readers;
+
+		for (int reader_index{ 0 }; reader_index < reader_count; reader_index++) {
+			readers.emplace_back([&]() {
+				List::Reader reader(list);
+				while (!done.load(std::memory_order_relaxed)) {
+					reader.for_each([](int value) {
+						assert(value >= 0);
+					});
+				}
+			});
+		}
+
+		for (int round{ 0 }; round < round_count; round++) {
+			List::DataNode* node = new List::DataNode(round);
+			created_count++;
+			if (round % 2 == 0) {
+				list.push_back(*node);
+			}
+			else {
+				list.push_front(*node);
+			}
+
+			if (round % 8 == 7) {
+				list.remove_if([&](int value) { return value % 3 == round % 3; });
+			}
+			if (round % 1000 == 999) {
+				list.try_reclaim();
+			}
+		}
+
+		done.store(true, std::memory_order_relaxed);
+		for (std::thread& reader : readers) {
+			reader.join();
+		}
+
+		list.synchronize();
+		assert(disposed_count.load() + static_cast<int>(list.size()) == created_count);
+	}
+
+	assert(disposed_count.load() == created_count);
+}
+
+int main() {
+	test_single_thread();
+	test_construction();
+	test_stress();
+	std::puts("rcu_node_list_test passed");
+}
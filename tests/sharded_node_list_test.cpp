@@ -0,0 +1,193 @@
+// MIT License
+
+// Copyright(c) 2021 Golden Rockefeller
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+// Build and run:
+//   g++ -std=c++17 -g -fsanitize=address,undefined -pthread tests/sharded_node_list_test.cpp -o sharded_node_list_test && ./sharded_node_list_test
+//
+// The stress test is also meant to be run under -fsanitize=thread.
+
+#undef NDEBUG
+#include <atomic>
+#include <cassert>
+#include <cstdio>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "../sharded_node_list.hpp"
+
+using namespace goldenrockefeller;
+
+using List = ShardedNodeList<int>;
+
+static int sum_of(List& list) {
+	int sum{ 0 };
+	list.for_each([&](int value) { sum += value; });
+	return sum;
+}
+
+static void test_single_thread() {
+	List list(3);
+	assert(list.get_shard_count() == 3);
+	assert(list.local_shard() < 3);
+	assert(list.is_empty_estimate());
+
+	List::DataNode a(1);
+	List::DataNode b(2);
+	List::DataNode c(4);
+
+	list.attach(a);
+	list.attach_to_shard(b, 0);
+	list.attach_to_shard(c, 2);
+	assert(a.sharded_list() == &list);
+	assert(list.size() == 3);
+	assert(list.size_estimate() == 3);
+	assert(sum_of(list) == 7);
+
+	// Attaching an attached node moves it.
+	list.attach_to_shard(b, 1);
+	assert(list.size() == 3);
+	assert(sum_of(list) == 7);
+
+	list.detach(b);
+	assert(b.sharded_list() == nullptr);
+	assert(list.size() == 2);
+	list.detach(b);
+	assert(list.size() == 2);
+
+	{
+		List::DataNode d(8);
+		list.attach(d);
+		assert(sum_of(list) == 13);
+	}
+	assert(list.size() == 2);
+	assert(sum_of(list) == 5);
+
+	// Nodes move between sharded lists.
+	List other(2);
+	other.attach(a);
+	assert(a.sharded_list() == &other);
+	assert(list.size() == 1 && other.size() == 1);
+
+	bool has_thrown = false;
+	try {
+		list.attach_to_shard(b, 3);
+	}
+	catch (const std::out_of_range&) {
+		has_thrown = true;
+	}
+	assert(has_thrown);
+	assert(b.sharded_list() == nullptr);
+
+	list.clear();
+	assert(c.sharded_list() == nullptr);
+	assert(list.size() == 0 && list.is_empty_estimate());
+
+	// A zero shard count is taken as one.
+	List single(0);
+	assert(single.get_shard_count() == 1);
+}
+
+static void test_collect() {
+	List list(2);
+	List::DataNode a(1);
+	List::DataNode b(2);
+	List::DataNode c(3);
+	list.attach_to_shard(a, 1);
+	list.attach_to_shard(b, 0);
+	list.attach_to_shard(c, 1);
+
+	List::list_type collected = list.collect();
+	assert(list.size() == 0);
+	assert(a.sharded_list() == nullptr);
+	assert(std::vector<int>(collected.begin(), collected.end()) == (std::vector<int>{ 2, 1, 3 }));
+
+	// Collected nodes can be attached again.
+	list.attach(b);
+	assert(list.size() == 1);
+	assert(std::vector<int>(collected.begin(), collected.end()) == (std::vector<int>{ 1, 3 }));
+	collected.clear();
+}
+
+// Threads attach and detach their own nodes, and let some of them be
+// destructed while attached, while another thread sizes, iterates and
+// clears the list. Detaching a node that clear got to first must do
+// nothing, so the counts stay exact.
+static void test_stress() {
+	const int thread_count{ 4 };
+	const int nodes_per_thread{ 32 };
+	const int round_count{ 2000 };
+
+	List list(3);
+	std::atomic<int> running{ thread_count };
+	std::vector<std::thread> threads;
+
+	for (int thread{ 0 }; thread < thread_count; thread++) {
+		threads.emplace_back([&, thread]() {
+			std::unique_ptr<List::DataNode[]> nodes(new List::DataNode[nodes_per_thread]);
+			for (int i{ 0 }; i < nodes_per_thread; i++) {
+				nodes[i].data = i;
+			}
+			for (int round{ 0 }; round < round_count; round++) {
+				for (int i{ 0 }; i < nodes_per_thread; i++) {
+					if ((round + i) % 3 == 0) {
+						list.attach_to_shard(nodes[i], static_cast<List::size_type>(i % 3));
+					}
+					else {
+						list.attach(nodes[i]);
+					}
+				}
+				for (int i{ thread % 2 }; i < nodes_per_thread; i += 2) {
+					list.detach(nodes[i]);
+				}
+				if (round % 100 == 0) {
+					List::DataNode temporary(round);
+					list.attach(temporary);
+				}
+			}
+			running.fetch_sub(1);
+		});
+	}
+
+	while (running.load() > 0) {
+		assert(list.size() <= static_cast<List::size_type>(thread_count * (nodes_per_thread + 1)));
+		sum_of(list);
+		list.clear();
+		std::this_thread::yield();
+	}
+
+	for (std::thread& thread : threads) {
+		thread.join();
+	}
+
+	assert(list.size() == 0);
+	assert(list.size_estimate() == 0);
+}
+
+int main() {
+	test_single_thread();
+	test_collect();
+	test_stress();
+	std::puts("sharded_node_list_test passed");
+}
@@ -0,0 +1,156 @@
+// MIT License
+
+// Copyright(c) 2021 Golden Rockefeller
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+// Build and run:
+//   g++ -std=c++11 -g -fsanitize=address,undefined tests/soa_node_list_test.cpp -o soa_node_list_test && ./soa_node_list_test
+
+#undef NDEBUG
+#include <cassert>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../soa_node_list.hpp"
+
+using namespace goldenrockefeller;
+
+static void test_attach_and_detach() {
+	SoaNodeList<int> list;
+	SoaNodeList<int>::DataNode a(list, 1);
+	SoaNodeList<int>::DataNode b(list, 2);
+	SoaNodeList<int>::DataNode c(list, 3);
+
+	a.attach_to(list);
+	c.attach_to(list);
+	b.attach_before(c);
+	assert(list.size() == 3);
+
+	int expected{ 1 };
+	for (int value : list) {
+		assert(value == expected++);
+	}
+
+	b.detach();
+	assert(!b.is_attached());
+	assert(list.size() == 2);
+
+	b.attach_after(c);
+	assert(*(--list.end()) == 2);
+
+	list.clear();
+	assert(list.is_empty());
+	assert(!a.is_attached());
+}
+
+static void test_destruction_detaches() {
+	SoaNodeList<int> list;
+	SoaNodeList<int>::DataNode a(list, 1);
+	a.attach_to(list);
+	{
+		SoaNodeList<int>::DataNode b(list, 2);
+		b.attach_to(list);
+		assert(list.size() == 2);
+	}
+	assert(list.size() == 1);
+	assert(*list.begin() == 1);
+}
+
+static void test_slots_are_reused() {
+	SoaNodeList<std::string> list;
+	{
+		SoaNodeList<std::string>::DataNode a(list, "first");
+		a.attach_to(list);
+	}
+	SoaNodeList<std::string>::DataNode b(list, "second");
+	b.attach_to(list);
+	assert(list.size() == 1);
+	assert(b.data() == "second");
+}
+
+static void test_release_frees_payload() {
+	std::shared_ptr<int> resource = std::make_shared<int>(7);
+	SoaNodeList<std::shared_ptr<int>> list;
+	{
+		SoaNodeList<std::shared_ptr<int>>::DataNode node(list, resource);
+		node.attach_to(list);
+		assert(resource.use_count() == 2);
+	}
+	assert(resource.use_count() == 1);
+}
+
+struct ThrowingValue {
+	int value;
+
+	explicit ThrowingValue(int value) : value{ value } {
+		if (value < 0) {
+			throw std::runtime_error("Negative value.");
+		}
+	};
+};
+
+static void test_failed_construction_keeps_arrays_in_step() {
+	SoaNodeList<ThrowingValue> list;
+	SoaNodeList<ThrowingValue>::DataNode a(list, ThrowingValue(1));
+	a.attach_to(list);
+
+	bool has_thrown = false;
+	try {
+		SoaNodeList<ThrowingValue>::DataNode b(list, ThrowingValue(-1));
+	}
+	catch (const std::runtime_error&) {
+		has_thrown = true;
+	}
+	assert(has_thrown);
+
+	SoaNodeList<ThrowingValue>::DataNode c(list, ThrowingValue(3));
+	c.attach_to(list);
+	assert(a.data().value == 1);
+	assert(c.data().value == 3);
+	assert(list.size() == 2);
+}
+
+static void test_moved_handles_keep_their_slot() {
+	SoaNodeList<int> list;
+	std::vector<SoaNodeList<int>::DataNode> nodes;
+	for (int i{ 0 }; i < 100; i++) {
+		nodes.emplace_back(list, i);
+		nodes.back().attach_to(list);
+	}
+
+	int expected{ 0 };
+	for (int value : list) {
+		assert(value == expected++);
+	}
+	assert(expected == 100);
+}
+
+int main() {
+	test_attach_and_detach();
+	test_destruction_detaches();
+	test_slots_are_reused();
+	test_release_frees_payload();
+	test_failed_construction_keeps_arrays_in_step();
+	test_moved_handles_keep_their_slot();
+	std::puts("soa_node_list_test passed");
+}
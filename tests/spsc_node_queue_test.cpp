@@ -0,0 +1,220 @@
+// MIT License
+
+// Copyright(c) 2021 Golden Rockefeller
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+// Build and run:
+//   g++ -std=c++17 -g -fsanitize=address,undefined -pthread tests/spsc_node_queue_test.cpp -o spsc_node_queue_test && ./spsc_node_queue_test
+//
+// The stress test is also meant to be run under -fsanitize=thread.
+
+#undef NDEBUG
+#include <cassert>
+#include <cstdio>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "../spsc_node_queue.hpp"
+
+using namespace goldenrockefeller;
+
+using Queue = SpscNodeQueue<int>;
+
+static void test_single_thread() {
+	Queue queue(3);
+	assert(queue.capacity() == 4);
+
+	std::vector<Queue::DataNode> nodes;
+	nodes.reserve(6);
+	for (int i{ 0 }; i < 6; i++) {
+		nodes.emplace_back(i);
+	}
+
+	assert(queue.dequeue() == nullptr);
+
+	for (int i{ 0 }; i < 4; i++) {
+		assert(queue.enqueue(nodes[i]));
+	}
+	assert(!queue.enqueue(nodes[4]));
+	assert(queue.size_estimate() == 4);
+
+	assert(queue.dequeue() == &nodes[0]);
+	assert(queue.dequeue() == &nodes[1]);
+	assert(queue.size_estimate() == 2);
+
+	// The ring wraps around.
+	for (int round{ 0 }; round < 10; round++) {
+		assert(queue.enqueue(nodes[2 + (round + 2) % 4]));
+		assert(queue.dequeue() == &nodes[2 + round % 4]);
+		assert(queue.size_estimate() == 2);
+	}
+	assert(queue.dequeue() == &nodes[2 + 10 % 4]);
+	assert(queue.dequeue() == &nodes[2 + 11 % 4]);
+	assert(queue.dequeue() == nullptr);
+	assert(queue.size_estimate() == 0);
+}
+
+static void test_lists() {
+	Queue queue(4);
+
+	std::vector<Queue::DataNode> nodes;
+	nodes.reserve(6);
+	Queue::list_type list;
+	for (int i{ 0 }; i < 6; i++) {
+		nodes.emplace_back(i);
+		nodes[i].attach_to(list);
+	}
+
+	// Only as many nodes as fit are taken, from the front of the list.
+	assert(queue.enqueue_list(list) == 4);
+	assert(list.front_node() == &nodes[4]);
+	assert(!nodes[0].is_attached());
+	assert(queue.enqueue_list(list) == 0);
+
+	Queue::list_type out;
+	assert(queue.dequeue_list(out, 3) == 3);
+	assert(queue.size_estimate() == 1);
+
+	assert(queue.enqueue_list(list) == 2);
+	assert(list.front_node() == nullptr);
+
+	assert(queue.dequeue_list(out) == 3);
+	assert(queue.dequeue_list(out) == 0);
+
+	int expected{ 0 };
+	for (int value : out) {
+		assert(value == expected);
+		expected++;
+	}
+	assert(expected == 6);
+	out.clear();
+}
+
+static void test_capacity_checks() {
+	bool has_thrown = false;
+	try {
+		Queue empty(0);
+	}
+	catch (const std::invalid_argument&) {
+		has_thrown = true;
+	}
+	assert(has_thrown);
+
+	has_thrown = false;
+	try {
+		Queue huge(std::numeric_limits<Queue::size_type>::max());
+	}
+	catch (const std::length_error&) {
+		has_thrown = true;
+	}
+	assert(has_thrown);
+}
+
+// A pool of nodes circulates between the two threads through a forward and
+// a return queue. The producer numbers every message and the consumer checks
+// that they arrive once each and in order. Both sides mix single and
+// batched operations.
+static void test_stress() {
+	const int message_count{ 500000 };
+	const int node_count{ 64 };
+
+	Queue forward(16);
+	Queue backward(node_count);
+	std::unique_ptr<Queue::DataNode[]> nodes(new Queue::DataNode[node_count]);
+	for (int i{ 0 }; i < node_count; i++) {
+		assert(backward.enqueue(nodes[i]));
+	}
+
+	std::thread consumer([&]() {
+		Queue::list_type batch;
+		int expected{ 0 };
+
+		while (expected < message_count) {
+			if (expected % 3 == 0) {
+				if (forward.dequeue_list(batch, 5) == 0) {
+					std::this_thread::yield();
+					continue;
+				}
+				for (int value : batch) {
+					assert(value == expected);
+					expected++;
+				}
+				while (Queue::DataNode* node = batch.front_node()) {
+					node->detach();
+					assert(backward.enqueue(*node));
+				}
+			}
+			else if (Queue::DataNode* node = forward.dequeue()) {
+				assert(node->data == expected);
+				expected++;
+				assert(backward.enqueue(*node));
+			}
+			else {
+				std::this_thread::yield();
+			}
+		}
+	});
+
+	Queue::list_type batch;
+	int next{ 0 };
+
+	while (next < message_count) {
+		if (next % 2 == 0) {
+			int wanted = message_count - next < 7 ? message_count - next : 7;
+			if (backward.dequeue_list(batch, static_cast<Queue::size_type>(wanted)) == 0) {
+				std::this_thread::yield();
+				continue;
+			}
+			for (int& value : batch) {
+				value = next;
+				next++;
+			}
+			while (batch.front_node()) {
+				if (forward.enqueue_list(batch) == 0) {
+					std::this_thread::yield();
+				}
+			}
+		}
+		else if (Queue::DataNode* node = backward.dequeue()) {
+			node->data = next;
+			next++;
+			while (!forward.enqueue(*node)) {
+				std::this_thread::yield();
+			}
+		}
+		else {
+			std::this_thread::yield();
+		}
+	}
+
+	consumer.join();
+}
+
+int main() {
+	test_single_thread();
+	test_lists();
+	test_capacity_checks();
+	test_stress();
+	std::puts("spsc_node_queue_test passed");
+}
@@ -0,0 +1,130 @@
+// MIT License
+
+// Copyright(c) 2021 Golden Rockefeller
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+// Build and run:
+//   g++ -std=c++11 -g -fsanitize=address,undefined tests/static_node_list_test.cpp -o static_node_list_test && ./static_node_list_test
+
+#undef NDEBUG
+#include <cassert>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <type_traits>
+
+#include "../static_node_list.hpp"
+
+using namespace goldenrockefeller;
+
+// Constant-initialized, so it is usable before main and from any static
+// initializer.
+static StaticNodeList<int, 16> static_list;
+
+static void test_index_width() {
+	static_assert(sizeof(StaticNodeList<char, 100>::index_type) == 2, "Small lists use 16-bit links.");
+	static_assert(sizeof(StaticNodeList<char, 70000>::index_type) == 4, "Large lists use 32-bit links.");
+}
+
+static void test_static_instance() {
+	assert(static_list.is_empty());
+	static_list.emplace_back(1);
+	static_list.emplace_front(0);
+	assert(static_list.size() == 2);
+	assert(static_list.front() == 0);
+	assert(static_list.back() == 1);
+	static_list.clear();
+	assert(static_list.is_empty());
+}
+
+static void test_emplace_and_erase() {
+	StaticNodeList<std::string, 4> list;
+	list.emplace_back("b");
+	list.emplace_front("a");
+	StaticNodeList<std::string, 4>::iterator it = list.emplace_back("d");
+	list.emplace(it, "c");
+	assert(list.is_full());
+
+	std::string joined;
+	for (const std::string& value : list) {
+		joined += value;
+	}
+	assert(joined == "abcd");
+
+	bool has_thrown = false;
+	try {
+		list.emplace_back("e");
+	}
+	catch (const std::length_error&) {
+		has_thrown = true;
+	}
+	assert(has_thrown);
+	assert(list.size() == 4);
+
+	it = list.erase(++list.begin());
+	assert(*it == "c");
+	list.pop_front();
+	list.pop_back();
+	assert(list.size() == 1);
+	assert(list.front() == "c");
+
+	// Freed slots are reused.
+	list.emplace_back("x");
+	list.emplace_back("y");
+	list.emplace_back("z");
+	assert(list.is_full());
+}
+
+static void test_values_are_destroyed() {
+	std::shared_ptr<int> resource = std::make_shared<int>(1);
+	{
+		StaticNodeList<std::shared_ptr<int>, 8> list;
+		list.emplace_back(resource);
+		list.emplace_back(resource);
+		assert(resource.use_count() == 3);
+		list.pop_back();
+		assert(resource.use_count() == 2);
+	}
+	assert(resource.use_count() == 1);
+}
+
+static void test_reverse_iteration() {
+	StaticNodeList<int, 8> list;
+	for (int i{ 0 }; i < 8; i++) {
+		list.emplace_back(i);
+	}
+
+	int expected{ 7 };
+	for (StaticNodeList<int, 8>::reverse_iterator it = list.rbegin(); it != list.rend(); ++it) {
+		assert(*it == expected--);
+	}
+	assert(expected == -1);
+}
+
+int main() {
+	test_index_width();
+	test_static_instance();
+	test_emplace_and_erase();
+	test_values_are_destroyed();
+	test_reverse_iteration();
+	std::puts("static_node_list_test passed");
+}
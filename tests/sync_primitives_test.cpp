@@ -0,0 +1,229 @@
+// MIT License
+
+// Copyright(c) 2021 Golden Rockefeller
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+// Build and run:
+//   g++ -std=c++11 -g -fsanitize=address,undefined -pthread tests/sync_primitives_test.cpp -o sync_primitives_test && ./sync_primitives_test
+//
+// Build with -std=c++20 to also test the coroutine awaiters, and with
+// -fsanitize=thread for the threaded tests.
+
+#undef NDEBUG
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "../sync_primitives.hpp"
+
+using namespace goldenrockefeller;
+
+static void test_fair_mutex() {
+	FairMutex mutex;
+	long counter{ 0 };
+
+	std::vector<std::thread> threads;
+	for (int thread{ 0 }; thread < 4; thread++) {
+		threads.emplace_back([&]() {
+			for (int i{ 0 }; i < 20000; i++) {
+				std::lock_guard<FairMutex> guard(mutex);
+				counter++;
+			}
+		});
+	}
+	for (std::thread& thread : threads) {
+		thread.join();
+	}
+	assert(counter == 80000);
+
+	mutex.lock();
+	assert(!mutex.try_lock());
+	bool acquired{ true };
+	std::thread waiter([&]() {
+		acquired = mutex.try_lock_for(std::chrono::milliseconds(20));
+	});
+	waiter.join();
+	assert(!acquired);
+
+	// A timed-out waiter leaves the queue, so unlocking frees the mutex.
+	mutex.unlock();
+	assert(mutex.try_lock());
+	mutex.unlock();
+}
+
+static void test_condition_variable() {
+	std::mutex mutex;
+	ConditionVariable condition;
+	std::vector<int> queue;
+	int received{ 0 };
+
+	std::thread consumer([&]() {
+		std::unique_lock<std::mutex> lock(mutex);
+		while (received < 1000) {
+			condition.wait(lock, [&]() { return !queue.empty(); });
+			received += int(queue.size());
+			queue.clear();
+		}
+	});
+
+	for (int i{ 0 }; i < 1000; i++) {
+		{
+			std::lock_guard<std::mutex> guard(mutex);
+			queue.push_back(i);
+		}
+		condition.notify_one();
+	}
+	consumer.join();
+	assert(received == 1000);
+
+	std::unique_lock<std::mutex> lock(mutex);
+	assert(!condition.wait_for(lock, std::chrono::milliseconds(5)));
+}
+
+static void test_semaphore() {
+	Semaphore semaphore(2);
+	assert(semaphore.try_acquire());
+	assert(semaphore.try_acquire());
+	assert(!semaphore.try_acquire());
+	assert(!semaphore.try_acquire_for(std::chrono::milliseconds(5)));
+
+	int acquired{ 0 };
+	std::mutex mutex;
+	std::vector<std::thread> threads;
+	for (int thread{ 0 }; thread < 3; thread++) {
+		threads.emplace_back([&]() {
+			semaphore.acquire();
+			std::lock_guard<std::mutex> guard(mutex);
+			acquired++;
+		});
+	}
+	semaphore.release(3);
+	for (std::thread& thread : threads) {
+		thread.join();
+	}
+	assert(acquired == 3);
+	assert(!semaphore.try_acquire());
+
+	semaphore.release(2);
+	semaphore.release();
+	assert(semaphore.try_acquire() && semaphore.try_acquire() && semaphore.try_acquire());
+	assert(!semaphore.try_acquire());
+}
+
+static void test_claim_first_slot() {
+	struct Slot {
+		ClaimFlag is_claimed;
+	};
+	Slot slots[2];
+
+	// Each claim takes the first free slot, and a released slot is reused.
+	assert(&claim_first_slot(slots, 2, "full") == &slots[0]);
+	assert(&claim_first_slot(slots, 2, "full") == &slots[1]);
+
+	bool has_thrown = false;
+	try {
+		claim_first_slot(slots, 2, "full");
+	}
+	catch (const std::length_error&) {
+		has_thrown = true;
+	}
+	assert(has_thrown);
+
+	slots[0].is_claimed.release();
+	assert(&claim_first_slot(slots, 2, "full") == &slots[0]);
+}
+
+static void test_waiter_layout() {
+	// The same in every translation unit, with or without coroutines.
+	static_assert(sizeof(Waiter) >= sizeof(void*) + sizeof(void (*)(void*)) + sizeof(std::uint32_t), "Waiter always holds a resume function and context.");
+}
+
+#if defined(GOLDENROCKEFELLER_HAS_COROUTINES)
+// A coroutine that starts eagerly and frees its frame when it finishes.
+struct Detached {
+	struct promise_type {
+		Detached get_return_object() noexcept { return {}; }
+		std::suspend_never initial_suspend() noexcept { return {}; }
+		std::suspend_never final_suspend() noexcept { return {}; }
+		void return_void() noexcept {}
+		void unhandled_exception() noexcept { std::terminate(); }
+	};
+};
+
+static Detached lock_and_record(FairMutex& mutex, std::vector<int>& order, int id) {
+	co_await mutex.lock_async();
+	order.push_back(id);
+	mutex.unlock();
+}
+
+static Detached acquire_and_record(Semaphore& semaphore, std::vector<int>& order, int id) {
+	co_await semaphore.acquire_async();
+	order.push_back(id);
+	semaphore.release();
+}
+
+static void test_coroutine_handoff_chain() {
+	// Each resumed coroutine hands the mutex to the next one. The handoffs
+	// must run one after another, not nested 100k frames deep.
+	const int coroutine_count{ 100000 };
+	FairMutex mutex;
+	std::vector<int> order;
+
+	mutex.lock();
+	for (int id{ 0 }; id < coroutine_count; id++) {
+		lock_and_record(mutex, order, id);
+	}
+	assert(order.empty());
+	mutex.unlock();
+
+	assert(int(order.size()) == coroutine_count);
+	for (int id{ 0 }; id < coroutine_count; id++) {
+		assert(order[id] == id);
+	}
+	assert(mutex.try_lock());
+	mutex.unlock();
+
+	Semaphore semaphore(0);
+	order.clear();
+	for (int id{ 0 }; id < coroutine_count; id++) {
+		acquire_and_record(semaphore, order, id);
+	}
+	semaphore.release();
+	assert(int(order.size()) == coroutine_count);
+	assert(semaphore.try_acquire());
+}
+#endif
+
+int main() {
+	test_fair_mutex();
+	test_condition_variable();
+	test_semaphore();
+	test_claim_first_slot();
+	test_waiter_layout();
+#if defined(GOLDENROCKEFELLER_HAS_COROUTINES)
+	test_coroutine_handoff_chain();
+#endif
+	std::puts("sync_primitives_test passed");
+}
@@ -0,0 +1,173 @@
+// MIT License
+
+// Copyright(c) 2021 Golden Rockefeller
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+// Build and run:
+//   g++ -std=c++11 -g -fsanitize=address,undefined tests/unrolled_node_list_test.cpp -o unrolled_node_list_test && ./unrolled_node_list_test
+
+#undef NDEBUG
+#include <cassert>
+#include <cstdint>
+#include <cstdio>
+#include <list>
+#include <random>
+
+#include "../unrolled_node_list.hpp"
+
+using namespace goldenrockefeller;
+
+template <typename List, typename Reference>
+static void check_equal(const List& list, const Reference& reference) {
+	assert(list.size() == reference.size());
+	typename Reference::const_iterator expected = reference.begin();
+	for (typename List::const_iterator it = list.begin(); it != list.end(); ++it, ++expected) {
+		assert(*it == *expected);
+	}
+	assert(expected == reference.end());
+}
+
+// Every block but the last is at least half full.
+template <typename List>
+static void check_occupancy(const List& list) {
+	std::size_t half = List::block_capacity / 2;
+	assert(list.block_count() <= (list.size() + half - 1) / half + 1);
+}
+
+static void test_push_and_pop() {
+	UnrolledNodeList<int, 8> list;
+	std::list<int> reference;
+
+	for (int i{ 0 }; i < 100; i++) {
+		list.push_back(i);
+		reference.push_back(i);
+		list.push_front(-i);
+		reference.push_front(-i);
+		check_occupancy(list);
+	}
+	check_equal(list, reference);
+
+	while (!list.is_empty()) {
+		assert(list.front() == reference.front());
+		assert(list.back() == reference.back());
+		list.pop_front();
+		reference.pop_front();
+		if (!list.is_empty()) {
+			list.pop_back();
+			reference.pop_back();
+		}
+		check_occupancy(list);
+	}
+	assert(list.block_count() == 0);
+}
+
+static void test_random_insert_and_erase() {
+	UnrolledNodeList<std::int32_t, 16> list;
+	std::list<std::int32_t> reference;
+	std::mt19937 random(3);
+
+	for (int step{ 0 }; step < 20000; step++) {
+		std::size_t position = reference.empty() ? 0 : random() % (reference.size() + 1);
+		UnrolledNodeList<std::int32_t, 16>::iterator it = list.begin();
+		std::list<std::int32_t>::iterator expected = reference.begin();
+		for (std::size_t i{ 0 }; i < position; i++) {
+			++it;
+			++expected;
+		}
+
+		if (random() % 5 < 3 || expected == reference.end()) {
+			std::int32_t value = std::int32_t(random() % 1000);
+			it = list.insert(it, value);
+			expected = reference.insert(expected, value);
+		}
+		else {
+			it = list.erase(it);
+			expected = reference.erase(expected);
+		}
+
+		if (expected == reference.end()) {
+			assert(it == list.end());
+		}
+		else {
+			assert(*it == *expected);
+		}
+		check_occupancy(list);
+	}
+	check_equal(list, reference);
+}
+
+// Erasing the front of each block in turn used to leave blocks with a single
+// value, as an underfull block only merged with a full successor.
+static void test_erase_against_full_successors() {
+	const std::size_t k = 8;
+	UnrolledNodeList<int, k> list;
+	for (int i{ 0 }; i < 8000; i++) {
+		list.push_back(i);
+	}
+
+	UnrolledNodeList<int, k>::iterator it = list.begin();
+	while (it != list.end()) {
+		// Keeps one value, then erases the rest of a block's worth.
+		++it;
+		for (std::size_t i{ 1 }; i < k && it != list.end(); i++) {
+			it = list.erase(it);
+		}
+	}
+
+	assert(list.size() == 1000);
+	check_occupancy(list);
+
+	int expected{ 0 };
+	for (int value : list) {
+		assert(value == expected);
+		expected += k;
+	}
+}
+
+static void test_kernels() {
+	UnrolledNodeList<float, 32> floats;
+	UnrolledNodeList<double, 32> doubles;
+	UnrolledNodeList<std::int32_t, 32> ints;
+
+	for (int i{ 1 }; i <= 1000; i++) {
+		floats.push_back(float(i % 97));
+		doubles.push_back(double(i));
+		ints.push_back(i % 10);
+	}
+
+	assert(ints.count(3) == 100);
+	assert(*ints.find(7) == 7);
+	assert(ints.find(42) == ints.end());
+	assert(ints.min() == 0);
+	assert(ints.max() == 9);
+	assert(ints.sum() == 4500);
+	assert(doubles.sum() == 500500.0);
+	assert(floats.max() == 96.0f);
+	assert(floats.min() == 0.0f);
+}
+
+int main() {
+	test_push_and_pop();
+	test_random_insert_and_erase();
+	test_erase_against_full_successors();
+	test_kernels();
+	std::puts("unrolled_node_list_test passed");
+}
@@ -0,0 +1,164 @@
+// MIT License
+
+// Copyright(c) 2021 Golden Rockefeller
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+// Build and run:
+//   g++ -std=c++17 -g -fsanitize=address,undefined -pthread tests/work_stealing_deque_test.cpp -o work_stealing_deque_test && ./work_stealing_deque_test
+//
+// The stress test is also meant to be run under -fsanitize=thread.
+
+#undef NDEBUG
+#include <atomic>
+#include <cassert>
+#include <cstdio>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "../work_stealing_deque.hpp"
+
+using namespace goldenrockefeller;
+
+using Deque = WorkStealingDeque<int>;
+
+static void test_single_thread() {
+	Deque deque(3);
+	assert(deque.capacity() == 4);
+
+	std::vector<Deque::DataNode> tasks;
+	tasks.reserve(5);
+	for (int i{ 0 }; i < 5; i++) {
+		tasks.emplace_back(i);
+	}
+
+	assert(deque.pop() == nullptr);
+	assert(deque.steal() == nullptr);
+
+	for (int i{ 0 }; i < 4; i++) {
+		assert(deque.push(tasks[i]));
+	}
+	assert(!deque.push(tasks[4]));
+	assert(deque.size_estimate() == 4);
+
+	// The owner pops the newest task and thieves steal the oldest.
+	assert(deque.pop() == &tasks[3]);
+	assert(deque.steal() == &tasks[0]);
+
+	Deque::list_type list;
+	assert(deque.steal_batch(list, 8) == 2);
+	assert(deque.is_empty_estimate());
+	assert(list.front_node() == &tasks[1]);
+	assert(list.back_node() == &tasks[2]);
+	list.clear();
+
+	// The ring wraps around.
+	for (int round{ 0 }; round < 10; round++) {
+		assert(deque.push(tasks[0]));
+		assert(deque.push(tasks[1]));
+		assert(deque.steal() == &tasks[0]);
+		assert(deque.pop() == &tasks[1]);
+	}
+
+	bool has_thrown = false;
+	try {
+		Deque empty(0);
+	}
+	catch (const std::invalid_argument&) {
+		has_thrown = true;
+	}
+	assert(has_thrown);
+}
+
+// One owner pushes every task and pops some of them back, while three
+// thieves steal singly and in batches. Every task must run exactly once.
+static void test_stress() {
+	const int task_count{ 200000 };
+	const int thief_count{ 3 };
+
+	Deque deque(256);
+	std::unique_ptr<Deque::DataNode[]> tasks(new Deque::DataNode[task_count]);
+	std::unique_ptr<std::atomic<int>[]> runs(new std::atomic<int>[task_count]);
+	for (int i{ 0 }; i < task_count; i++) {
+		tasks[i].data = i;
+		runs[i].store(0, std::memory_order_relaxed);
+	}
+
+	std::atomic<int> run_count{ 0 };
+	auto run = [&](Deque::DataNode* task) {
+		runs[task->data].fetch_add(1, std::memory_order_relaxed);
+		run_count.fetch_add(1, std::memory_order_relaxed);
+	};
+
+	std::vector<std::thread> thieves;
+	for (int thief{ 0 }; thief < thief_count; thief++) {
+		thieves.emplace_back([&, thief]() {
+			Deque::list_type batch;
+			while (run_count.load(std::memory_order_relaxed) < task_count) {
+				if (thief == 0) {
+					deque.steal_half(batch);
+					while (Deque::DataNode* task = batch.front_node()) {
+						task->detach();
+						run(task);
+					}
+				}
+				else if (Deque::DataNode* task = deque.steal()) {
+					run(task);
+				}
+				else {
+					std::this_thread::yield();
+				}
+			}
+		});
+	}
+
+	for (int i{ 0 }; i < task_count; i++) {
+		while (!deque.push(tasks[i])) {
+			if (Deque::DataNode* task = deque.pop()) {
+				run(task);
+			}
+		}
+		if (i % 7 == 0) {
+			if (Deque::DataNode* task = deque.pop()) {
+				run(task);
+			}
+		}
+	}
+	while (Deque::DataNode* task = deque.pop()) {
+		run(task);
+	}
+
+	for (std::thread& thief : thieves) {
+		thief.join();
+	}
+
+	assert(run_count.load() == task_count);
+	for (int i{ 0 }; i < task_count; i++) {
+		assert(runs[i].load() == 1);
+	}
+}
+
+int main() {
+	test_single_thread();
+	test_stress();
+	std::puts("work_stealing_deque_test passed");
+}
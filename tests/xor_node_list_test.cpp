@@ -0,0 +1,158 @@
+// MIT License
+
+// Copyright(c) 2021 Golden Rockefeller
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+// Build and run:
+//   g++ -std=c++11 -g -fsanitize=address,undefined tests/xor_node_list_test.cpp -o xor_node_list_test && ./xor_node_list_test
+
+#undef NDEBUG
+#include <cassert>
+#include <cstdio>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "../xor_node_list.hpp"
+
+using namespace goldenrockefeller;
+
+using List = XorNodeList<long>;
+
+static std::vector<long> values_of(const List& list) {
+	return std::vector<long>(list.begin(), list.end());
+}
+
+static std::vector<long> reversed_values_of(const List& list) {
+	return std::vector<long>(list.rbegin(), list.rend());
+}
+
+static void test_push_and_pop() {
+	List list;
+	List::DataNode a(1);
+	List::DataNode b(2);
+	List::DataNode c(3);
+
+	assert(list.is_empty());
+	list.push_back(b);
+	list.push_front(a);
+	list.push_back(c);
+	assert(list.size() == 3);
+	assert(a.is_attached() && b.is_attached() && c.is_attached());
+	assert(values_of(list) == (std::vector<long>{ 1, 2, 3 }));
+	assert(reversed_values_of(list) == (std::vector<long>{ 3, 2, 1 }));
+
+	assert(list.pop_front() == &a);
+	assert(list.pop_back() == &c);
+	assert(!a.is_attached() && !c.is_attached());
+	assert(values_of(list) == (std::vector<long>{ 2 }));
+
+	assert(list.pop_back() == &b);
+	assert(list.is_empty());
+
+	bool has_thrown = false;
+	try {
+		list.pop_front();
+	}
+	catch (const std::runtime_error&) {
+		has_thrown = true;
+	}
+	assert(has_thrown);
+}
+
+static void test_insert_and_erase() {
+	List list;
+	std::unique_ptr<List::DataNode[]> nodes(new List::DataNode[6]);
+	for (long i{ 0 }; i < 6; i++) {
+		nodes[i].data = i;
+	}
+
+	list.push_back(nodes[0]);
+	list.push_back(nodes[5]);
+	List::iterator it = list.end();
+	--it;
+	for (long i{ 1 }; i < 5; i++) {
+		it = list.insert(it, nodes[i]);
+		++it;
+	}
+	assert(values_of(list) == (std::vector<long>{ 0, 1, 2, 3, 4, 5 }));
+
+	// Erase every other node, walking forwards from the front.
+	it = list.begin();
+	while (it != list.end()) {
+		it = list.erase(it);
+		if (it != list.end()) {
+			++it;
+		}
+	}
+	assert(values_of(list) == (std::vector<long>{ 1, 3, 5 }));
+	assert(reversed_values_of(list) == (std::vector<long>{ 5, 3, 1 }));
+	assert(!nodes[0].is_attached() && !nodes[2].is_attached() && !nodes[4].is_attached());
+
+	// Erase from an iterator reached from the back.
+	it = list.end();
+	--it;
+	--it;
+	it = list.erase(it);
+	assert(*it == 5);
+	assert(values_of(list) == (std::vector<long>{ 1, 5 }));
+
+	bool has_thrown = false;
+	try {
+		list.insert(list.begin(), nodes[1]);
+	}
+	catch (const std::invalid_argument&) {
+		has_thrown = true;
+	}
+	assert(has_thrown);
+
+	list.clear();
+	assert(list.is_empty());
+	for (long i{ 0 }; i < 6; i++) {
+		assert(!nodes[i].is_attached());
+	}
+}
+
+static void test_layout() {
+	static_assert(sizeof(List::DataNode) == sizeof(void*) + sizeof(long), "A node holds one link.");
+}
+
+static void test_move_only_data() {
+	using MoveOnlyList = XorNodeList<std::unique_ptr<long>>;
+
+	// The data is moved into the node, not copied.
+	MoveOnlyList list;
+	MoveOnlyList::DataNode node(std::unique_ptr<long>(new long(5)));
+	list.push_back(node);
+	assert(*list.begin()->get() == 5);
+
+	// The node is removed before it is destructed.
+	assert(list.pop_front() == &node);
+	assert(!node.is_attached());
+}
+
+int main() {
+	test_push_and_pop();
+	test_insert_and_erase();
+	test_layout();
+	test_move_only_data();
+	std::puts("xor_node_list_test passed");
+}
@@ -0,0 +1,978 @@
+// MIT License
+
+// Copyright(c) 2021 Golden Rockefeller
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef GOLDENROCKEFELLER_UNROLLED_NODE_LIST_HPP
+#define GOLDENROCKEFELLER_UNROLLED_NODE_LIST_HPP
+
+#include <stdexcept>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <cstdint>
+#include <cstring>
+
+// Define GOLDENROCKEFELLER_NO_SIMD to force the scalar kernels.
+#if !defined(GOLDENROCKEFELLER_NO_SIMD)
+#if defined(__AVX2__)
+#define GOLDENROCKEFELLER_UNROLLED_AVX2
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define GOLDENROCKEFELLER_UNROLLED_SSE2
+#include <emmintrin.h>
+#endif
+#endif
+
+namespace goldenrockefeller {
+
+// Vector operations used by the UnrolledNodeList kernels. Types without a
+// specialization use the scalar kernels.
+template <typename T>
+struct unrolled_simd_ops {
+	static constexpr bool enabled = false;
+};
+
+#if defined(GOLDENROCKEFELLER_UNROLLED_AVX2)
+
+template <>
+struct unrolled_simd_ops<std::int32_t> {
+	static constexpr bool enabled = true;
+	static constexpr std::size_t width = 8;
+	using vector = __m256i;
+
+	static vector load(const std::int32_t* values) noexcept {
+		return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values));
+	}
+	static void store(std::int32_t* values, vector a) noexcept {
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(values), a);
+	}
+	static vector broadcast(std::int32_t value) noexcept {
+		return _mm256_set1_epi32(value);
+	}
+	static unsigned equal_mask(vector a, vector b) noexcept {
+		return static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(a, b))));
+	}
+	static vector min(vector a, vector b) noexcept {
+		return _mm256_min_epi32(a, b);
+	}
+	static vector max(vector a, vector b) noexcept {
+		return _mm256_max_epi32(a, b);
+	}
+	static vector add(vector a, vector b) noexcept {
+		return _mm256_add_epi32(a, b);
+	}
+};
+
+template <>
+struct unrolled_simd_ops<float> {
+	static constexpr bool enabled = true;
+	static constexpr std::size_t width = 8;
+	using vector = __m256;
+
+	static vector load(const float* values) noexcept {
+		return _mm256_loadu_ps(values);
+	}
+	static void store(float* values, vector a) noexcept {
+		_mm256_storeu_ps(values, a);
+	}
+	static vector broadcast(float value) noexcept {
+		return _mm256_set1_ps(value);
+	}
+	static unsigned equal_mask(vector a, vector b) noexcept {
+		return static_cast<unsigned>(_mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_EQ_OQ)));
+	}
+	static vector min(vector a, vector b) noexcept {
+		return _mm256_min_ps(a, b);
+	}
+	static vector max(vector a, vector b) noexcept {
+		return _mm256_max_ps(a, b);
+	}
+	static vector add(vector a, vector b) noexcept {
+		return _mm256_add_ps(a, b);
+	}
+};
+
+template <>
+struct unrolled_simd_ops<double> {
+	static constexpr bool enabled = true;
+	static constexpr std::size_t width = 4;
+	using vector = __m256d;
+
+	static vector load(const double* values) noexcept {
+		return _mm256_loadu_pd(values);
+	}
+	static void store(double* values, vector a) noexcept {
+		_mm256_storeu_pd(values, a);
+	}
+	static vector broadcast(double value) noexcept {
+		return _mm256_set1_pd(value);
+	}
+	static unsigned equal_mask(vector a, vector b) noexcept {
+		return static_cast<unsigned>(_mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_EQ_OQ)));
+	}
+	static vector min(vector a, vector b) noexcept {
+		return _mm256_min_pd(a, b);
+	}
+	static vector max(vector a, vector b) noexcept {
+		return _mm256_max_pd(a, b);
+	}
+	static vector add(vector a, vector b) noexcept {
+		return _mm256_add_pd(a, b);
+	}
+};
+
+#elif defined(GOLDENROCKEFELLER_UNROLLED_SSE2)
+
+template <>
+struct unrolled_simd_ops<std::int32_t> {
+	static constexpr bool enabled = true;
+	static constexpr std::size_t width = 4;
+	using vector = __m128i;
+
+	static vector load(const std::int32_t* values) noexcept {
+		return _mm_loadu_si128(reinterpret_cast<const __m128i*>(values));
+	}
+	static void store(std::int32_t* values, vector a) noexcept {
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(values), a);
+	}
+	static vector broadcast(std::int32_t value) noexcept {
+		return _mm_set1_epi32(value);
+	}
+	static unsigned equal_mask(vector a, vector b) noexcept {
+		return static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(a, b))));
+	}
+	// SSE2 has no 32-bit integer min/max, so select through a comparison mask.
+	static vector min(vector a, vector b) noexcept {
+		vector a_greater = _mm_cmpgt_epi32(a, b);
+		return _mm_or_si128(_mm_and_si128(a_greater, b), _mm_andnot_si128(a_greater, a));
+	}
+	static vector max(vector a, vector b) noexcept {
+		vector a_greater = _mm_cmpgt_epi32(a, b);
+		return _mm_or_si128(_mm_and_si128(a_greater, a), _mm_andnot_si128(a_greater, b));
+	}
+	static vector add(vector a, vector b) noexcept {
+		return _mm_add_epi32(a, b);
+	}
+};
+
+template <>
+struct unrolled_simd_ops<float> {
+	static constexpr bool enabled = true;
+	static constexpr std::size_t width = 4;
+	using vector = __m128;
+
+	static vector load(const float* values) noexcept {
+		return _mm_loadu_ps(values);
+	}
+	static void store(float* values, vector a) noexcept {
+		_mm_storeu_ps(values, a);
+	}
+	static vector broadcast(float value) noexcept {
+		return _mm_set1_ps(value);
+	}
+	static unsigned equal_mask(vector a, vector b) noexcept {
+		return static_cast<unsigned>(_mm_movemask_ps(_mm_cmpeq_ps(a, b)));
+	}
+	static vector min(vector a, vector b) noexcept {
+		return _mm_min_ps(a, b);
+	}
+	static vector max(vector a, vector b) noexcept {
+		return _mm_max_ps(a, b);
+	}
+	static vector add(vector a, vector b) noexcept {
+		return _mm_add_ps(a, b);
+	}
+};
+
+template <>
+struct unrolled_simd_ops<double> {
+	static constexpr bool enabled = true;
+	static constexpr std::size_t width = 2;
+	using vector = __m128d;
+
+	static vector load(const double* values) noexcept {
+		return _mm_loadu_pd(values);
+	}
+	static void store(double* values, vector a) noexcept {
+		_mm_storeu_pd(values, a);
+	}
+	static vector broadcast(double value) noexcept {
+		return _mm_set1_pd(value);
+	}
+	static unsigned equal_mask(vector a, vector b) noexcept {
+		return static_cast<unsigned>(_mm_movemask_pd(_mm_cmpeq_pd(a, b)));
+	}
+	static vector min(vector a, vector b) noexcept {
+		return _mm_min_pd(a, b);
+	}
+	static vector max(vector a, vector b) noexcept {
+		return _mm_max_pd(a, b);
+	}
+	static vector add(vector a, vector b) noexcept {
+		return _mm_add_pd(a, b);
+	}
+};
+
+#endif
+
+// Search and reduce kernels over the values of one block.
+template <typename T, bool Vectorized = unrolled_simd_ops<T>::enabled>
+struct unrolled_kernels {
+	using size_type = std::size_t;
+
+	static size_type find(const T* values, size_type count, const T& value) noexcept {
+		for (size_type i{ 0 }; i < count; i++) {
+			if (values[i] == value) {
+				return i;
+			}
+		}
+		return count;
+	}
+
+	static size_type count(const T* values, size_type count, const T& value) noexcept {
+		size_type matches{ 0 };
+		for (size_type i{ 0 }; i < count; i++) {
+			matches += static_cast<size_type>(values[i] == value);
+		}
+		return matches;
+	}
+
+	static T min(const T* values, size_type count) {
+		T result = values[0];
+		for (size_type i{ 1 }; i < count; i++) {
+			if (values[i] < result) {
+				result = values[i];
+			}
+		}
+		return result;
+	}
+
+	static T max(const T* values, size_type count) {
+		T result = values[0];
+		for (size_type i{ 1 }; i < count; i++) {
+			if (result < values[i]) {
+				result = values[i];
+			}
+		}
+		return result;
+	}
+
+	static T sum(const T* values, size_type count) {
+		T result{};
+		for (size_type i{ 0 }; i < count; i++) {
+			result += values[i];
+		}
+		return result;
+	}
+};
+
+template <typename T>
+struct unrolled_kernels<T, true> {
+	using size_type = std::size_t;
+	using ops = unrolled_simd_ops<T>;
+	using scalar = unrolled_kernels<T, false>;
+	using vector = typename ops::vector;
+	static constexpr size_type width = ops::width;
+
+	static unsigned lowest_set_bit(unsigned mask) noexcept {
+		unsigned index{ 0 };
+		while (!(mask & 1u)) {
+			mask >>= 1;
+			index++;
+		}
+		return index;
+	}
+
+	static unsigned set_bit_count(unsigned mask) noexcept {
+		unsigned bits{ 0 };
+		while (mask) {
+			mask &= mask - 1;
+			bits++;
+		}
+		return bits;
+	}
+
+	static T reduce(vector a, T (*combine)(const T*, size_type)) {
+		T lanes[width];
+		ops::store(lanes, a);
+		return combine(lanes, width);
+	}
+
+	static size_type find(const T* values, size_type count, const T& value) noexcept {
+		vector needle = ops::broadcast(value);
+		size_type i{ 0 };
+
+		for (; i + width <= count; i += width) {
+			unsigned mask = ops::equal_mask(ops::load(values + i), needle);
+			if (mask) {
+				return i + lowest_set_bit(mask);
+			}
+		}
+
+		return i + scalar::find(values + i, count - i, value);
+	}
+
+	static size_type count(const T* values, size_type count, const T& value) noexcept {
+		vector needle = ops::broadcast(value);
+		size_type matches{ 0 };
+		size_type i{ 0 };
+
+		for (; i + width <= count; i += width) {
+			matches += set_bit_count(ops::equal_mask(ops::load(values + i), needle));
+		}
+
+		return matches + scalar::count(values + i, count - i, value);
+	}
+
+	static T min(const T* values, size_type count) {
+		if (count < width) {
+			return scalar::min(values, count);
+		}
+
+		vector result = ops::load(values);
+		size_type i{ width };
+
+		for (; i + width <= count; i += width) {
+			result = ops::min(result, ops::load(values + i));
+		}
+
+		T lanes_min = reduce(result, &scalar::min);
+		if (i == count) {
+			return lanes_min;
+		}
+		T tail_min = scalar::min(values + i, count - i);
+		return tail_min < lanes_min ? tail_min : lanes_min;
+	}
+
+	static T max(const T* values, size_type count) {
+		if (count < width) {
+			return scalar::max(values, count);
+		}
+
+		vector result = ops::load(values);
+		size_type i{ width };
+
+		for (; i + width <= count; i += width) {
+			result = ops::max(result, ops::load(values + i));
+		}
+
+		T lanes_max = reduce(result, &scalar::max);
+		if (i == count) {
+			return lanes_max;
+		}
+		T tail_max = scalar::max(values + i, count - i);
+		return lanes_max < tail_max ? tail_max : lanes_max;
+	}
+
+	static T sum(const T* values, size_type count) {
+		vector result = ops::broadcast(T{});
+		size_type i{ 0 };
+
+		for (; i + width <= count; i += width) {
+			result = ops::add(result, ops::load(values + i));
+		}
+
+		return reduce(result, &scalar::sum) + scalar::sum(values + i, count - i);
+	}
+};
+
+// An unrolled variant of NodeList for small, trivially copyable payloads.
+// Each link block stores up to K values contiguously, so a traversal takes one
+// cache miss per block instead of one per value, and the search and reduce
+// operations run vectorized kernels over each block.
+//
+// Unlike NodeList, this list owns its values: blocks are allocated on demand,
+// split when an insertion fills them and, when erasure leaves them less than
+// half full, merged with a neighbour or refilled from it, so that every block
+// but the last stays at least half full. Insertion and erasure invalidate
+// iterators into the affected block and its neighbours.
+template <typename T, std::size_t K = 64>
+class UnrolledNodeList {
+
+	static_assert(std::is_trivially_copyable<T>::value, "UnrolledNodeList requires trivially copyable values.");
+	static_assert(K >= 2, "UnrolledNodeList blocks must hold at least two values.");
+
+public:
+	using value_type = T;
+	using allocator_type = std::allocator<value_type>;
+	using reference = value_type&;
+	using const_reference = const value_type&;
+	using pointer = typename std::allocator_traits<allocator_type>::pointer;
+	using const_pointer = typename std::allocator_traits<allocator_type>::const_pointer;
+	using size_type = std::size_t;
+	using difference_type = std::ptrdiff_t;
+
+	static constexpr size_type block_capacity = K;
+
+private:
+	using kernels = unrolled_kernels<value_type>;
+
+	class Node {
+	public:
+		Node* next_node;
+		Node* prev_node;
+
+		Node() noexcept : next_node{ nullptr }, prev_node{ nullptr } {};
+
+		Node(const Node& node) = delete;
+		Node(Node&& node) = delete;
+
+		Node& operator=(const Node& node) = delete;
+		Node& operator=(const Node&& node) = delete;
+	};
+
+	class Block : public Node {
+	public:
+		size_type count;
+		value_type values[K];
+
+		Block() noexcept : Node(), count{ 0 } {};
+	};
+
+	Node before_start_node;
+	Node past_end_node;
+	size_type value_count;
+
+	static bool is_block(const Node* node) noexcept {
+		return bool(node->next_node) && bool(node->prev_node);
+	}
+
+	static Block* as_block(Node* node) noexcept {
+		return static_cast<Block*>(node);
+	}
+
+	static const Block* as_block(const Node* node) noexcept {
+		return static_cast<const Block*>(node);
+	}
+
+	Block* create_block_after(Node* node) {
+		Block* block = new Block();
+		block->next_node = node->next_node;
+		block->prev_node = node;
+		node->next_node->prev_node = block;
+		node->next_node = block;
+		return block;
+	}
+
+	void destroy_block(Block* block) noexcept {
+		block->prev_node->next_node = block->next_node;
+		block->next_node->prev_node = block->prev_node;
+		delete block;
+	}
+
+	// Moves the upper half of a full block into a new block after it.
+	Block* split_block(Block* block) {
+		Block* upper = this->create_block_after(block);
+		size_type half = K / 2;
+		std::memcpy(upper->values, block->values + half, (K - half) * sizeof(value_type));
+		upper->count = K - half;
+		block->count = half;
+		return upper;
+	}
+
+	// Moves every value of the upper block to the end of the lower one, which
+	// must have room for them, and destroys the upper block.
+	void merge_blocks(Block* lower, Block* upper) noexcept {
+		std::memcpy(lower->values + lower->count, upper->values, upper->count * sizeof(value_type));
+		lower->count += upper->count;
+		this->destroy_block(upper);
+	}
+
+	// Moves values between two neighbouring blocks, which together hold more
+	// than K values, so that each ends up with at least half of them.
+	// Returns how many values moved from the upper block to the lower one;
+	// a negative count moved the other way.
+	static difference_type balance_blocks(Block* lower, Block* upper) noexcept {
+		size_type total = lower->count + upper->count;
+		size_type lower_count = total / 2;
+
+		if (lower_count > lower->count) {
+			size_type moved = lower_count - lower->count;
+			std::memcpy(lower->values + lower->count, upper->values, moved * sizeof(value_type));
+			std::memmove(upper->values, upper->values + moved, (upper->count - moved) * sizeof(value_type));
+			lower->count += moved;
+			upper->count -= moved;
+			return difference_type(moved);
+		}
+
+		size_type moved = lower->count - lower_count;
+		std::memmove(upper->values + moved, upper->values, upper->count * sizeof(value_type));
+		std::memcpy(upper->values, lower->values + lower_count, moved * sizeof(value_type));
+		lower->count -= moved;
+		upper->count += moved;
+		return -difference_type(moved);
+	}
+
+	// Refills a block that has fallen below half full from its next block,
+	// or from its previous block if it is the last one, merging the two when
+	// they fit in one block and borrowing values otherwise. Every block but
+	// the last is then at least half full. The block and index are updated
+	// to keep referring to the same value, or to the position after the
+	// block's last value.
+	void rebalance(Block*& block, size_type& index) noexcept {
+		if (block->count < K / 2) {
+			if (is_block(block->next_node)) {
+				Block* next_block = as_block(block->next_node);
+				if (block->count + next_block->count <= K) {
+					this->merge_blocks(block, next_block);
+				}
+				else {
+					balance_blocks(block, next_block);
+				}
+			}
+			else if (is_block(block->prev_node)) {
+				Block* prev_block = as_block(block->prev_node);
+				if (prev_block->count + block->count <= K) {
+					index += prev_block->count;
+					this->merge_blocks(prev_block, block);
+					block = prev_block;
+				}
+				else {
+					index += size_type(-balance_blocks(prev_block, block));
+				}
+			}
+		}
+	}
+
+public:
+	template <typename Type>
+	class base_iterator
+	{
+		template <typename OtherType>
+		friend class base_iterator;
+
+		friend class UnrolledNodeList;
+
+	protected:
+		using node_pointer = typename std::conditional<std::is_const<Type>::value, const Node*, Node*>::type;
+
+		node_pointer current_node;
+		size_type index;
+
+	public:
+		using iterator_category = std::bidirectional_iterator_tag;
+		using difference_type = std::ptrdiff_t;
+		using value_type = Type;
+		using pointer = Type*;
+		using reference = Type&;
+
+		base_iterator() noexcept : current_node{ nullptr }, index{ 0 } {};
+		base_iterator(node_pointer starting_node, size_type index) noexcept :
+			current_node{ starting_node },
+			index{ index }
+		{};
+
+		bool is_at_nullptr() const noexcept {
+			return !this->current_node;
+		}
+
+		bool is_past_the_end_no_null_check() const noexcept {
+			return !this->current_node->next_node && bool(this->current_node->prev_node);
+		}
+
+		bool is_past_the_end() const {
+			if (this->is_at_nullptr()) {
+				throw std::runtime_error("The iterator's current node must not be null.");
+			}
+			return this->is_past_the_end_no_null_check();
+		}
+
+		bool is_before_the_start_no_null_check() const noexcept {
+			return !this->current_node->prev_node && bool(this->current_node->next_node);
+		}
+
+		bool is_before_the_start() const {
+			if (this->is_at_nullptr()) {
+				throw std::runtime_error("The iterator's current node must not be null.");
+			}
+			return this->is_before_the_start_no_null_check();
+		}
+
+		base_iterator& operator++() {
+			if (this->is_at_nullptr()) {
+				throw std::runtime_error("The iterator's current node must not be null.");
+			}
+			if (this->is_past_the_end_no_null_check()) {
+				throw std::runtime_error("Cannot increment iterator that is past-the-end.");
+			}
+
+			if (is_block(this->current_node) && ++this->index < as_block(this->current_node)->count) {
+				return *this;
+			}
+
+			this->current_node = this->current_node->next_node;
+			this->index = 0;
+
+			return *this;
+		}
+
+		base_iterator& operator--() {
+			if (this->is_at_nullptr()) {
+				throw std::runtime_error("The iterator's current node must not be null.");
+			}
+			if (this->is_before_the_start_no_null_check()) {
+				throw std::runtime_error("Cannot decrement iterator that is before-the-start.");
+			}
+
+			if (this->index > 0) {
+				this->index--;
+				return *this;
+			}
+
+			this->current_node = this->current_node->prev_node;
+			this->index = is_block(this->current_node) ? as_block(this->current_node)->count - 1 : 0;
+
+			return *this;
+		}
+
+		base_iterator operator++(int) {
+			base_iterator it(*this);
+			++(*this);
+			return it;
+		}
+
+		base_iterator operator--(int) {
+			base_iterator it(*this);
+			--(*this);
+			return it;
+		}
+
+		reference operator*() const {
+			if (this->is_at_nullptr()) {
+				throw std::runtime_error("The iterator's current node must not be null.");
+			}
+			if (!is_block(this->current_node)) {
+				throw std::runtime_error("Cannot dereference iterator that is not at a value");
+			}
+
+			return const_cast<Block*>(as_block(this->current_node))->values[this->index];
+		};
+
+		pointer operator->() const {
+			return &(**this);
+		};
+
+		template<typename OtherType>
+		bool operator==(const base_iterator<OtherType>& it) const noexcept {
+			// Invalid iterators are never equal.
+			return (
+				this->current_node == it.current_node
+				&& this->index == it.index
+				&& !this->is_at_nullptr()
+			);
+		}
+
+		template<typename OtherType>
+		bool operator!=(const base_iterator<OtherType>& it) const noexcept {
+			return !(*this == it);
+		}
+
+		operator base_iterator<const value_type>() const noexcept
+		{
+			return base_iterator<const value_type>(this->current_node, this->index);
+		}
+	};
+
+	using iterator = base_iterator<value_type>;
+	using const_iterator = base_iterator<const value_type>;
+	using reverse_iterator = std::reverse_iterator<iterator>;
+	using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+	UnrolledNodeList() noexcept : value_count{ 0 } {
+		this->before_start_node.next_node = &(this->past_end_node);
+		this->past_end_node.prev_node = &(this->before_start_node);
+	};
+
+	~UnrolledNodeList() noexcept {
+		this->clear();
+	};
+
+	UnrolledNodeList(const UnrolledNodeList& obj) = delete;
+	UnrolledNodeList(UnrolledNodeList&& obj) = delete;
+	UnrolledNodeList& operator=(const UnrolledNodeList& obj) = delete;
+	UnrolledNodeList& operator=(UnrolledNodeList&& obj) = delete;
+
+	iterator begin() noexcept {
+		return iterator(this->before_start_node.next_node, 0);
+	};
+	const_iterator begin() const noexcept {
+		return const_iterator(this->before_start_node.next_node, 0);
+	};
+	const_iterator cbegin() const noexcept {
+		return this->begin();
+	};
+	iterator end() noexcept {
+		return iterator(&(this->past_end_node), 0);
+	};
+	const_iterator end() const noexcept {
+		return const_iterator(&(this->past_end_node), 0);
+	};
+	const_iterator cend() const noexcept {
+		return this->end();
+	};
+
+	reverse_iterator rbegin() noexcept {
+		return reverse_iterator(this->end());
+	};
+	const_reverse_iterator rbegin() const noexcept {
+		return const_reverse_iterator(this->end());
+	};
+	const_reverse_iterator crbegin() const noexcept {
+		return this->rbegin();
+	};
+	reverse_iterator rend() noexcept {
+		return reverse_iterator(this->begin());
+	};
+	const_reverse_iterator rend() const noexcept {
+		return const_reverse_iterator(this->begin());
+	};
+	const_reverse_iterator crend() const noexcept {
+		return this->rend();
+	};
+
+	bool is_empty() const noexcept {
+		return this->value_count == 0;
+	};
+
+	size_type size() const noexcept {
+		return this->value_count;
+	};
+
+	// The number of blocks, which is at most about 2 * size() / K, as every
+	// block but the last is at least half full.
+	size_type block_count() const noexcept {
+		size_type count{ 0 };
+		for (const Node* node{ this->before_start_node.next_node }; node != &(this->past_end_node); node = node->next_node) {
+			count++;
+		}
+		return count;
+	};
+
+	reference front() {
+		if (this->is_empty()) {
+			throw std::runtime_error("The list must not be empty.");
+		}
+		return as_block(this->before_start_node.next_node)->values[0];
+	}
+
+	reference back() {
+		if (this->is_empty()) {
+			throw std::runtime_error("The list must not be empty.");
+		}
+		Block* block = as_block(this->past_end_node.prev_node);
+		return block->values[block->count - 1];
+	}
+
+	void push_back(const value_type& value) {
+		Node* last_node = this->past_end_node.prev_node;
+		Block* block = (
+			is_block(last_node) && as_block(last_node)->count < K
+			? as_block(last_node)
+			: this->create_block_after(last_node)
+		);
+
+		block->values[block->count++] = value;
+		this->value_count++;
+	}
+
+	// A full first block is split rather than preceded by a new block, so
+	// that every block but the last stays at least half full.
+	void push_front(const value_type& value) {
+		this->insert(this->cbegin(), value);
+	}
+
+	// Inserts the value before the iterator's position and returns an iterator
+	// to the inserted value.
+	iterator insert(const_iterator pos, const value_type& value) {
+		if (pos.is_at_nullptr()) {
+			throw std::runtime_error("The iterator's current node must not be null.");
+		}
+		if (pos.is_before_the_start_no_null_check()) {
+			throw std::runtime_error("Cannot insert before this iterator if this iterator is before-the-start.");
+		}
+
+		if (pos.is_past_the_end_no_null_check()) {
+			this->push_back(value);
+			Block* block = as_block(this->past_end_node.prev_node);
+			return iterator(block, block->count - 1);
+		}
+
+		Block* block = as_block(const_cast<Node*>(pos.current_node));
+		size_type index = pos.index;
+
+		if (block->count == K) {
+			Block* upper = this->split_block(block);
+			if (index > block->count) {
+				index -= block->count;
+				block = upper;
+			}
+		}
+
+		std::memmove(
+			block->values + index + 1,
+			block->values + index,
+			(block->count - index) * sizeof(value_type)
+		);
+		block->values[index] = value;
+		block->count++;
+		this->value_count++;
+
+		return iterator(block, index);
+	}
+
+	// Erases the value at the iterator's position and returns an iterator to
+	// the value after it.
+	iterator erase(const_iterator pos) {
+		if (pos.is_at_nullptr()) {
+			throw std::runtime_error("The iterator's current node must not be null.");
+		}
+		if (!is_block(pos.current_node)) {
+			throw std::runtime_error("Cannot erase at an iterator that is not at a value.");
+		}
+
+		Block* block = as_block(const_cast<Node*>(pos.current_node));
+		size_type index = pos.index;
+
+		std::memmove(
+			block->values + index,
+			block->values + index + 1,
+			(block->count - index - 1) * sizeof(value_type)
+		);
+		block->count--;
+		this->value_count--;
+
+		if (block->count == 0) {
+			Node* next_node = block->next_node;
+			this->destroy_block(block);
+			return iterator(next_node, 0);
+		}
+
+		this->rebalance(block, index);
+
+		if (index < block->count) {
+			return iterator(block, index);
+		}
+		return iterator(block->next_node, 0);
+	}
+
+	void pop_front() {
+		this->erase(this->cbegin());
+	}
+
+	void pop_back() {
+		if (this->is_empty()) {
+			throw std::runtime_error("The list must not be empty.");
+		}
+		Block* block = as_block(this->past_end_node.prev_node);
+		this->erase(const_iterator(block, block->count - 1));
+	}
+
+	void clear() noexcept {
+		Node* node{ this->before_start_node.next_node };
+
+		while (node != &(this->past_end_node)) {
+			Node* next_node = node->next_node;
+			delete as_block(node);
+			node = next_node;
+		}
+
+		this->before_start_node.next_node = &(this->past_end_node);
+		this->past_end_node.prev_node = &(this->before_start_node);
+		this->value_count = 0;
+	};
+
+	iterator find(const value_type& value) noexcept {
+		for (Node* node{ this->before_start_node.next_node }; node != &(this->past_end_node); node = node->next_node) {
+			Block* block = as_block(node);
+			size_type index = kernels::find(block->values, block->count, value);
+			if (index != block->count) {
+				return iterator(block, index);
+			}
+		}
+		return this->end();
+	}
+
+	const_iterator find(const value_type& value) const noexcept {
+		return const_cast<UnrolledNodeList*>(this)->find(value);
+	}
+
+	size_type count(const value_type& value) const noexcept {
+		size_type matches{ 0 };
+		for (const Node* node{ this->before_start_node.next_node }; node != &(this->past_end_node); node = node->next_node) {
+			const Block* block = as_block(node);
+			matches += kernels::count(block->values, block->count, value);
+		}
+		return matches;
+	}
+
+	value_type min() const {
+		if (this->is_empty()) {
+			throw std::runtime_error("The list must not be empty.");
+		}
+
+		const Block* block = as_block(this->before_start_node.next_node);
+		value_type result = kernels::min(block->values, block->count);
+
+		for (const Node* node{ block->next_node }; node != &(this->past_end_node); node = node->next_node) {
+			block = as_block(node);
+			value_type block_min = kernels::min(block->values, block->count);
+			if (block_min < result) {
+				result = block_min;
+			}
+		}
+		return result;
+	}
+
+	value_type max() const {
+		if (this->is_empty()) {
+			throw std::runtime_error("The list must not be empty.");
+		}
+
+		const Block* block = as_block(this->before_start_node.next_node);
+		value_type result = kernels::max(block->values, block->count);
+
+		for (const Node* node{ block->next_node }; node != &(this->past_end_node); node = node->next_node) {
+			block = as_block(node);
+			value_type block_max = kernels::max(block->values, block->count);
+			if (result < block_max) {
+				result = block_max;
+			}
+		}
+		return result;
+	}
+
+	value_type sum() const {
+		value_type result{};
+		for (const Node* node{ this->before_start_node.next_node }; node != &(this->past_end_node); node = node->next_node) {
+			const Block* block = as_block(node);
+			result += kernels::sum(block->values, block->count);
+		}
+		return result;
+	}
+};
+
+template <typename T, std::size_t K>
+constexpr typename UnrolledNodeList<T, K>::size_type UnrolledNodeList<T, K>::block_capacity;
+
+} // namespace goldenrockefeller
+
+#endif
@@ -0,0 +1,213 @@
+// MIT License
+
+// Copyright(c) 2021 Golden Rockefeller
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef GOLDENROCKEFELLER_WORK_STEALING_DEQUE_HPP
+#define GOLDENROCKEFELLER_WORK_STEALING_DEQUE_HPP
+
+#include <stdexcept>
+#include <atomic>
+#include <memory>
+#include <cstdint>
+
+#include "node_list.hpp"
+
+#if !defined(__cpp_aligned_new)
+#error "WorkStealingDeque needs C++17 aligned new for its cache-line-aligned indices."
+#endif
+
+namespace goldenrockefeller {
+
+// A Chase-Lev work-stealing deque of DataNode pointers, following the C11
+// formulation of Le, Pop, Cohen and Zappa Nardelli (PPoPP 2013). The owning
+// worker pushes and pops at the bottom without contention, and other workers
+// steal from the top with one CAS each.
+//
+// The ring buffer is allocated once, at construction, so pushing a task never
+// allocates; push returns false when the deque is full and the owner should
+// run the task inline. The deque only stores pointers and never touches the
+// links of the nodes, so a task must stay alive, and must not be pushed
+// twice, until it is popped or stolen.
+template <typename T>
+class WorkStealingDeque {
+
+public:
+	using list_type = NodeList<T>;
+	using DataNode = typename list_type::DataNode;
+	using size_type = std::size_t;
+
+	static constexpr size_type cache_line_size = 64;
+
+private:
+	using index_type = std::int64_t;
+
+	// The indices are written by different threads, so each gets its own
+	// cache line.
+	alignas(cache_line_size) std::atomic<index_type> top;
+	alignas(cache_line_size) std::atomic<index_type> bottom;
+	alignas(cache_line_size) std::unique_ptr<std::atomic<DataNode*>[]> buffer;
+	index_type mask;
+
+public:
+	// The capacity is rounded up to a power of two.
+	explicit WorkStealingDeque(size_type capacity = 1024) : top{ 0 }, bottom{ 0 }, buffer{}, mask{ 0 } {
+		if (capacity == 0) {
+			throw std::invalid_argument("The capacity must not be zero.");
+		}
+
+		size_type rounded_capacity{ 1 };
+		while (rounded_capacity < capacity) {
+			rounded_capacity <<= 1;
+		}
+
+		this->buffer.reset(new std::atomic<DataNode*>[rounded_capacity]);
+		for (size_type i{ 0 }; i < rounded_capacity; i++) {
+			this->buffer[i].store(nullptr, std::memory_order_relaxed);
+		}
+		this->mask = static_cast<index_type>(rounded_capacity - 1);
+	};
+
+	WorkStealingDeque(const WorkStealingDeque& obj) = delete;
+	WorkStealingDeque(WorkStealingDeque&& obj) = delete;
+	WorkStealingDeque& operator=(const WorkStealingDeque& obj) = delete;
+	WorkStealingDeque& operator=(WorkStealingDeque&& obj) = delete;
+
+	size_type capacity() const noexcept {
+		return static_cast<size_type>(this->mask + 1);
+	};
+
+	// A snapshot of the number of tasks; exact only when no other thread is
+	// using the deque.
+	size_type size_estimate() const noexcept {
+		index_type b = this->bottom.load(std::memory_order_relaxed);
+		index_type t = this->top.load(std::memory_order_relaxed);
+		return b > t ? static_cast<size_type>(b - t) : 0;
+	};
+
+	bool is_empty_estimate() const noexcept {
+		return this->size_estimate() == 0;
+	};
+
+	// Owner only. Pushes the task at the bottom, or returns false if the
+	// deque is full.
+	bool push(DataNode& task) noexcept {
+		index_type b = this->bottom.load(std::memory_order_relaxed);
+		index_type t = this->top.load(std::memory_order_acquire);
+
+		if (b - t > this->mask) {
+			return false;
+		}
+
+		this->buffer[b & this->mask].store(&task, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+		this->bottom.store(b + 1, std::memory_order_relaxed);
+
+		return true;
+	};
+
+	// Owner only. Pops the most recently pushed task, or returns null if the
+	// deque is empty.
+	DataNode* pop() noexcept {
+		index_type b = this->bottom.load(std::memory_order_relaxed) - 1;
+		this->bottom.store(b, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		index_type t = this->top.load(std::memory_order_relaxed);
+
+		if (t > b) {
+			this->bottom.store(b + 1, std::memory_order_relaxed);
+			return nullptr;
+		}
+
+		DataNode* task = this->buffer[b & this->mask].load(std::memory_order_relaxed);
+
+		if (t == b) {
+			// Last task: race the thieves for it.
+			if (!this->top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+				task = nullptr;
+			}
+			this->bottom.store(b + 1, std::memory_order_relaxed);
+		}
+
+		return task;
+	};
+
+	// Any thread. Steals the least recently pushed task, or returns null if
+	// the deque is empty or the steal lost a race.
+	DataNode* steal() noexcept {
+		index_type t = this->top.load(std::memory_order_acquire);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		index_type b = this->bottom.load(std::memory_order_acquire);
+
+		if (t >= b) {
+			return nullptr;
+		}
+
+		DataNode* task = this->buffer[t & this->mask].load(std::memory_order_relaxed);
+
+		if (!this->top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+			return nullptr;
+		}
+
+		return task;
+	};
+
+	// Any thread. Steals up to max_count tasks, oldest first, and attaches
+	// them to the back of the list. Stops early when the deque runs dry or a
+	// steal loses a race. Returns the number of stolen tasks.
+	size_type steal_batch(list_type& list, size_type max_count) {
+		static constexpr size_type chunk_size = 32;
+		DataNode* chunk[chunk_size];
+		size_type stolen{ 0 };
+
+		while (stolen < max_count) {
+			size_type chunk_count{ 0 };
+
+			while (chunk_count < chunk_size && stolen + chunk_count < max_count) {
+				DataNode* task = this->steal();
+				if (!task) {
+					break;
+				}
+				chunk[chunk_count++] = task;
+			}
+
+			list.attach_range(chunk, chunk + chunk_count);
+			stolen += chunk_count;
+
+			if (chunk_count < chunk_size) {
+				break;
+			}
+		}
+
+		return stolen;
+	};
+
+	// Any thread. Steals about half of the tasks into the list.
+	size_type steal_half(list_type& list) {
+		return this->steal_batch(list, (this->size_estimate() + 1) / 2);
+	};
+};
+
+template <typename T>
+constexpr typename WorkStealingDeque<T>::size_type WorkStealingDeque<T>::cache_line_size;
+
+} // namespace goldenrockefeller
+
+#endif
@@ -0,0 +1,435 @@
+// MIT License
+
+// Copyright(c) 2021 Golden Rockefeller
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef GOLDENROCKEFELLER_XOR_NODE_LIST_HPP
+#define GOLDENROCKEFELLER_XOR_NODE_LIST_HPP
+
+#include <stdexcept>
+#include <cassert>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <cstdint>
+
+namespace goldenrockefeller {
+
+// A compact variant of NodeList where each node stores a single link word,
+// the XOR of its previous and next node addresses. This halves the link
+// overhead per node, at the cost of needing two adjacent nodes to move in
+// either direction.
+//
+// A node cannot find its neighbours on its own, so unlike NodeList::DataNode
+// an XorNodeList::DataNode has no detach() and does not detach itself when it
+// is destructed. Nodes are inserted and removed through the list, either at
+// its ends or at an iterator, which holds the two adjacent nodes it needs.
+// A node must be removed from its list before it is destructed, which debug
+// builds assert.
+template <typename T>
+class XorNodeList {
+
+private:
+	class Node {
+	public:
+		std::uintptr_t link;
+
+		Node() noexcept : link{ 0 } {};
+
+		Node(const Node& node) = delete;
+		Node(Node&& node) = delete;
+
+		Node& operator=(const Node& node) = delete;
+		Node& operator=(const Node&& node) = delete;
+
+		Node* other(const Node* node) const noexcept {
+			return reinterpret_cast<Node*>(this->link ^ reinterpret_cast<std::uintptr_t>(node));
+		}
+
+		// Replaces the neighbour old_node with new_node.
+		void relink(const Node* old_node, const Node* new_node) noexcept {
+			this->link ^= reinterpret_cast<std::uintptr_t>(old_node) ^ reinterpret_cast<std::uintptr_t>(new_node);
+		}
+	};
+
+	static std::uintptr_t link_of(const Node* prev_node, const Node* next_node) noexcept {
+		return reinterpret_cast<std::uintptr_t>(prev_node) ^ reinterpret_cast<std::uintptr_t>(next_node);
+	}
+
+	Node before_start_node;
+	Node past_end_node;
+
+public:
+	using value_type = T;
+	using allocator_type = std::allocator<value_type>;
+	using reference = value_type&;
+	using const_reference = const value_type&;
+	using pointer = typename std::allocator_traits<allocator_type>::pointer;
+	using const_pointer = typename std::allocator_traits<allocator_type>::const_pointer;
+	using size_type = std::size_t;
+	using difference_type = std::ptrdiff_t;
+
+	class DataNode : private Node {
+		friend class XorNodeList;
+
+	public:
+		value_type data;
+
+		DataNode() noexcept : Node() {};
+
+		explicit DataNode(T data) noexcept : Node(), data{ std::move(data) } {};
+
+		~DataNode() {
+			assert(!this->is_attached() && "A node must be removed from its list before it is destructed.");
+		};
+
+		DataNode(const DataNode& node) = delete;
+		DataNode(DataNode&& node) = delete;
+
+		DataNode& operator=(const DataNode& node) = delete;
+		DataNode& operator=(DataNode&& node) = delete;
+
+		bool is_attached() const noexcept {
+			return bool(this->link);
+		}
+
+		// A node only knows the XOR of its neighbours, so it cannot unlink
+		// itself. Remove it through its list instead.
+		void detach() = delete;
+
+		operator T() const noexcept {
+			return data;
+		}
+	};
+
+	template <typename Type>
+	class base_iterator
+	{
+		template <typename OtherType>
+		friend class base_iterator;
+
+		friend class XorNodeList;
+
+	protected:
+		Node* prev_node;
+		Node* current_node;
+
+	public:
+		using iterator_category = std::bidirectional_iterator_tag;
+		using difference_type = std::ptrdiff_t;
+		using value_type = Type;
+		using pointer = Type*;
+		using reference = Type&;
+
+		base_iterator() noexcept : prev_node{ nullptr }, current_node{ nullptr } {};
+		base_iterator(Node* prev_node, Node* current_node) noexcept :
+			prev_node{ prev_node },
+			current_node{ current_node }
+		{};
+
+		bool is_at_nullptr() const noexcept {
+			return !this->current_node;
+		}
+
+		bool is_past_the_end_no_null_check() const noexcept {
+			return bool(this->prev_node) && !this->current_node->other(this->prev_node);
+		}
+
+		bool is_past_the_end() const {
+			if (this->is_at_nullptr()) {
+				throw std::runtime_error("The iterator's current node must not be null.");
+			}
+			return this->is_past_the_end_no_null_check();
+		}
+
+		bool is_before_the_start_no_null_check() const noexcept {
+			return !this->prev_node;
+		}
+
+		bool is_before_the_start() const {
+			if (this->is_at_nullptr()) {
+				throw std::runtime_error("The iterator's current node must not be null.");
+			}
+			return this->is_before_the_start_no_null_check();
+		}
+
+		bool is_at_datanode_no_null_check() const noexcept {
+			return !this->is_before_the_start_no_null_check() && !this->is_past_the_end_no_null_check();
+		}
+
+		bool is_at_datanode() const {
+			if (this->is_at_nullptr()) {
+				throw std::runtime_error("The iterator's current node must not be null.");
+			}
+			return this->is_at_datanode_no_null_check();
+		}
+
+		base_iterator& operator++() {
+			if (this->is_at_nullptr()) {
+				throw std::runtime_error("The iterator's current node must not be null.");
+			}
+			if (this->is_past_the_end_no_null_check()) {
+				throw std::runtime_error("Cannot increment iterator that is past-the-end.");
+			}
+
+			Node* next_node = this->current_node->other(this->prev_node);
+			this->prev_node = this->current_node;
+			this->current_node = next_node;
+
+			return *this;
+		}
+
+		base_iterator& operator--() {
+			if (this->is_at_nullptr()) {
+				throw std::runtime_error("The iterator's current node must not be null.");
+			}
+			if (this->is_before_the_start_no_null_check()) {
+				throw std::runtime_error("Cannot decrement iterator that is before-the-start.");
+			}
+
+			Node* prev_prev_node = this->prev_node->other(this->current_node);
+			this->current_node = this->prev_node;
+			this->prev_node = prev_prev_node;
+
+			return *this;
+		}
+
+		base_iterator operator++(int) {
+			base_iterator it(*this);
+			++(*this);
+			return it;
+		}
+
+		base_iterator operator--(int) {
+			base_iterator it(*this);
+			--(*this);
+			return it;
+		}
+
+		reference operator*() const {
+			if (this->is_at_nullptr()) {
+				throw std::runtime_error("The iterator's current node must not be null.");
+			}
+			if (!this->is_at_datanode_no_null_check()) {
+				throw std::runtime_error("Cannot dereference iterator that is not at data node");
+			}
+
+			DataNode* current_data_node = reinterpret_cast<DataNode*>(this->current_node);
+
+			return current_data_node->data;
+		};
+
+		pointer operator->() const {
+			return &(**this);
+		};
+
+		template<typename OtherType>
+		bool operator==(const base_iterator<OtherType>& it) const noexcept {
+			// Invalid iterators are never equal.
+			return this->current_node == it.current_node && !this->is_at_nullptr();
+		}
+
+		template<typename OtherType>
+		bool operator!=(const base_iterator<OtherType>& it) const noexcept {
+			return !(*this == it);
+		}
+
+		operator base_iterator<const value_type>() const noexcept
+		{
+			return base_iterator<const value_type>(this->prev_node, this->current_node);
+		}
+	};
+
+	using iterator = base_iterator<value_type>;
+	using const_iterator = base_iterator<const value_type>;
+	using reverse_iterator = std::reverse_iterator<iterator>;
+	using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+	XorNodeList() noexcept {
+		this->before_start_node.link = link_of(nullptr, &(this->past_end_node));
+		this->past_end_node.link = link_of(&(this->before_start_node), nullptr);
+	};
+
+	~XorNodeList() noexcept {
+		this->clear();
+	};
+
+	XorNodeList(const XorNodeList& obj) = delete;
+	XorNodeList(XorNodeList&& obj) = delete;
+	XorNodeList& operator=(const XorNodeList& obj) = delete;
+	XorNodeList& operator=(XorNodeList&& obj) = delete;
+
+	iterator begin() noexcept {
+		return iterator(&(this->before_start_node), this->before_start_node.other(nullptr));
+	};
+	const_iterator begin() const noexcept {
+		return const_cast<XorNodeList*>(this)->begin();
+	};
+	const_iterator cbegin() const noexcept {
+		return this->begin();
+	};
+	iterator end() noexcept {
+		return iterator(this->past_end_node.other(nullptr), &(this->past_end_node));
+	};
+	const_iterator end() const noexcept {
+		return const_cast<XorNodeList*>(this)->end();
+	};
+	const_iterator cend() const noexcept {
+		return this->end();
+	};
+
+	reverse_iterator rbegin() noexcept {
+		return reverse_iterator(this->end());
+	};
+	const_reverse_iterator rbegin() const noexcept {
+		return const_reverse_iterator(this->end());
+	};
+	const_reverse_iterator crbegin() const noexcept {
+		return this->rbegin();
+	};
+	reverse_iterator rend() noexcept {
+		return reverse_iterator(this->begin());
+	};
+	const_reverse_iterator rend() const noexcept {
+		return const_reverse_iterator(this->begin());
+	};
+	const_reverse_iterator crend() const noexcept {
+		return this->rend();
+	};
+
+	bool is_empty() const noexcept {
+		return this->before_start_node.other(nullptr) == &(this->past_end_node);
+	};
+
+	size_type size() const noexcept {
+		size_type size{ 0 };
+		const Node* prev_node{ &(this->before_start_node) };
+		const Node* node{ this->before_start_node.other(nullptr) };
+
+		while (node != &(this->past_end_node)) {
+			const Node* next_node = node->other(prev_node);
+			prev_node = node;
+			node = next_node;
+			size++;
+		}
+
+		return size;
+	};
+
+	// Inserts the node before the iterator's position and returns an
+	// iterator to the inserted node. Iterators at the position, or whose
+	// previous node is the position's previous node, are invalidated.
+	iterator insert(const_iterator pos, DataNode& node) {
+		if (pos.is_at_nullptr()) {
+			throw std::runtime_error("The iterator's current node must not be null.");
+		}
+		if (pos.is_before_the_start_no_null_check()) {
+			throw std::runtime_error("Cannot insert before this iterator if this iterator is before-the-start.");
+		}
+		if (node.is_attached()) {
+			throw std::invalid_argument("The node must not already be attached.");
+		}
+
+		Node* prev_node = pos.prev_node;
+		Node* next_node = pos.current_node;
+		Node* new_node = &node;
+
+		new_node->link = link_of(prev_node, next_node);
+		prev_node->relink(next_node, new_node);
+		next_node->relink(prev_node, new_node);
+
+		return iterator(prev_node, new_node);
+	}
+
+	// Removes the node at the iterator's position and returns an iterator to
+	// the node after it. Iterators at the removed node or its successor are
+	// invalidated.
+	iterator erase(const_iterator pos) {
+		if (pos.is_at_nullptr()) {
+			throw std::runtime_error("The iterator's current node must not be null.");
+		}
+		if (!pos.is_at_datanode_no_null_check()) {
+			throw std::runtime_error("Cannot erase at an iterator that is not at data node.");
+		}
+
+		Node* prev_node = pos.prev_node;
+		Node* old_node = pos.current_node;
+		Node* next_node = old_node->other(prev_node);
+
+		prev_node->relink(old_node, next_node);
+		next_node->relink(old_node, prev_node);
+		old_node->link = 0;
+
+		return iterator(prev_node, next_node);
+	}
+
+	void push_front(DataNode& node) {
+		this->insert(this->begin(), node);
+	};
+
+	void push_back(DataNode& node) {
+		this->insert(this->end(), node);
+	};
+
+	DataNode* pop_front() {
+		if (this->is_empty()) {
+			throw std::runtime_error("The list must not be empty.");
+		}
+
+		iterator it = this->begin();
+		DataNode* node = reinterpret_cast<DataNode*>(it.current_node);
+		this->erase(it);
+		return node;
+	};
+
+	DataNode* pop_back() {
+		if (this->is_empty()) {
+			throw std::runtime_error("The list must not be empty.");
+		}
+
+		iterator it = this->end();
+		--it;
+		DataNode* node = reinterpret_cast<DataNode*>(it.current_node);
+		this->erase(it);
+		return node;
+	};
+
+	void clear() noexcept {
+		Node* prev_node{ &(this->before_start_node) };
+		Node* node{ this->before_start_node.other(nullptr) };
+
+		// Manually detach all nodes in the list.
+		while (node != &(this->past_end_node)) {
+			Node* next_node = node->other(prev_node);
+			prev_node = node;
+			node->link = 0;
+			node = next_node;
+		}
+
+		// Reattach this list's past-the-end and before-the-start nodes.
+		this->before_start_node.link = link_of(nullptr, &(this->past_end_node));
+		this->past_end_node.link = link_of(&(this->before_start_node), nullptr);
+	};
+};
+
+} // namespace goldenrockefeller
+
+#endif